@@ -0,0 +1,118 @@
+/** This file provides a shared-memory parallel Riemannian block-coordinate
+ * descent method for the Explicit and SOSync formulations of the
+ * rank-restricted SE-Sync problem, which can be used in place of the
+ * Riemannian truncated-Newton trust-region method at each level of the
+ * Riemannian Staircase.
+ *
+ * The objective of these formulations is a sparse quadratic form
+ * F(Y) = tr(Y M Y^T) in the states.  The states are partitioned into blocks of
+ * consecutive states, and the blocks are (greedily) colored so that no two
+ * blocks of the same color are joined by a measurement.  Each sweep of the
+ * method visits the colors in turn, and concurrently optimizes the states of
+ * all of the blocks of the current color (holding all other states fixed)
+ * using a few iterations of the Riemannian trust-region method applied to the
+ * corresponding (small) local problem.  Since blocks of the same color are
+ * decoupled, the blocks of each color can be updated in parallel without
+ * synchronization, and no global sparse linear solves are required.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Optimization/Riemannian/TNT.h"
+
+#include "SESync/SESyncProblem.h"
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+/** Applies the Riemannian trust-region method (with the given parameters) to
+ * minimize the quadratic f(X) = tr(X D X^T) + 2 tr(X C^T), starting from X0,
+ * over the states of a block of 'num_states' states.  Here X contains the
+ * translations of these states (if has_translations is true) followed by
+ * their (lifted) rotations, and D is symmetric.  This is the local problem
+ * obtained by holding all of the states outside the block fixed. */
+Optimization::Riemannian::TNTResult<Matrix, Scalar> optimize_quadratic_block(
+    const SparseMatrix &D, const Matrix &C, const Matrix &X0, size_t d,
+    size_t num_states, bool has_translations,
+    const Optimization::Riemannian::TNTParams<Scalar> &params);
+
+class BlockCoordinateDescent {
+private:
+  /** A block of consecutive states */
+  struct Block {
+    /** Index of the first state in this block */
+    size_t first_state;
+
+    /** Number of states in this block */
+    size_t num_states;
+
+    /** The indices of the columns of the iterate Y containing the states of
+     * this block (the translations (if any) followed by the rotations) */
+    std::vector<size_t> columns;
+
+    /** The rows of the data matrix M corresponding to this block's columns */
+    SparseMatrix rows;
+
+    /** The principal submatrix of M corresponding to this block's columns */
+    SparseMatrix diagonal;
+  };
+
+  /** The problem being solved */
+  const SESyncProblem &problem_;
+
+  /** The blocks of states */
+  std::vector<Block> blocks_;
+
+  /** colors_[c] contains the indices of the blocks assigned color c */
+  std::vector<std::vector<size_t>> colors_;
+
+  /** Optimizes the states of the given block (holding all other states of Y
+   * fixed) by applying the Riemannian trust-region method (with the given
+   * parameters) to the local problem, and writes the result back into Y.
+   * Returns the number of trust-region iterations performed. */
+  size_t optimize_block(const Block &block, Matrix &Y,
+                      const Optimization::Riemannian::TNTParams<Scalar>
+                          &params) const;
+
+public:
+  /** Partitions the states of the given problem (which must use the Explicit
+   * or SOSync formulation) into blocks of (at most) 'block_size' consecutive
+   * states, and colors the resulting block graph */
+  BlockCoordinateDescent(const SESyncProblem &problem, size_t block_size);
+
+  /** Returns the number of blocks */
+  size_t num_blocks() const { return blocks_.size(); }
+
+  /** Returns the number of colors used to color the block graph */
+  size_t num_colors() const { return colors_.size(); }
+
+  /** Runs block-coordinate descent starting from Y0, using the stopping
+   * criteria (gradient_tolerance, relative_decrease_tolerance, max_iterations
+   * (the maximum number of sweeps), and max_computation_time) specified in
+   * 'params'.  Each block is optimized using at most 'local_iterations'
+   * trust-region iterations per sweep (with inner iterations controlled by
+   * max_TPCG_iterations, kappa_fgr and theta).  The optional 'user_function'
+   * is called after each sweep, with the update step h = Y_{k+1} - Y_k; if it
+   * returns true, the method terminates with status UserFunction.  If a sweep
+   * increases the objective (which can only happen if the local solves fail),
+   * it is rejected, and the method terminates with status Stepsize.  The
+   * returned result records the per-iteration (i.e. per-sweep) objective
+   * values, times, gradient norms, local trust-region iterations and update
+   * step norms; the statistics that have no analog in block-coordinate descent
+   * (preconditioned gradient norms, M-norms of the update steps and gain
+   * ratios) are left empty, and the trust-region radius and gain ratio passed
+   * to 'user_function' are NaN. */
+  Optimization::Riemannian::TNTResult<Matrix, Scalar>
+  optimize(const Matrix &Y0,
+           const Optimization::Riemannian::TNTParams<Scalar> &params,
+           size_t local_iterations,
+           const std::optional<SESyncTNTUserFunction> &user_function =
+               std::nullopt) const;
+};
+
+} // namespace SESync
@@ -0,0 +1,83 @@
+/** This lightweight class models the geometry of M = St_C(1, p)^n, the n-fold
+ * product of complex Stiefel manifolds St_C(1, p) (i.e. the unit sphere in
+ * C^p).  This is the complex analog of the product of real Stiefel manifolds
+ * St(2, 2p)^n, and is the domain of the rank-restricted relaxation of planar
+ * (d = 2) synchronization problems when elements of SO(2) are identified with
+ * unit-modulus complex numbers.  Elements of this manifold (and its tangent
+ * spaces) are represented as p x n complex matrices, whose columns are
+ * unit-norm vectors in C^p.  We regard C^{p x n} as a real Euclidean space,
+ * equipped with the inner product <A, B> := Re(tr(A^H B)).
+ */
+
+#pragma once
+
+#include <random> // For sampling random points on the manifold
+
+#include <Eigen/Dense>
+
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+class ComplexStiefelProduct {
+
+private:
+  // Dimension of ambient complex space containing the unit vectors
+  size_t p_;
+
+  // Number of copies of St_C(1, p) in the product
+  size_t n_;
+
+public:
+  /// CONSTRUCTORS AND MUTATORS
+
+  // Default constructor -- sets all dimensions to 0
+  ComplexStiefelProduct() {}
+
+  ComplexStiefelProduct(size_t p, size_t n) : p_(p), n_(n) {}
+
+  void set_p(size_t p) { p_ = p; }
+  void set_n(size_t n) { n_ = n; }
+
+  /// ACCESSORS
+  unsigned int get_p() const { return p_; }
+  unsigned int get_n() const { return n_; }
+
+  /// GEOMETRY
+
+  /** Given a generic matrix A in C^{p x n}, this function computes the
+   * projection of A onto M (closest point in the Frobenius norm sense), which
+   * is obtained by normalizing each column of A. */
+  ComplexMatrix project(const ComplexMatrix &A) const;
+
+  /** Helper function -- this computes and returns the product
+   *
+   *  P = A * Diag(Re(B^H * C))
+   *
+   * where A, B, and C are p x n matrices; this is the complex analog of the
+   * function StiefelProduct::SymBlockDiagProduct (with 1 x 1 blocks).
+   */
+  ComplexMatrix SymBlockDiagProduct(const ComplexMatrix &A,
+                                    const ComplexMatrix &B,
+                                    const ComplexMatrix &C) const;
+
+  /** Given an element Y in M and a matrix V in T_X(C^{p x n}), this function
+   * computes and returns the projection of V onto T_X(M), the tangent space of
+   * M at X. */
+  ComplexMatrix Proj(const ComplexMatrix &Y, const ComplexMatrix &V) const {
+    return V - SymBlockDiagProduct(Y, Y, V);
+  }
+
+  /** Given an element Y in M and a tangent vector V in T_Y(M), this function
+   * computes the retraction along V at Y using the projection-based
+   * retraction */
+  ComplexMatrix retract(const ComplexMatrix &Y, const ComplexMatrix &V) const;
+
+  /** Sample a random point on M, using the (optional) passed seed to initialize
+   * the random number generator.  */
+  ComplexMatrix
+  random_sample(const std::default_random_engine::result_type &seed =
+                    std::default_random_engine::default_seed) const;
+};
+
+} // namespace SESync
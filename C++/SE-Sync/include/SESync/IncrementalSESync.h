@@ -0,0 +1,84 @@
+/** This file provides an incremental (online) interface to the SE-Sync
+ * algorithm, for use in applications (such as live mapping) in which
+ * measurements are appended to a pose graph continuously.  Rather than
+ * constructing a new problem and solving it from scratch after each update,
+ * this interface appends the new measurements to an existing SESyncProblem
+ * (updating its cached factorizations in place where possible), and
+ * warm-starts the Riemannian Staircase from the previous solution at its
+ * existing rank.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESync.h"
+#include "SESync/SESyncProblem.h"
+
+namespace SESync {
+
+class IncrementalSESync {
+private:
+  /** The options used for each solve */
+  SESyncOpts options_;
+
+  /** The problem instance (constructed upon the first update) */
+  std::unique_ptr<SESyncProblem> problem_;
+
+  /** The result of the most recent solve */
+  SESyncResult result_;
+
+  /** Elapsed time needed to incorporate the measurements of the most recent
+   * update into the problem */
+  double problem_update_time_ = 0;
+
+  /** Elapsed time needed to solve the problem after the most recent update */
+  double solve_time_ = 0;
+
+  /** Whether the cached factorizations were updated in place during the most
+   * recent update */
+  bool factorizations_updated_ = false;
+
+public:
+  /** Constructs an empty incremental solver that will use the given options */
+  explicit IncrementalSESync(const SESyncOpts &options = SESyncOpts())
+      : options_(options) {}
+
+  /** Appends the given measurements to the pose graph, and re-solves it.  The
+   * first call constructs the problem and solves it using the initialization
+   * method specified in the options; each subsequent call extends the previous
+   * solution to any new states (cf. SESyncProblem::extend_iterate) and uses it
+   * to warm-start the Riemannian Staircase at its existing rank.  Returns the
+   * result of the solve. */
+  const SESyncResult &update(const measurements_t &measurements);
+
+  /** Returns true if a problem has been constructed */
+  bool initialized() const { return problem_ != nullptr; }
+
+  /** Returns the current problem instance (which must have been constructed)
+   */
+  const SESyncProblem &problem() const { return *problem_; }
+
+  /** Returns the result of the most recent solve */
+  const SESyncResult &result() const { return result_; }
+
+  /** Returns the elapsed time needed to incorporate the measurements of the
+   * most recent update into the problem */
+  double problem_update_time() const { return problem_update_time_; }
+
+  /** Returns the elapsed time needed to solve the problem after the most
+   * recent update */
+  double solve_time() const { return solve_time_; }
+
+  /** Returns the total latency of the most recent update */
+  double update_time() const { return problem_update_time_ + solve_time_; }
+
+  /** Returns true if the cached factorizations were updated in place (rather
+   * than recomputed) during the most recent update */
+  bool factorizations_updated() const { return factorizations_updated_; }
+};
+
+} // namespace SESync
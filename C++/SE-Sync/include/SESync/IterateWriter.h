@@ -0,0 +1,107 @@
+/** This lightweight class streams the iterates generated by the Riemannian
+ * Staircase to a binary file using a background writer thread, so that the
+ * sequence of iterates of a large problem can be recorded without holding it
+ * in memory (cf. SESyncOpts::iterate_log_file).
+ *
+ * The file consists of a header followed by a sequence of records.  All
+ * integers are unsigned 64-bit and all values are stored in the native byte
+ * order of the machine that wrote the file:
+ *
+ * Header:  the 8 characters "SESYNCIT", followed by the size in bytes (4 or 8)
+ *          of the floating-point type used to store the iterates
+ *
+ * Record:  the level r of the Riemannian Staircase, the index of the
+ *          trust-region iteration at that level, the number of rows and
+ *          columns of the iterate Y, the elapsed optimization time at that
+ *          level and the objective value F(Y) (both as doubles), and finally
+ *          the elements of Y in column-major order
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+class IterateWriter {
+private:
+  /** A single iterate awaiting output */
+  struct Record {
+    size_t level;
+    size_t iteration;
+    double time;
+    Scalar objective_value;
+    Matrix Y;
+  };
+
+  /** The name of the output file */
+  std::string filename_;
+
+  /** The output file */
+  std::ofstream file_;
+
+  /** Whether to store iterates in single precision */
+  bool single_precision_;
+
+  /** The maximum number of iterates that may be awaiting output; once this
+   * limit is reached, write() blocks until the writer thread has caught up */
+  size_t max_queue_size_;
+
+  /** The queue of iterates awaiting output */
+  std::deque<Record> queue_;
+
+  /// Synchronization between the solver and the writer thread
+
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  bool closing_ = false;
+
+  /** Whether writing to the file has failed (e.g. because the disk is full);
+   * once this is set, the writer thread discards any remaining iterates */
+  bool failed_ = false;
+
+  /** The writer thread */
+  std::thread writer_;
+
+  /** The main loop of the writer thread */
+  void run();
+
+  /** Signals the writer thread to finish, and waits for it to exit */
+  void stop();
+
+public:
+  /** Opens the file 'filename' for writing, and starts the writer thread */
+  IterateWriter(const std::string &filename, bool single_precision = false,
+                size_t max_queue_size = 4);
+
+  /** Flushes any pending iterates and closes the file, without reporting
+   * failures (cf. close()) */
+  ~IterateWriter();
+
+  IterateWriter(const IterateWriter &) = delete;
+  IterateWriter &operator=(const IterateWriter &) = delete;
+
+  /** Enqueues the iterate Y (obtained at iteration 'iteration' of level
+   * 'level' of the Staircase, after 'time' seconds of optimization at that
+   * level) for output.  This function throws a std::runtime_error if writing
+   * a previous iterate failed. */
+  void write(size_t level, size_t iteration, double time,
+             Scalar objective_value, const Matrix &Y);
+
+  /** Flushes any pending iterates, stops the writer thread, and throws a
+   * std::runtime_error if writing any iterate (or flushing the file) failed.
+   * No further iterates may be written after calling this function. */
+  void close();
+};
+
+} // namespace SESync
@@ -0,0 +1,134 @@
+/** This file provides lightweight instrumentation of the computational kernels
+ * that dominate the cost of SE-Sync: for each kernel, it records the number of
+ * calls, the (exclusive) elapsed time, and estimates of the number of
+ * floating-point operations performed and of the number of bytes moved to and
+ * from memory, from which the achieved GFLOP/s and GB/s can be computed.
+ *
+ * The instrumentation is compiled in only if SESYNC_KERNEL_COUNTERS is
+ * defined (cf. the ENABLE_KERNEL_COUNTERS CMake option); otherwise the
+ * SESYNC_KERNEL_SCOPE macro expands to nothing (so that its arguments are not
+ * even evaluated), and kernel_profile() always returns an empty profile.
+ *
+ * Counters are maintained per thread, so that concurrent SE-Sync runs on
+ * different threads are profiled independently.  A kernel that invokes another
+ * instrumented kernel is charged only for its own work: the nested kernel's
+ * elapsed time is excluded from the caller's, and the caller's flop and byte
+ * estimates exclude the nested kernel's.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+
+namespace SESync {
+
+/** The instrumented kernels */
+enum class Kernel {
+  /** Product with the data matrix Q of the Simplified formulation (excluding
+   * the orthogonal projection Pi) */
+  QProduct,
+
+  /** Product with the orthogonal projection matrix Pi */
+  PiProduct,
+
+  /** Sparse Cholesky solve with the regularized Cholesky preconditioner */
+  PreconditionerSolve,
+
+  /** StiefelProduct::SymBlockDiagProduct */
+  SymBlockDiagProduct,
+
+  /** StiefelProduct::project */
+  Project,
+
+  /** Product with the certificate matrix within LOBPCG */
+  LOBPCGOperator
+};
+
+/** The number of instrumented kernels */
+constexpr size_t NumKernels = 6;
+
+/** Returns a human-readable name for the given kernel */
+const char *kernel_name(Kernel kernel);
+
+/** Returns true if kernel instrumentation was compiled in */
+constexpr bool kernel_counters_enabled() {
+#if defined(SESYNC_KERNEL_COUNTERS)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/** Statistics recorded for a single kernel */
+struct KernelStats {
+  /** Number of calls */
+  size_t calls = 0;
+
+  /** Estimated number of floating-point operations */
+  double flops = 0;
+
+  /** Estimated number of bytes read from and written to memory */
+  double bytes = 0;
+
+  /** Elapsed time (in seconds) */
+  double time = 0;
+
+  /** Achieved floating-point throughput (GFLOP/s) */
+  double GFLOPS() const { return time > 0 ? 1e-9 * flops / time : 0; }
+
+  /** Achieved memory bandwidth (GB/s) */
+  double GBS() const { return time > 0 ? 1e-9 * bytes / time : 0; }
+
+  /** Arithmetic intensity (flops per byte) */
+  double intensity() const { return bytes > 0 ? flops / bytes : 0; }
+};
+
+/** A profile of all of the instrumented kernels, indexed by Kernel */
+typedef std::array<KernelStats, NumKernels> KernelProfile;
+
+/** Returns the cumulative kernel profile of the calling thread */
+KernelProfile kernel_profile();
+
+/** Returns the kernel statistics accrued between the profiles 'start' and
+ * 'end' */
+KernelProfile kernel_profile_between(const KernelProfile &start,
+                                     const KernelProfile &end);
+
+#if defined(SESYNC_KERNEL_COUNTERS)
+
+/** RAII helper that charges the elapsed time of its lifetime (less that of any
+ * nested scopes) to a kernel */
+class KernelScope {
+private:
+  Kernel kernel_;
+  std::chrono::time_point<std::chrono::high_resolution_clock> start_;
+  double nested_time_ = 0;
+  KernelScope *parent_;
+
+public:
+  KernelScope(Kernel kernel, double flops, double bytes);
+  ~KernelScope();
+
+  KernelScope(const KernelScope &) = delete;
+  KernelScope &operator=(const KernelScope &) = delete;
+};
+
+#define SESYNC_KERNEL_SCOPE_CONCAT_(a, b) a##b
+#define SESYNC_KERNEL_SCOPE_NAME_(line)                                        \
+  SESYNC_KERNEL_SCOPE_CONCAT_(sesync_kernel_scope_, line)
+
+/** Charges the remainder of the enclosing block to 'kernel', with the given
+ * estimated flop and byte counts */
+#define SESYNC_KERNEL_SCOPE(kernel, flops, bytes)                              \
+  SESync::KernelScope SESYNC_KERNEL_SCOPE_NAME_(__LINE__)(kernel, flops, bytes)
+
+#else
+
+#define SESYNC_KERNEL_SCOPE(kernel, flops, bytes)
+
+#endif
+
+} // namespace SESync
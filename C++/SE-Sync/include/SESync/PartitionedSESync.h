@@ -0,0 +1,122 @@
+/** This file provides a partitioned, multi-process implementation of SE-Sync
+ * for problems whose data is too large to process comfortably within a single
+ * process.
+ *
+ * The pose graph is split into contiguous ranges of states, each of which is
+ * owned by a separate worker process.  Each worker holds only the
+ * measurements incident to its own states (and hence only its own rows of the
+ * data matrix), together with its slice of the iterate and copies of the
+ * states of its neighbors that it depends upon (its "boundary" states).  The
+ * coordinating process runs a distributed Riemannian block-coordinate descent
+ * method: the partitions are colored so that no two partitions of the same
+ * color share a measurement, and in each round the workers of one color
+ * concurrently optimize their own states (with their boundary states held
+ * fixed), after which the updated states are forwarded to the workers that
+ * depend upon them.  Solutions are certified by assembling the certificate
+ * matrix from the rows computed by the workers and applying
+ * fast_verification; if certification fails, the coordinator escapes the
+ * saddle point and ascends the Riemannian Staircase, as usual.
+ *
+ * Workers communicate with the coordinator over stream sockets using a simple
+ * length-prefixed binary protocol.  By default, the coordinator launches the
+ * workers itself (a stand-in for a real launcher), connecting each of them
+ * using a Unix domain socket pair: each worker is forked from the calling
+ * process and then either executes a worker executable, or (only if the
+ * calling process is single-threaded, since it is unsafe to run multithreaded
+ * code in the child of a multithreaded process) runs the worker directly.
+ * Alternatively, the coordinator can be given sockets connected to externally
+ * launched workers, each of which must be running run_partitioned_worker.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESync.h"
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+/** This struct contains the parameters that control the partitioning of a
+ * problem among worker processes */
+struct PartitionedSESyncOpts {
+  /** The number of worker processes (and hence of partitions) */
+  size_t num_workers = 4;
+
+  /** Maximum number of trust-region iterations that each worker applies to
+   * its subproblem in each round */
+  size_t local_iterations = 5;
+
+  /** Sockets connected to externally launched workers (each running
+   * run_partitioned_worker).  If this is empty, num_workers workers are
+   * launched locally by forking the calling process. */
+  std::vector<int> worker_sockets;
+
+  /** The executable used to launch local workers.  Each worker is started by
+   * forking the calling process and executing this file with the arguments
+   * "--partitioned-worker <socket>", which it must pass to
+   * run_partitioned_worker(argc, argv) (e.g. the calling program itself, via
+   * "/proc/self/exe").  If this is empty, the forked child runs the worker
+   * directly, which is only permitted if the calling process has no other
+   * threads (in particular, no OpenMP thread pool). */
+  std::string worker_executable = "";
+};
+
+/** This struct contains the output of a partitioned SE-Sync run */
+struct PartitionedSESyncResult {
+  /** The result of the SE-Sync run.  Since the workers are separate
+   * processes, the telemetry and operation counts are not populated, and
+   * Lambda is not assembled (although trLambda, duality_gap and
+   * suboptimality_bound are computed). */
+  SESyncResult result;
+
+  /** The number of states owned by each worker */
+  std::vector<size_t> partition_sizes;
+
+  /** The number of boundary states (owned by other workers) upon which each
+   * worker depends */
+  std::vector<size_t> boundary_sizes;
+
+  /** The number of colors used to schedule the workers */
+  size_t num_colors = 0;
+
+  /** The total number of sweeps (over all of the colors) performed */
+  size_t num_sweeps = 0;
+
+  /** The total number of bytes sent to and received from the workers by the
+   * coordinator */
+  size_t bytes_sent = 0;
+  size_t bytes_received = 0;
+};
+
+/** Solves the special Euclidean synchronization problem defined by the given
+ * measurements using a partitioned pool of worker processes.  Only the
+ * Explicit and SOSync formulations are supported.  The options controlling the
+ * Riemannian Staircase, the stopping criteria (where max_iterations bounds the
+ * number of sweeps at each level), and the verification and escape steps are
+ * respected; since the coordinator never forms the complete data matrix, the
+ * iterate is initialized by propagating the measurements along a spanning
+ * tree of the pose graph (options.initialization is ignored), and the
+ * preconditioner, monitor, user function and iterate logging options are
+ * ignored. */
+PartitionedSESyncResult PartitionedSESync(
+    const measurements_t &measurements,
+    const SESyncOpts &options = SESyncOpts(),
+    const PartitionedSESyncOpts &partition_options = PartitionedSESyncOpts());
+
+/** Serves requests from a coordinator connected by the given socket until the
+ * coordinator shuts the worker down (or closes the connection).  This is the
+ * entry point for externally launched workers. */
+void run_partitioned_worker(int socket);
+
+/** If the given command-line arguments are "--partitioned-worker <socket>" (as
+ * passed to PartitionedSESyncOpts::worker_executable), serves requests from
+ * the coordinator connected by the given socket until it shuts the worker
+ * down, and returns true; otherwise, returns false immediately */
+bool run_partitioned_worker(int argc, char **argv);
+
+} // namespace SESync
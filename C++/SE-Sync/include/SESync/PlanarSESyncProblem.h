@@ -0,0 +1,297 @@
+/** This class encapsulates an instance of the rank-restricted Riemannian form
+ * of the semidefinite relaxation solved by SE-Sync, specialized to planar
+ * (d = 2) problems.  Here we identify each rotation [c -s; s c] in SO(2) with
+ * the unit-modulus complex number c + is (and each translation [x; y] with the
+ * complex number x + iy), so that the data matrices LGrho, M, etc. become
+ * complex Hermitian matrices whose elements are scalars rather than 2 x 2
+ * blocks, and the domain of the rank-restricted relaxation becomes the product
+ * of complex Stiefel manifolds St_C(1, r)^n (i.e., a product of unit spheres
+ * in C^r).  This halves the storage required for the data matrices and the
+ * iterates, and replaces the generic d x d block operations with scalar ones.
+ *
+ * Iterates Y are represented as r x n complex matrices, whose ith column is
+ * the (generalized) orientation of the ith pose, and the objective is
+ * F(Y) := tr(Y S Y^H), where S is the (complex) data matrix determined by the
+ * selected formulation.  We regard C^{r x n} as a real Euclidean space with
+ * the inner product <A, B> := Re(tr(A^H B)); with this choice, and the
+ * scaling of the data matrices described in SESync_utils.h, the objective
+ * values (and Lagrange multipliers) computed here coincide with those of the
+ * real formulation.
+ *
+ * Only the Simplified and SOSync formulations are supported, and the
+ * orthogonal projection Pi is always computed using a Cholesky factorization.
+ */
+
+#pragma once
+
+#include <Eigen/CholmodSupport>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include "SESync/ComplexStiefelProduct.h"
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESyncProblem.h"
+#include "SESync/SESync_types.h"
+#include "SESync/SESync_utils.h"
+
+namespace SESync {
+
+/** The type of the sparse Cholesky factorization used to construct the
+ * regularized Cholesky preconditioner for planar problems.  (Note that
+ * CHOLMOD's complex-valued factorizations require column-major storage.) */
+typedef Eigen::CholmodDecomposition<Eigen::SparseMatrix<ComplexScalar>>
+    ComplexSparseCholeskyFactorization;
+
+class PlanarSESyncProblem {
+private:
+  /// PROBLEM DATA
+
+  /** The specific formulation of the SE-Sync problem to be solved (simplified
+   * or rotation-only) */
+  Formulation form_;
+
+  /** Number of states */
+  size_t n_ = 0;
+
+  /** Number of measurements */
+  size_t m_ = 0;
+
+  /** (Complex) relaxation rank */
+  size_t r_ = 1;
+
+  /** The set of relative pose measurements from which this problem was
+   * constructed */
+  measurements_t measurements_;
+
+  /** The oriented incidence matrix A encoding the underlying measurement
+   * graph for this problem */
+  SparseMatrix A_;
+
+  /** The complex matrix M parameterizing the quadratic form appearing in the
+   * Explicit form of the planar problem; this is used to construct the
+   * certificate matrix (and preconditioner) in Simplified mode */
+  ComplexSparseMatrix M_;
+
+  /** The complex rotational connection Laplacian */
+  ComplexSparseMatrix LGrho_;
+
+  /** The weighted reduced oriented incidence matrix Ared Omega^(1/2).  Only
+   * used in Simplified mode. */
+  SparseMatrix Ared_SqrtOmega_;
+
+  /** The transpose of the above matrix; we cache this for computational
+   * efficiency, since it's used frequently.  Only used in Simplified mode. */
+  SparseMatrix SqrtOmega_AredT_;
+
+  /** The weighted complex translational data matrix Omega^(1/2) conj(T).  Only
+   * used in Simplified mode. */
+  ComplexSparseMatrix SqrtOmega_T_;
+
+  /** The adjoint of the above matrix; we cache this for computational
+   * efficiency, since it's used frequently.  Only used in Simplified mode. */
+  ComplexSparseMatrix TT_SqrtOmega_;
+
+  /** An Eigen sparse linear solver that encodes the Cholesky factor L used
+   * in the computation of the orthogonal projection function.  Since
+   * Ared * Omega * Ared^T is real, we factor it in real arithmetic, and apply
+   * it to the real and imaginary parts of its argument separately. */
+  SparseCholeskyFactorization L_;
+
+  /** The preconditioning strategy to use when running the Riemannian
+   * trust-region algorithm */
+  Preconditioner preconditioner_;
+
+  /** Diagonal Jacobi preconditioner */
+  Vector Jacobi_precon_;
+
+  /** Tikhonov-regularized Cholesky Preconditioner */
+  ComplexSparseCholeskyFactorization reg_Chol_precon_;
+
+  /** Upper-bound on the admissible condition number of the regularized
+   * approximate Hessian matrix used for Cholesky preconditioner */
+  Scalar reg_Chol_precon_max_cond_;
+
+  /** The underlying manifold in which the generalized orientations lie in the
+   * rank-restricted Riemannian optimization problem */
+  ComplexStiefelProduct CSP_;
+
+  /** Private helper function: given a real matrix X whose columns are
+   * partitioned as [Re(Z) | Im(Z)], computes the orthogonal projection
+   * Pi * X */
+  Matrix Pi_product(const Matrix &X) const {
+    return X - SqrtOmega_AredT_ * L_.solve(Ared_SqrtOmega_ * X);
+  }
+
+public:
+  /// CONSTRUCTORS AND MUTATORS
+
+  /** Default constructor; doesn't actually do anything */
+  PlanarSESyncProblem() {}
+
+  /** Basic constructor.  Here
+   *
+   * - measurements is a vector of planar relative pose measurements defining
+   *      the pose-graph SLAM problem to be solved.
+   * - formulation is an enum type specifying whether to solve the simplified
+   *      form of the SDP relaxation or the rotation-only (SOSync) form.
+   * - preconditioner is an enum type specifying the preconditioning strategy
+   *      to employ
+   */
+  PlanarSESyncProblem(const measurements_t &measurements,
+                      const Formulation &formulation = Formulation::Simplified,
+                      const Preconditioner &preconditioner =
+                          Preconditioner::RegularizedCholesky,
+                      Scalar reg_chol_precon_max_cond = 1e6);
+
+  /** Set the maximum (complex) rank of the rank-restricted semidefinite
+   * relaxation */
+  void set_relaxation_rank(size_t rank);
+
+  /// ACCESSORS
+
+  /** Returns the specific formulation of this problem */
+  Formulation formulation() const { return form_; }
+
+  /** Returns the preconditioning strategy */
+  Preconditioner preconditioner() const { return preconditioner_; }
+
+  /** Returns the maximum admissible condition number for the regularized
+   * Cholesky preconditioner */
+  Scalar regularized_Cholesky_preconditioner_max_condition() const {
+    return reg_Chol_precon_max_cond_;
+  }
+
+  /** Returns the number of states (poses or rotations) appearing in this
+   * problem */
+  size_t num_states() const { return n_; }
+
+  /** Returns the number of measurements in this problem */
+  size_t num_measurements() const { return m_; }
+
+  /** Returns the dimensional parameter d = 2 for the special Euclidean group
+   * SE(2) over which this problem is defined */
+  size_t dimension() const { return 2; }
+
+  /** Returns the current (complex) relaxation rank r of this problem */
+  size_t relaxation_rank() const { return r_; }
+
+  /** Returns the oriented incidence matrix A of the underlying measurement
+   * graph over which this problem is defined */
+  const SparseMatrix &oriented_incidence_matrix() const { return A_; }
+
+  /** Returns the set of relative pose measurements defining this problem */
+  const measurements_t &measurements() const { return measurements_; }
+
+  /// OPTIMIZATION AND GEOMETRY
+
+  /** Given an n x k complex matrix X, this function computes and returns the
+   * product S * X, where S is the (complex) data matrix defining the objective
+   * F(Y) := tr(Y S Y^H).  This is the complex analog of
+   * SESyncProblem::data_matrix_product. */
+  ComplexMatrix data_matrix_product(const ComplexMatrix &X) const;
+
+  /** Given a matrix Y, this function computes and returns F(Y), the value of
+   * the objective evaluated at Y */
+  Scalar evaluate_objective(const ComplexMatrix &Y) const;
+
+  /** Given a matrix Y, this function computes and returns nabla F(Y), the
+   * *Euclidean* gradient of F at Y. */
+  ComplexMatrix Euclidean_gradient(const ComplexMatrix &Y) const;
+
+  /** Given a matrix Y in the domain D of the relaxation and the *Euclidean*
+   * gradient nabla F(Y) at Y, this function computes and returns the
+   * *Riemannian* gradient grad F(Y) of F at Y */
+  ComplexMatrix Riemannian_gradient(const ComplexMatrix &Y,
+                                    const ComplexMatrix &nablaF_Y) const {
+    return CSP_.Proj(Y, nablaF_Y);
+  }
+
+  /** Given a matrix Y in the domain D of the relaxation, this function computes
+   * and returns grad F(Y), the *Riemannian* gradient of F at Y */
+  ComplexMatrix Riemannian_gradient(const ComplexMatrix &Y) const {
+    return CSP_.Proj(Y, Euclidean_gradient(Y));
+  }
+
+  /** Given a matrix Y in the domain D of the relaxation, the *Euclidean*
+   * gradient nablaF_Y of F at Y, and a tangent vector dotY in T_Y(D), this
+   * function computes and returns Hess F(Y)[dotY], the action of the
+   * Riemannian Hessian on dotY */
+  ComplexMatrix
+  Riemannian_Hessian_vector_product(const ComplexMatrix &Y,
+                                    const ComplexMatrix &nablaF_Y,
+                                    const ComplexMatrix &dotY) const;
+
+  /** Given a matrix Y in the domain D of the relaxation and a tangent vector
+   * dotY in T_Y(D), this function applies the selected preconditioning strategy
+   * to dotY */
+  ComplexMatrix precondition(const ComplexMatrix &Y,
+                             const ComplexMatrix &dotY) const;
+
+  /** Given a matrix Y in the domain D of the relaxation and a tangent vector
+   * dotY in T_D(Y), this function returns the point Yplus in D obtained by
+   * retracting along dotY */
+  ComplexMatrix retract(const ComplexMatrix &Y,
+                        const ComplexMatrix &dotY) const {
+    return CSP_.retract(Y, dotY);
+  }
+
+  /** Given a point Y in the domain D of the rank-r relaxation, this function
+   * computes and returns a 1 x n complex row vector of unit-modulus rotational
+   * state estimates obtained by rounding the point Y */
+  ComplexMatrix round_rotations(const ComplexMatrix &Y) const;
+
+  /** Given a point Y in the domain D of the rank-r relaxation, this function
+   * computes and returns a real 2 x 3n matrix X = [t | R] composed of
+   * translations and rotations for a set of feasible poses for the original
+   * estimation problem obtained by rounding the point Y (or the 2 x 2n matrix
+   * of rotations R, if this is a rotation-only problem) */
+  Matrix round_solution(const ComplexMatrix &Y) const;
+
+  /** Given a 1 x n complex row vector R of unit-modulus rotational state
+   * estimates, this function computes and returns the corresponding optimal
+   * translations t(R), as a 1 x n complex row vector whose first element is
+   * 0 */
+  ComplexMatrix recover_translations(const ComplexMatrix &R) const;
+
+  /** Given a critical point Y of the rank-r relaxation, this function computes
+   * and returns the n-vector of Lagrange multipliers lambda_i associated with
+   * the unit-norm constraints on the columns of Y.  These are related to the
+   * diagonal blocks of the Lagrange multiplier matrix of the real formulation
+   * via Lambda_i = (lambda_i / 2) * I_2. */
+  Vector compute_Lambda_diagonal(const ComplexMatrix &Y) const;
+
+  /** Given the n-vector of Lagrange multipliers lambda, this function
+   * constructs and returns the (real) 2n x 2n block-diagonal Lagrange
+   * multiplier matrix Lambda of the corresponding real formulation */
+  SparseMatrix compute_Lambda_from_Lambda_diagonal(const Vector &lambda) const;
+
+  /** Given a critical point Y of the rank-r relaxation, this function
+   * constructs the (Hermitian) certificate matrix S(Y) := M - Lambda(Y), and
+   * returns a boolean value indicating whether S(Y) is positive-semidefinite.
+   * In the event that S is *not* positive-semidefinite, it also computes a
+   * direction of negative curvature x of S, and its corresponding Rayleigh
+   * quotient theta := x^H * S * x < 0.  The arguments are as for
+   * SESyncProblem::verify_solution; the test is carried out on the real
+   * symmetric embedding of S (cf. real_symmetric_embedding).
+   */
+  bool verify_solution(const ComplexMatrix &Y, Scalar eta, size_t nx,
+                       Scalar &theta, ComplexVector &x, size_t &num_iters,
+                       size_t max_LOBPCG_iters = 1000,
+                       Scalar max_fill_factor = 3, Scalar drop_tol = 1e-3,
+                       const std::function<bool()> &interrupt = {}) const;
+
+  /** Computes and returns the chordal initialization for the rank-restricted
+   * semidefinite relaxation */
+  ComplexMatrix chordal_initialization() const;
+
+  /** Given a 1 x n complex row vector R of unit-modulus rotational state
+   * estimates, this function constructs and returns the corresponding point
+   * in the domain of the rank-restricted semidefinite relaxation at the
+   * current relaxation rank r */
+  ComplexMatrix lift_rotations(const ComplexMatrix &R) const;
+
+  /** Randomly samples a point in the domain for the rank-restricted
+   * semidefinite relaxation */
+  ComplexMatrix random_sample() const { return CSP_.random_sample(); }
+}; // class PlanarSESyncProblem
+} // namespace SESync
@@ -0,0 +1,109 @@
+/** This file provides a robust (outlier-rejecting) interface to the SE-Sync
+ * algorithm based upon graduated non-convexity (GNC) with the truncated
+ * least-squares (TLS) cost, following Yang et al., "Graduated Non-Convexity for
+ * Robust Spatial Perception: From Non-Minimal Solvers to Global Outlier
+ * Rejection" (2020).
+ *
+ * Each round of GNC solves a weighted instance of the pose-graph problem, and
+ * then updates the per-measurement weights from the residuals of the resulting
+ * estimate while gradually sharpening the surrogate cost towards the TLS cost.
+ * Rather than constructing and solving a new problem from scratch in each
+ * round, the weights are applied in place to a single SESyncProblem (whose
+ * cached factorizations are then recomputed numerically using their existing
+ * symbolic analyses, cf. SESyncProblem::set_measurement_precisions), each round
+ * is warm-started from the previous solution at its existing rank, and only
+ * the final round is certified (cf. SESyncOpts::verify).
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESync.h"
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+/** This struct contains the parameters that control a robust solve */
+struct RobustSESyncOpts {
+  /** The maximum (weighted, squared) residual of a measurement that is
+   * considered an inlier (cf. measurement_residuals); this is the threshold
+   * c^2 of the TLS cost min(r^2, c^2) */
+  Scalar inlier_threshold = 10;
+
+  /** The factor by which the GNC control parameter mu is increased after each
+   * round */
+  Scalar gnc_factor = 1.4;
+
+  /** The maximum number of rounds (including the final, certified round) */
+  size_t max_rounds = 100;
+
+  /** GNC terminates once every weight lies within this distance of 0 or 1 */
+  Scalar weight_tol = 1e-4;
+
+  /** The weights applied to the measurements are bounded below by this
+   * (positive) value.  This preserves the sparsity patterns of the data
+   * matrices (and thereby their symbolic factorizations), as well as the
+   * connectivity of the pose graph when an outlier is a bridge. */
+  Scalar min_weight = 1e-6;
+
+  /** If this value is false, each round instead constructs a new problem from
+   * the reweighted measurements and solves it from scratch (including
+   * certification), as a naive outer loop around SESync(measurements) would;
+   * this is provided for benchmarking */
+  bool reuse_problem = true;
+
+  /** Whether to print the outcome of each round to stdout */
+  bool verbose = false;
+};
+
+/** The output of a robust solve */
+struct RobustSESyncResult {
+  /** The result of the final round, which solves the problem with the
+   * measurements reweighted by 'weights' (so that its objective values and
+   * suboptimality bound refer to this reweighted problem) */
+  SESyncResult result;
+
+  /** The final weight of each measurement */
+  Vector weights;
+
+  /** The indices of the measurements classified as outliers (those with final
+   * weight below 1/2), in increasing order */
+  std::vector<size_t> outliers;
+
+  /** The number of rounds performed */
+  size_t num_rounds = 0;
+
+  /** The elapsed computation time of each round's solve */
+  std::vector<double> round_times;
+
+  /** Total elapsed computation time spent applying the updated weights to the
+   * problem (i.e., reassembling the data matrices and recomputing their
+   * factorizations, or constructing new problems if reuse_problem is false) */
+  double reweighting_time = 0;
+
+  /** Total elapsed computation time */
+  double total_computation_time = 0;
+};
+
+/** Given the (weighted, squared) residuals of the measurements, the inlier
+ * threshold c^2 and the GNC control parameter mu, this function returns the
+ * corresponding GNC-TLS weights:  1 for residuals below mu / (mu + 1) * c^2, 0
+ * for residuals above (mu + 1) / mu * c^2, and sqrt(c^2 mu (mu + 1) / r^2) - mu
+ * in between */
+Vector gnc_tls_weights(const Vector &residuals, Scalar inlier_threshold,
+                       Scalar mu);
+
+/** Robustly solves the synchronization problem defined by 'measurements' using
+ * GNC-TLS, with each round of GNC solved by SE-Sync using the given options.
+ * The total computation time of the robust solve is bounded by
+ * options.max_computation_time. */
+RobustSESyncResult
+RobustSESync(const measurements_t &measurements,
+             const SESyncOpts &options = SESyncOpts(),
+             const RobustSESyncOpts &robust_options = RobustSESyncOpts());
+
+} // namespace SESync
@@ -6,12 +6,19 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <Eigen/Dense>
 
+#include "SESync/PlanarSESyncProblem.h"
 #include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESyncMonitor.h"
 #include "SESync/SESyncProblem.h"
+#include "SESync/SESyncTelemetry.h"
 #include "SESync/SESync_types.h"
 
 namespace SESync {
@@ -46,6 +53,23 @@ struct SESyncOpts {
   /** Maximum elapsed computation time (in seconds) */
   double max_computation_time = 1800;
 
+  /** If this value is true, max_computation_time is treated as a hard deadline
+   * for the entire SE-Sync call (rather than for the Riemannian Staircase
+   * alone).  In this mode the algorithm estimates the cost of post-processing
+   * up front (by rounding the initial iterate) and reserves time for it, rounds
+   * the estimate obtained at each level of the Staircase as it goes, and
+   * returns the rounded candidate with the lowest objective value.  If the
+   * Lagrange multipliers Lambda cannot be computed before the deadline,
+   * trLambda, duality_gap and suboptimality_bound are returned as NaN.  Note
+   * that the deadline cannot interrupt the construction of the problem or of
+   * the initial iterate, and that the complex-valued planar specialization
+   * (use_complex_planar_solver) does not support this mode. */
+  bool hard_deadline = false;
+
+  /** In hard-deadline mode, the time reserved for post-processing is this
+   * multiple of its estimated cost */
+  double deadline_reserve_factor = 2;
+
   /// These next two parameters define the stopping criteria for the truncated
   /// preconditioned conjugate-gradient solver running in the inner loop --
   /// they control the tradeoff between the quality of the returned
@@ -71,17 +95,83 @@ struct SESyncOpts {
    * optimization algorithm as it runs. */
   std::optional<SESyncTNTUserFunction> user_function;
 
+  /** An optional monitor that can be used to cancel the algorithm, and to
+   * observe its progress, from another thread (cf. SESyncMonitor).  If
+   * cancellation is requested, the algorithm stops at the next safe point and
+   * returns the rounding of the best iterate computed so far, with status
+   * Cancelled. */
+  std::shared_ptr<SESyncMonitor> monitor;
+
   /// SE-SYNC PARAMETERS
 
   /** The specific formulation of the SE-Sync problem to solve */
   Formulation formulation = Formulation::Simplified;
 
+  /** If this value is true, then when solving a planar (d = 2) problem using
+   * the Simplified or SOSync formulation, SESync(measurements) will employ the
+   * complex-valued specialization PlanarSESyncProblem (in which elements of
+   * SO(2) are identified with unit-modulus complex numbers) in place of the
+   * generic real d x d block representation.  Since a complex rank-p iterate
+   * corresponds to a real rank-2p iterate, the Staircase levels r0 and rmax
+   * (which are specified in terms of *real* rank) are converted to complex
+   * ranks ceil(r0 / 2) and ceil(rmax / 2) when doing so. */
+  bool use_complex_planar_solver = false;
+
+  /** If this value is true, then when given a 3D problem, SESync(measurements)
+   * will first test whether it is (numerically) planar (cf.
+   * detect_planar_structure); if so, it will solve the corresponding planar
+   * (d = 2) problem instead, and lift the resulting estimates back to SE(3) */
+  bool detect_planar_problems = false;
+
+  /** Tolerance on the deviation |R_ij a - a| of each relative rotation from a
+   * rotation about the common axis a when testing for planarity */
+  Scalar planar_rotation_tol = 1e-3;
+
+  /** Tolerance on the (absolute) out-of-plane component |<t_ij, a>| of each
+   * relative translation when testing for planarity */
+  Scalar planar_translation_tol = 1e-3;
+
+  /** If this value is true, then SESync(measurements) will first compute the
+   * connected components of the pose graph; if there is more than one, each
+   * component is solved as an independent problem (concurrently, cf.
+   * SESyncBatch), and the results are combined (cf.
+   * SESyncResult::component_results).  Without this decomposition, the
+   * relative poses of disconnected components are unobservable, and the
+   * resulting problem is singular.  This is disabled by default, so that
+   * connected inputs (and callers who manage their own threading) are
+   * unaffected. */
+  bool decompose_components = false;
+
+  /** If this value is true, then SESync(measurements) will additionally split
+   * the pose graph at its bridges (the measurements whose removal would
+   * disconnect it, such as the edges of dangling odometry chains) into its
+   * 2-edge-connected components, solve these independently (as for
+   * decompose_components), and compose their solutions along the bridges,
+   * each of which can be satisfied exactly.  This removes every state of a
+   * dangling chain from the problems that must actually be solved. */
+  bool eliminate_bridges = false;
+
+  /** The total number of threads used to solve the connected components of a
+   * disconnected problem concurrently.  If this is 0, the components share
+   * the run's own allotment num_threads (so that a run nested inside another
+   * parallel driver, e.g. SESyncBatch or SESyncPortfolio, does not exceed the
+   * threads it was given). */
+  size_t component_threads = 0;
+
   /** The initial level of the Riemannian Staircase */
   size_t r0 = 5;
 
   /** The maximum level of the Riemannian Staircase to explore */
   size_t rmax = 10;
 
+  /** If this value is false, the Riemannian Staircase terminates after the
+   * local optimization at its initial level, without verifying the global
+   * optimality of the resulting critical point (in which case the status of
+   * the result is Unverified).  This is useful when solving a sequence of
+   * closely-related problems (e.g. the reweighted problems of a robust
+   * estimator, cf. RobustSESync) of which only the last must be certified. */
+  bool verify = true;
+
   /** Tolerance for accepting the minimum eigenvalue of the
    * certificate matrix as numerically nonnegative; this should be a small
    * positive value e.g. 10^-3 */
@@ -91,6 +181,57 @@ struct SESyncOpts {
    * certificate matrix */
   size_t LOBPCG_block_size = 4;
 
+  /** The number of trial stepsizes of the backtracking line search used to
+   * escape from saddle points that are evaluated together.  The trial points in
+   * each batch are evaluated using a single multiple-right-hand-side product
+   * with the data matrix and a single preconditioner solve, which is
+   * considerably cheaper than the equivalent sequence of single solves when
+   * many trial steps are needed; the batch is then scanned in the original
+   * order, so that the selected step is independent of the batch size.  Larger
+   * batches may perform unnecessary work when an early trial step is accepted.
+   */
+  size_t escape_line_search_batch_size = 1;
+
+  /** If this value is true, the initial stepsize of the backtracking line
+   * search used to escape from saddle points is predicted by fitting a local
+   * quartic model F(alpha) ~ F(Y) + theta * alpha^2 + gamma * alpha^4 of the
+   * objective along the escape direction (using the curvature theta and one
+   * additional function evaluation), rather than by the fixed heuristic
+   * 10 * grad_norm_tol / |theta|.  The predicted stepsize is capped at 4 times
+   * the heuristic one (at which the model is fitted). */
+  bool escape_model_guided_step = false;
+
+  /** Maximum number of directions of negative curvature of the certificate
+   * matrix (i.e., Ritz vectors computed by LOBPCG) to use simultaneously when
+   * escaping from a saddle point.  Using k > 1 directions allows the Riemannian
+   * Staircase to ascend up to k levels at once, saving the optimizations and
+   * verifications at the intermediate levels.  This value is capped at
+   * LOBPCG_block_size.  (Planar problems solved using the complex-valued
+   * specialization always escape along a single direction.) */
+  size_t max_escape_directions = 1;
+
+  /** If this value is true, the critical point found at each level of the
+   * Riemannian Staircase is truncated to its numerical rank k (cf.
+   * truncate_to_numerical_rank) whenever k is less than the current relaxation
+   * rank, and the relaxation rank is lowered to k before verification.  Since
+   * the truncated point has (up to the tolerance below) the same Gram matrix
+   * and objective value as the original, this does not affect the
+   * certificate; however, it keeps the size of the iterates (and therefore the
+   * cost of each product with them) as small as the solution actually
+   * requires, and prevents the Staircase from ascending from a level whose
+   * solution did not use all of its rows.  The Staircase only descends again
+   * to a rank that it has previously descended to if the objective has
+   * decreased by more than the relative tolerance rel_func_decrease_tol since
+   * then, so that it cannot alternate indefinitely between two ranks.  (This
+   * is not performed for planar problems solved using the complex-valued
+   * specialization.) */
+  bool reduce_rank = false;
+
+  /** Singular values of the critical point found at each level of the
+   * Staircase that are at most this fraction of its largest singular value are
+   * treated as zero when computing its numerical rank */
+  Scalar rank_tol = 1e-6;
+
   /// The next parameters control the sparsity of the incomplete symmetric
   /// indefinite factorization-based preconditioner used in conjunction with
   /// LOBPCG: 'max_fill_factor' and 'drop_tol' are parameters controlling the
@@ -118,10 +259,71 @@ struct SESyncOpts {
    * preconditioner */
   Scalar reg_Cholesky_precon_max_condition_number = 1e6;
 
+  /** The local optimization method used to compute a first-order critical
+   * point at each level of the Riemannian Staircase.  Block-coordinate descent
+   * is only available for the Explicit and SOSync formulations (the
+   * trust-region method is used otherwise); when it is used, max_iterations
+   * bounds the number of sweeps, and the preconditioner is not applied. */
+  LocalOptimizer local_optimizer = LocalOptimizer::TrustRegion;
+
+  /** The (maximum) number of consecutive states in each block when using
+   * block-coordinate descent */
+  size_t bcd_block_size = 100;
+
+  /** Maximum number of trust-region iterations applied to each block during
+   * each sweep of block-coordinate descent */
+  size_t bcd_local_iterations = 5;
+
   /** The initialization method to use for constructing an initial iterate Y0,
    * if none was provided */
   Initialization initialization = Initialization::Chordal;
 
+  /** Maximum number of LOBPCG iterations to perform when computing the
+   * spectral initialization (Initialization::Spectral) */
+  size_t spectral_init_max_iterations = 100;
+
+  /** Stopping tolerance for LOBPCG when computing the spectral initialization
+   */
+  Scalar spectral_init_tol = 1e-3;
+
+  /// The next parameters control the (loose) stopping criteria used for the
+  /// rotation synchronization solve in the rotation-first cascade
+  /// initialization (Initialization::SOSyncCascade)
+
+  /** Stopping tolerance for the norm of the Riemannian gradient in the
+   * cascade's rotation synchronization solve */
+  Scalar cascade_grad_norm_tol = 1e-1;
+
+  /** Stopping tolerance for the norm of the preconditioned Riemannian gradient
+   * in the cascade's rotation synchronization solve */
+  Scalar cascade_preconditioned_grad_norm_tol = 1e-2;
+
+  /** Stopping criterion based upon the relative decrease in function value
+   * between accepted iterations in the cascade's rotation synchronization
+   * solve */
+  Scalar cascade_rel_func_decrease_tol = 1e-4;
+
+  /// The next parameters control the multilevel initialization
+  /// (Initialization::Multilevel).  The coarsest problem in the hierarchy is
+  /// solved using the same (loose) stopping criteria as the cascade's
+  /// rotation synchronization solve.
+
+  /** Coarsening stops once a pose graph with at most this many states has
+   * been constructed */
+  size_t multilevel_coarsest_size = 1000;
+
+  /** Maximum number of coarsening steps */
+  size_t multilevel_max_levels = 20;
+
+  /** Coarsening stops if a coarsening step fails to reduce the number of
+   * states by at least this fraction */
+  Scalar multilevel_min_reduction = .1;
+
+  /** Maximum number of trust-region iterations (and LOBPCG iterations, when
+   * checking the optimality of the refined estimates) used to refine the
+   * prolonged estimates at each intermediate level of the hierarchy */
+  size_t multilevel_refinement_iterations = 10;
+
   /** Whether to print output as the algorithm runs */
   bool verbose = false;
 
@@ -129,6 +331,24 @@ struct SESyncOpts {
    * entire sequence of iterates generated by the Riemannian Staircase */
   bool log_iterates = false;
 
+  /** If this value is nonempty, the iterates generated by the trust-region
+   * method at each level of the Riemannian Staircase are streamed to the binary
+   * file with this name as they are produced (cf. IterateWriter for the file
+   * format).  Unlike log_iterates, this requires only a constant amount of
+   * memory.  Planar problems solved using the complex-valued specialization
+   * record the real representations of their iterates.  If writing to this
+   * file fails (e.g. because the disk is full), SE-Sync throws a
+   * std::runtime_error rather than returning with a truncated log. */
+  std::string iterate_log_file;
+
+  /** When streaming iterates to iterate_log_file, only every k-th iterate at
+   * each level of the Staircase is recorded */
+  size_t iterate_log_stride = 1;
+
+  /** When streaming iterates to iterate_log_file, store them in single
+   * precision */
+  bool iterate_log_single_precision = false;
+
   /** The number of threads to use for parallelization (assuming that SE-Sync is
    * built using a compiler that supports OpenMP */
   size_t num_threads = 1;
@@ -155,7 +375,16 @@ enum SESyncStatus {
 
   /** The algorithm exhausted the allotted total computation time before finding
    * an optimal solution */
-  ElapsedTime
+  ElapsedTime,
+
+  /** The algorithm was cancelled (via SESyncOpts::monitor) before finding an
+   * optimal solution */
+  Cancelled,
+
+  /** The algorithm computed a first-order critical point at the initial level
+   * of the Riemannian Staircase, whose optimality was not verified (cf.
+   * SESyncOpts::verify) */
+  Unverified
 };
 
 /** This struct contains the output of the SESync algorithm */
@@ -207,6 +436,83 @@ struct SESyncResult {
    * Riemannian Staircase */
   double initialization_time;
 
+  /** In hard-deadline mode, the computation time that was reserved for
+   * post-processing */
+  double rounding_reserve_time = 0;
+
+  /// If the rotation-first cascade initialization was used, the next three
+  /// values record the elapsed computation time spent in each of its phases
+
+  /** Elapsed time needed to construct the rotation synchronization problem */
+  double cascade_construction_time = 0;
+
+  /** Elapsed time needed to solve the rotation synchronization problem */
+  double cascade_rotation_time = 0;
+
+  /** Elapsed time needed to lift the estimated rotations (and recover the
+   * corresponding translations, if necessary) to an initial iterate Y0 */
+  double cascade_lifting_time = 0;
+
+  /// If the multilevel initialization was used, the next values describe the
+  /// hierarchy of coarsened problems, and record the elapsed computation time
+  /// spent in each of its phases
+
+  /** The number of states in each level of the hierarchy, from the finest
+   * (the original problem) to the coarsest */
+  std::vector<size_t> multilevel_num_states;
+
+  /** Elapsed time needed to construct the hierarchy of coarsened problems */
+  double multilevel_coarsening_time = 0;
+
+  /** Elapsed time needed to solve the coarsest problem */
+  double multilevel_coarse_solve_time = 0;
+
+  /** Elapsed time needed to prolong and refine the estimates through the
+   * hierarchy, and to lift them to an initial iterate Y0 */
+  double multilevel_refinement_time = 0;
+
+  /** This value is true if a 3D problem was detected to be planar, and was
+   * therefore solved as a planar problem (cf. SESyncOpts::
+   * detect_planar_problems).  In that case, Yopt, SDPval, gradnorm and
+   * duality_gap refer to the relaxation of the reduced planar problem, while
+   * xhat and Fxhat refer to the original 3D problem.  If the planar solution
+   * was certified, the lifted estimates xhat are then certified on the
+   * original 3D problem (cf. certify), and status, Lambda, trLambda and
+   * suboptimality_bound are those of this 3D certificate; otherwise, Lambda is
+   * empty and trLambda, duality_gap and suboptimality_bound are NaN. */
+  bool planar_reduction = false;
+
+  /** Elapsed time needed to test for planarity and construct the reduced
+   * planar problem */
+  double planar_reduction_time = 0;
+
+  /** Elapsed time needed to certify the lifted estimates of a planar problem
+   * on the original 3D problem */
+  double planar_certification_time = 0;
+
+  /** If the pose graph was decomposed into its connected (or 2-edge-connected)
+   * components (cf. SESyncOpts::decompose_components and
+   * SESyncOpts::eliminate_bridges), this contains the (original) indices of
+   * the states in each component, in increasing order */
+  std::vector<std::vector<size_t>> component_states;
+
+  /** If the pose graph was decomposed into components, this contains the
+   * result of solving each component (expressed in terms of the component's
+   * own states).  In that case, Yopt (padded with zero rows to the greatest
+   * relaxation rank among the components), Lambda and xhat are assembled from
+   * the components' solutions (composed along the bridges joining them, if
+   * any); SDPval, trLambda and duality_gap are the sums of the components'
+   * values; gradnorm is the norm of the combined gradient; and status is
+   * GlobalOpt if every component was certified (and otherwise the status of
+   * the first uncertified component).  The per-level histories,
+   * initialization times and telemetry are recorded only in the components'
+   * results. */
+  std::vector<SESyncResult> component_results;
+
+  /** If the pose graph was decomposed into its 2-edge-connected components,
+   * the number of bridges joining them */
+  size_t num_bridges = 0;
+
   /** A vector containing the sequence of function values obtained during the
    * optimization at each level of the Riemannian Staircase */
   std::vector<std::vector<Scalar>> function_values;
@@ -251,6 +557,22 @@ struct SESyncResult {
    */
   std::vector<Scalar> escape_direction_curvatures;
 
+  /** A vector containing the relaxation rank at each level of the Riemannian
+   * Staircase that was visited */
+  std::vector<size_t> relaxation_ranks;
+
+  /** A vector containing the numerical rank (cf. SESyncOpts::rank_tol) of the
+   * critical point found at each level of the Riemannian Staircase that was
+   * visited; if SESyncOpts::reduce_rank is true, this is the relaxation rank
+   * at which that point was verified */
+  std::vector<size_t> numerical_ranks;
+
+  /** A vector containing the number of directions of negative curvature used
+   * to escape from the saddle point found at each level of the Riemannian
+   * Staircase (i.e., the number of levels by which the relaxation rank was
+   * increased) */
+  std::vector<size_t> escape_directions;
+
   /** A vector containing the number of LOBPCG iterations performed for the
    * minimum-eigenpair computation at each level of the Riemannian Staircase */
   std::vector<size_t> LOBPCG_iters;
@@ -264,6 +586,11 @@ struct SESyncResult {
    * level of the Riemannian Staircase */
   std::vector<std::vector<Matrix>> iterates;
 
+  /** A hierarchical record of the elapsed computation time spent in each
+   * phase of the algorithm, together with counts of its most expensive
+   * operations (cf. to_json for serialization) */
+  SESyncTelemetry telemetry;
+
   /** The termination status of the SE-Sync algorithm */
   SESyncStatus status;
 };
@@ -273,6 +600,18 @@ SESyncResult SESync(SESyncProblem &problem,
                     const SESyncOpts &options = SESyncOpts(),
                     const Matrix &Y0 = Matrix());
 
+/** Given a PlanarSESyncProblem instance, this function performs
+ * synchronization using the complex-valued specialization of the SE-Sync
+ * algorithm for planar problems.  Here the levels r0 and rmax of the Riemannian
+ * Staircase are interpreted as *complex* ranks, and Y0 (if supplied) must be a
+ * complex r0 x n matrix.  The returned Yopt is the real representation (cf.
+ * real_representation) of the complex solution, and all other fields of the
+ * result are expressed in terms of the real formulation.  Note that
+ * options.user_function (which operates on real iterates) is ignored. */
+SESyncResult SESync(PlanarSESyncProblem &problem,
+                    const SESyncOpts &options = SESyncOpts(),
+                    const ComplexMatrix &Y0 = ComplexMatrix());
+
 /** Given a vector of relative pose measurements specifying a special Euclidean
  * synchronization problem, performs synchronization using the SESync algorithm
  */
@@ -280,6 +619,102 @@ SESyncResult SESync(const measurements_t &measurements,
                     const SESyncOpts &options = SESyncOpts(),
                     const Matrix &Y0 = Matrix());
 
+/** A handle to an SE-Sync run that is executing asynchronously (cf.
+ * SESyncAsync) */
+struct SESyncHandle {
+  /** The monitor attached to the run */
+  std::shared_ptr<SESyncMonitor> monitor;
+
+  /** The result of the run; any exception thrown by SE-Sync is rethrown by
+   * result.get() */
+  std::future<SESyncResult> result;
+
+  /** Request that the run terminate at the next safe point */
+  void cancel() { monitor->request_cancellation(); }
+
+  /** Returns a snapshot of the progress of the run */
+  SESyncProgress progress() const { return monitor->progress(); }
+};
+
+/** Launches SESync(measurements, options, Y0) on a new thread, and returns a
+ * handle that can be used to cancel the run, observe its progress, and
+ * retrieve its result.  If options.monitor is null, a new monitor is created
+ * for this run.  The measurements, options and initial iterate are copied, and
+ * so need not outlive the call. */
+SESyncHandle SESyncAsync(const measurements_t &measurements,
+                         const SESyncOpts &options = SESyncOpts(),
+                         const Matrix &Y0 = Matrix());
+
+/** This struct contains the output of the certification of an externally
+ * computed estimate (cf. certify) */
+struct SESyncCertificate {
+  /** The termination status: GlobalOpt if the estimate was certified as
+   * globally optimal, SaddlePoint if a direction of negative curvature of the
+   * certificate matrix was found (so that the estimate is not optimal), or
+   * EigImprecision if the minimum-eigenvalue computation did not converge to
+   * sufficient precision to decide either way */
+  SESyncStatus status = EigImprecision;
+
+  /** The estimate xhat = [t | R] (or xhat = R) that was certified: the
+   * supplied estimate, or the rounding of its polished lifting if polishing
+   * was requested */
+  Matrix xhat;
+
+  /** The objective value attained by xhat (with optimal translations, if
+   * xhat contains only rotations) */
+  Scalar Fxhat = 0;
+
+  /** The point Y in the domain of the rank-d relaxation at which the
+   * certificate matrix was constructed, i.e. the lifting of xhat */
+  Matrix Y;
+
+  /** The norm of the Riemannian gradient at Y; a globally optimal estimate is
+   * a first-order critical point */
+  Scalar gradnorm = 0;
+
+  /** The Lagrange multiplier matrix Lambda(Y) and its trace.  If the estimate
+   * was certified, tr(Lambda) is a lower bound on the optimal value */
+  SparseMatrix Lambda;
+  Scalar trLambda = 0;
+
+  /** Upper bound F(xhat) - tr(Lambda) on the global suboptimality of xhat;
+   * this is only valid if status == GlobalOpt */
+  Scalar suboptimality_bound = 0;
+
+  /** The (approximate) minimum eigenvalue theta of the certificate matrix, and
+   * (if the estimate was not certified) the corresponding eigenvector, which
+   * provides a direction of negative curvature along which to escape from Y
+   * (cf. escape_saddle) */
+  Scalar theta = 0;
+  Vector escape_direction;
+
+  /** Number of LOBPCG iterations performed during verification */
+  size_t LOBPCG_iters = 0;
+
+  /** Elapsed computation time needed to lift xhat, to polish it, to verify
+   * the resulting point (including the computation of Lambda), and in total
+   */
+  double lifting_time = 0;
+  double polishing_time = 0;
+  double verification_time = 0;
+  double total_computation_time = 0;
+};
+
+/** Certifies the global optimality of an externally computed estimate xhat =
+ * [t | R] in SE(d)^n (or xhat = R in SO(d)^n) for the given problem, without
+ * running the Riemannian Staircase.  xhat is lifted to a point Y in the domain
+ * of the rank-d relaxation (if xhat contains only rotations, the Explicit
+ * formulation uses the corresponding optimal translations); if
+ * polish_iterations > 0, Y is then refined by at most this many trust-region
+ * iterations (using the stopping criteria in 'options'), in order to bring an
+ * approximate estimate to first-order criticality.  Finally, the certificate
+ * matrix S(Y) = Q - Lambda(Y) is tested for positive-semidefiniteness (cf.
+ * SESyncProblem::verify_solution, using the tolerance and LOBPCG parameters in
+ * 'options').  Note that this sets the relaxation rank of 'problem' to d. */
+SESyncCertificate certify(SESyncProblem &problem, const Matrix &xhat,
+                          const SESyncOpts &options = SESyncOpts(),
+                          size_t polish_iterations = 0);
+
 /** Helper function: used in the Riemannian Staircase to escape from a saddle
  *  point.  Here:
  *
@@ -312,9 +747,46 @@ SESyncResult SESync(const measurements_t &measurements,
  * Postcondition: If this function returns true, then upon termination Yplus
  * contains the point at which to initialize the optimization at the next level
  * of the Riemannian Staircase
+ *
+ * The optional batch_size argument sets the number of consecutive trial
+ * stepsizes of the backtracking line search that are evaluated together (cf.
+ * SESyncOpts::escape_line_search_batch_size); the accepted step does not
+ * depend upon this value.  If model_guided_step is true, the initial stepsize
+ * is predicted from a local quartic model of the objective along the escape
+ * direction (cf. SESyncOpts::escape_model_guided_step).  If 'interrupt' is
+ * supplied, it is polled before each batch of trial steps, and the line search
+ * is abandoned (returning false) as soon as it returns true.
  */
 bool escape_saddle(const SESyncProblem &problem, const Matrix &Y, Scalar theta,
                    const Vector &v, Scalar gradient_tolerance,
-                   Scalar preconditioned_gradient_tolerance, Matrix &Yplus);
+                   Scalar preconditioned_gradient_tolerance, Matrix &Yplus,
+                   size_t batch_size = 1, bool model_guided_step = false,
+                   const std::function<bool()> &interrupt = {});
+
+/** Helper function: this generalizes escape_saddle to escape along k
+ * orthonormal directions of negative curvature simultaneously, thereby
+ * ascending k levels of the Riemannian Staircase in a single step.  Here V is
+ * a matrix whose k columns are the escape directions, and thetas is the vector
+ * of corresponding curvatures.
+ *
+ * Precondition: the relaxation rank r of 'problem' must be k greater than the
+ * number of rows of Y
+ */
+bool escape_saddle(const SESyncProblem &problem, const Matrix &Y,
+                   const Vector &thetas, const Matrix &V,
+                   Scalar gradient_tolerance,
+                   Scalar preconditioned_gradient_tolerance, Matrix &Yplus,
+                   size_t batch_size = 1, bool model_guided_step = false,
+                   const std::function<bool()> &interrupt = {});
+
+/** Helper function: the analog of escape_saddle for planar problems, in which
+ * Y is a complex critical point and v is a complex eigenvector of the
+ * (Hermitian) certificate matrix with curvature theta < 0 */
+bool escape_saddle(const PlanarSESyncProblem &problem, const ComplexMatrix &Y,
+                   Scalar theta, const ComplexVector &v,
+                   Scalar gradient_tolerance,
+                   Scalar preconditioned_gradient_tolerance,
+                   ComplexMatrix &Yplus,
+                   const std::function<bool()> &interrupt = {});
 
 } // namespace SESync
@@ -0,0 +1,79 @@
+/** This file provides an interface for solving large collections of
+ * independent special Euclidean synchronization problems concurrently.
+ *
+ * Problems are scheduled on a pool of worker threads with per-worker task
+ * deques and work stealing.  The total number of threads in use (including the
+ * OpenMP threads used within each individual SE-Sync run) is governed by a
+ * shared thread budget: each problem is allotted a number of intra-problem
+ * threads proportional to its size (as permitted by the number of threads
+ * currently available), so that large problems are solved with parallel
+ * kernels while small problems are solved one-per-thread.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESync.h"
+
+namespace SESync {
+
+/** This struct contains the parameters that control the scheduling of a batch
+ * of SE-Sync problems */
+struct SESyncBatchOpts {
+  /** The total number of threads to use (0 means the number of hardware
+   * threads) */
+  size_t num_threads = 0;
+
+  /** A problem with m measurements is allotted up to
+   * ceil(m / measurements_per_thread) threads for its own (OpenMP)
+   * parallelism */
+  size_t measurements_per_thread = 20000;
+
+  /** Whether to print a line to stdout as each problem finishes */
+  bool verbose = false;
+};
+
+/** This struct contains the output of a batch of SE-Sync runs */
+struct SESyncBatchResult {
+  /** The result of each problem, in the order in which the problems were
+   * supplied */
+  std::vector<SESyncResult> results;
+
+  /** The number of intra-problem threads allotted to each problem */
+  std::vector<size_t> num_threads;
+
+  /** Total elapsed wall-clock time (in seconds) */
+  double total_time = 0;
+
+  /** Achieved throughput (problems per second) */
+  double throughput = 0;
+};
+
+/** A function that is called as each problem of a batch finishes, with the
+ * index of the problem and its result.  Calls are serialized, but may be made
+ * from any of the worker threads. */
+typedef std::function<void(size_t, const SESyncResult &)> SESyncBatchCallback;
+
+/** Solves each of the given synchronization problems using SE-Sync with the
+ * given options, and returns their results.  The value of options.num_threads
+ * is ignored (the number of threads used for each problem is determined by the
+ * scheduler), and options.iterate_log_file must be empty.  If options.monitor
+ * is set, requesting its cancellation cancels every run of the batch; each run
+ * reports its progress to its own child monitor (cf. SESyncMonitor::child),
+ * so nothing is published to options.monitor itself.  If the optional
+ * 'callback' is supplied, it is called with each result as soon as it becomes
+ * available.  If any run throws an exception, the remaining problems are still
+ * solved, and the first such exception is rethrown once the batch has
+ * finished. */
+SESyncBatchResult
+SESyncBatch(const std::vector<measurements_t> &problems,
+            const SESyncOpts &options = SESyncOpts(),
+            const SESyncBatchOpts &batch_options = SESyncBatchOpts(),
+            const SESyncBatchCallback &callback = SESyncBatchCallback());
+
+} // namespace SESync
@@ -0,0 +1,154 @@
+/** This lightweight class provides a means of supervising an SE-Sync run from
+ * another thread: it carries a cancellation token that the algorithm polls at
+ * safe points (between iterations of the trust-region method and of LOBPCG
+ * during verification and the spectral initialization, between the trial steps
+ * of the saddle escape line search, between the levels of the multilevel
+ * initialization, and at the start of each Staircase level), together with a
+ * snapshot of the algorithm's progress that can be read at any time without
+ * blocking (or otherwise slowing) the solver.  The final rounding of the best
+ * iterate is not interrupted, since a cancelled run still returns it.
+ *
+ * The progress snapshot is published using a sequence lock: the (single)
+ * writer increments a sequence counter before and after updating the snapshot,
+ * and readers retry until they observe the same even counter value on both
+ * sides of their read.  Consequently readers always obtain a consistent
+ * snapshot, and the writer never waits on a reader.
+ *
+ * Drivers that run several SE-Sync solves concurrently (or nest one solve
+ * inside another) must therefore never hand the same monitor to more than one
+ * of them.  Instead, each nested run is given a child monitor (cf.
+ * SESyncMonitor::child): the child reports cancellation whenever its parent
+ * does, but its progress snapshot is private, so that the parent's snapshot
+ * is only ever written by the thread that owns it.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+/** These enumerations describe the phase of the SE-Sync algorithm that is
+ * currently executing */
+enum class SESyncPhase {
+  /** The algorithm has not yet started */
+  Idle,
+
+  /** Constructing the SE-Sync problem instance from the measurements */
+  Construction,
+
+  /** Computing the initial iterate for the Riemannian Staircase */
+  Initialization,
+
+  /** Running the Riemannian trust-region method at the current level of the
+   * Staircase */
+  Optimization,
+
+  /** Verifying the global optimality of a first-order critical point */
+  Verification,
+
+  /** Escaping from a saddle point to the next level of the Staircase */
+  SaddleEscape,
+
+  /** Rounding the solution of the relaxation, and computing the associated
+   * primal-dual certificates */
+  Rounding,
+
+  /** The algorithm has terminated */
+  Finished
+};
+
+/** A snapshot of the progress of an SE-Sync run */
+struct SESyncProgress {
+  /** The phase that is currently executing */
+  SESyncPhase phase = SESyncPhase::Idle;
+
+  /** The current level r of the Riemannian Staircase (0 before the Staircase
+   * has started) */
+  size_t level = 0;
+
+  /** The number of trust-region iterations performed at the current level */
+  size_t iteration = 0;
+
+  /** The objective value F(Y) at the most recent iterate (NaN if no iterate has
+   * been evaluated yet) */
+  Scalar objective_value = std::numeric_limits<Scalar>::quiet_NaN();
+
+  /** The norm of the Riemannian gradient at the most recent iterate (NaN if it
+   * has not been evaluated yet) */
+  Scalar gradient_norm = std::numeric_limits<Scalar>::quiet_NaN();
+
+  /** The elapsed computation time since the start of the run (in seconds) */
+  double elapsed_time = 0;
+};
+
+class SESyncMonitor {
+private:
+  /** Cancellation token */
+  std::atomic<bool> cancellation_requested_{false};
+
+  /** The monitor (if any) whose cancellation this monitor mirrors */
+  std::shared_ptr<const SESyncMonitor> parent_;
+
+  /** Sequence counter for the progress snapshot; this is odd while an update
+   * is in progress */
+  std::atomic<uint64_t> sequence_{0};
+
+  /// Progress snapshot.  Each field is stored separately as a (lock-free)
+  /// atomic value; the sequence counter guarantees that readers observe them
+  /// consistently.
+
+  std::atomic<int> phase_{static_cast<int>(SESyncPhase::Idle)};
+  std::atomic<size_t> level_{0};
+  std::atomic<size_t> iteration_{0};
+  std::atomic<Scalar> objective_value_{
+      std::numeric_limits<Scalar>::quiet_NaN()};
+  std::atomic<Scalar> gradient_norm_{std::numeric_limits<Scalar>::quiet_NaN()};
+  std::atomic<double> elapsed_time_{0};
+
+public:
+  /** Construct a monitor that additionally reports cancellation whenever
+   * 'parent' (if any) does */
+  explicit SESyncMonitor(std::shared_ptr<const SESyncMonitor> parent = nullptr)
+      : parent_(std::move(parent)) {}
+
+  /** Returns a new monitor whose cancellation mirrors that of 'parent' (which
+   * may be null), for supervising a nested or concurrent run */
+  static std::shared_ptr<SESyncMonitor>
+  child(const std::shared_ptr<const SESyncMonitor> &parent) {
+    return std::make_shared<SESyncMonitor>(parent);
+  }
+
+  /** Request that the SE-Sync run(s) supervised by this monitor (and its
+   * children) terminate at the next safe point.  This function may be called
+   * from any thread. */
+  void request_cancellation() {
+    cancellation_requested_.store(true, std::memory_order_relaxed);
+  }
+
+  /** Returns true if cancellation has been requested of this monitor or of any
+   * of its ancestors */
+  bool cancellation_requested() const {
+    return cancellation_requested_.load(std::memory_order_relaxed) ||
+           (parent_ && parent_->cancellation_requested());
+  }
+
+  /** Publish a new progress snapshot.  This function is called by the SE-Sync
+   * algorithm itself, and must not be called concurrently from more than one
+   * thread. */
+  void publish(const SESyncProgress &progress);
+
+  /** Returns the most recently published progress snapshot.  This function
+   * may be called from any thread. */
+  SESyncProgress progress() const;
+};
+
+} // namespace SESync
@@ -0,0 +1,104 @@
+/** This file provides a portfolio interface to the SE-Sync algorithm: several
+ * configurations (formulation, projection factorization, preconditioner,
+ * initialization, etc.) are raced concurrently on the same problem, each
+ * with its own share of the available threads.  The first configuration to
+ * reach a certified global optimum wins, and the others are cancelled (cf.
+ * SESyncMonitor).  The outcome of each configuration can be appended to a
+ * CSV file, in order to learn good per-dataset defaults.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESync.h"
+
+namespace SESync {
+
+/** This struct contains the parameters that control a portfolio run */
+struct SESyncPortfolioOpts {
+  /** The configurations to race.  Each configuration's num_threads is set by
+   * the portfolio, and its iterate_log_file must be empty.  Each run reports
+   * to a private monitor created by the portfolio, which mirrors the
+   * cancellation of the configuration's own monitor (if any), so that the
+   * portfolio can be cancelled from outside. */
+  std::vector<SESyncOpts> variants;
+
+  /** The total number of threads to divide among the configurations (0 means
+   * the number of hardware threads) */
+  size_t num_threads = 0;
+
+  /** If this is nonempty, the outcome of each configuration is appended to
+   * this (CSV) file */
+  std::string record_file = "";
+
+  /** The name of the dataset, used to label the recorded outcomes */
+  std::string dataset_name = "";
+
+  /** Whether to print the outcome of each configuration to stdout */
+  bool verbose = false;
+};
+
+/** The outcome of a single configuration within a portfolio run */
+struct SESyncPortfolioRun {
+  /** The configuration */
+  SESyncOpts options;
+
+  /** Its result (with status Cancelled if it was cancelled) */
+  SESyncResult result;
+
+  /** Whether this configuration failed (threw an exception) */
+  bool failed = false;
+
+  /** Number of threads allotted to this configuration */
+  size_t num_threads = 0;
+
+  /** Elapsed wall-clock time (in seconds) until this configuration finished
+   * (or was cancelled) */
+  double elapsed_time = 0;
+};
+
+/** The output of a portfolio run */
+struct SESyncPortfolioResult {
+  /** The outcome of each configuration, in the order supplied */
+  std::vector<SESyncPortfolioRun> runs;
+
+  /** The index of the winning configuration: the first one to reach a
+   * certified global optimum, or (if none did) the one whose rounded solution
+   * attained the lowest objective value */
+  size_t winner = 0;
+
+  /** Total elapsed wall-clock time (in seconds) */
+  double total_time = 0;
+
+  /** Returns the result of the winning configuration */
+  const SESyncResult &result() const { return runs[winner].result; }
+};
+
+/** Returns a default portfolio derived from the 'base' configuration: the base
+ * configuration itself, together with one variant each using the alternative
+ * formulation (Simplified / Explicit), projection factorization (Cholesky /
+ * QR), preconditioner (RegularizedCholesky / Jacobi), and initialization
+ * (Chordal / Random) */
+std::vector<SESyncOpts>
+default_portfolio(const SESyncOpts &base = SESyncOpts());
+
+/** Races the configurations given in portfolio_options.variants (or
+ * default_portfolio() if none are given) on the synchronization problem
+ * defined by 'measurements', and returns the outcome of each. */
+SESyncPortfolioResult
+SESyncPortfolio(const measurements_t &measurements,
+                const SESyncPortfolioOpts &portfolio_options =
+                    SESyncPortfolioOpts());
+
+/** Appends the outcome of each configuration of a portfolio run to the given
+ * CSV file (writing a header line first if the file is empty) */
+void write_portfolio_record(const std::string &filename,
+                            const std::string &dataset_name,
+                            const SESyncPortfolioResult &portfolio_result);
+
+} // namespace SESync
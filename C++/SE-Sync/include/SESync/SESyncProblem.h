@@ -19,6 +19,7 @@
 #include <Eigen/SPQRSupport>
 #include <Eigen/Sparse>
 
+#include "SESync/KernelCounters.h"
 #include "SESync/RelativePoseMeasurement.h"
 #include "SESync/SESync_types.h"
 #include "SESync/SESync_utils.h"
@@ -27,8 +28,18 @@
 namespace SESync {
 
 /** The type of the sparse Cholesky factorization to use in the computation of
- * the orthogonal projection operation */
-typedef Eigen::CholmodDecomposition<SparseMatrix> SparseCholeskyFactorization;
+ * the orthogonal projection operation.  This extends Eigen's CHOLMOD wrapper
+ * with the ability to modify a cached factorization in place. */
+class SparseCholeskyFactorization
+    : public Eigen::CholmodDecomposition<SparseMatrix> {
+public:
+  /** Given a matrix C with the same number of rows as the factored matrix A,
+   * this function modifies the cached factorization to that of A + CC' (or of
+   * A - CC', if downdate is true) using CHOLMOD's rank-k update/downdate.
+   * Returns false if the modification failed, in which case the factorization
+   * must be recomputed. */
+  bool update(const SparseMatrix &C, bool downdate = false);
+};
 
 /** The type of the QR decomposition to use in the computation of the orthogonal
  * projection operation */
@@ -55,6 +66,10 @@ private:
   /** Relaxation rank */
   size_t r_ = 0;
 
+  /** The set of relative pose measurements from which this problem was
+   * constructed */
+  measurements_t measurements_;
+
   /** The oriented incidence matrix A encoding the underlying measurement
    * graph for this problem */
   SparseMatrix A_;
@@ -125,6 +140,49 @@ private:
   report).*/
   StiefelProduct SP_;
 
+  /// INSTRUMENTATION
+
+  /** Elapsed computation times needed to construct the factorization used to
+   * compute orthogonal projections (Simplified formulation only), to estimate
+   * the norm of the data matrix used to regularize the Cholesky
+   * preconditioner, and to factor that preconditioner */
+  double projection_factorization_time_ = 0;
+  double preconditioner_norm_estimate_time_ = 0;
+  double preconditioner_factorization_time_ = 0;
+
+  /** Running counts of the products with the data matrix, sparse linear
+   * solves (with either the projection factorization or the preconditioner),
+   * and applications of the certificate matrix within LOBPCG performed using
+   * this problem instance.  These are updated by (logically) const operations,
+   * and so are declared mutable. */
+  mutable size_t num_data_matrix_products_ = 0;
+  mutable size_t num_linear_solves_ = 0;
+  mutable size_t num_LOBPCG_operator_applications_ = 0;
+
+  /** The number of nonzero elements in the factors used to compute orthogonal
+   * projections and to apply the regularized Cholesky preconditioner (used to
+   * estimate the cost of solves with these factors) */
+  Scalar projection_factor_nnz_ = 0;
+  Scalar preconditioner_factor_nnz_ = 0;
+
+  /** The regularization constant lambda_reg used to construct the regularized
+   * Cholesky preconditioner */
+  Scalar reg_Chol_precon_lambda_ = 0;
+
+  /** Private helper functions used to (re)construct the data matrices from
+   * the measurements, the factorization used to compute orthogonal
+   * projections, and the preconditioner.  If estimate_norm is false, the
+   * regularized Cholesky preconditioner reuses the previously-computed
+   * regularization constant.  If refactor is true, the Cholesky
+   * factorizations reuse their cached symbolic analyses (which requires that
+   * the sparsity patterns of the factored matrices are unchanged); these
+   * functions return false if this was not possible, and the factorization
+   * was instead recomputed from scratch. */
+  void construct_data_matrices();
+  bool construct_projection_factorization(bool refactor = false);
+  bool construct_preconditioner(bool estimate_norm = true,
+                                bool refactor = false);
+
   /** Private helper function: Given the diagonal blocks Lambda_1, ... Lambda_n
    * of the certificate matrix Lambda, construct and return the matrix:
    *
@@ -169,6 +227,54 @@ public:
   /** Set the maximum rank of the rank-restricted semidefinite relaxation */
   void set_relaxation_rank(size_t rank);
 
+  /** Appends the given measurements to this problem, updating its data
+   * matrices and cached factorizations.  The new measurements may connect
+   * existing states, and/or introduce new states (whose indices must be
+   * consecutive, starting at num_states(), and each of which must be
+   * connected to the existing states by the new measurements; an
+   * std::invalid_argument exception is thrown otherwise).  If no new states
+   * are introduced,
+   * the Cholesky factorizations used to compute orthogonal projections and to
+   * apply the regularized Cholesky preconditioner are modified in place using
+   * rank-k updates; otherwise (since their dimensions change) they are
+   * recomputed.  In either case the regularization constant of the
+   * preconditioner is retained from construction.  Returns true if all of the
+   * cached factorizations were updated in place.  The relaxation rank is
+   * unchanged. */
+  bool add_measurements(const measurements_t &measurements);
+
+  /** Replaces the measurements defining this problem with the given ones,
+   * updating its data matrices and cached factorizations as described in
+   * add_measurements.  If the number of states is unchanged, the cached
+   * Cholesky factorizations are modified in place using rank-k updates and
+   * downdates (provided that the changes to the factored matrices are
+   * supported on sufficiently few rows); this is efficient when only a few
+   * measurements are added or removed.  Measurements common to the old and
+   * new sets should appear in the same relative order in both. */
+  bool set_measurements(const measurements_t &measurements);
+
+  /** Replaces the rotational and translational precisions kappa and tau of
+   * the measurements defining this problem with the given (positive) values,
+   * e.g. in order to reweight the measurements within a robust estimator (cf.
+   * RobustSESync).  Since this leaves the sparsity patterns of the data
+   * matrices unchanged, the cached Cholesky factorizations are recomputed
+   * numerically using their existing symbolic analyses (fill-reducing
+   * orderings and supernodal structures), and the regularization constant of
+   * the preconditioner is retained from construction; the latter preserves
+   * the preconditioner's condition number bound provided that the precisions
+   * do not exceed those with which the problem was constructed.  Returns true
+   * if all of the cached factorizations were recomputed in this way.  The
+   * relaxation rank is unchanged. */
+  bool set_measurement_precisions(const Vector &kappa, const Vector &tau);
+
+  /** Given a point Y in the domain of the relaxation for this problem as it
+   * was when it contained only num_states states (i.e. before a call to
+   * add_measurements), this function extends Y to the current problem by
+   * propagating the (generalized) poses of the existing states to the new
+   * ones along the measurements that connect them.  The rank of Y is
+   * preserved. */
+  Matrix extend_iterate(const Matrix &Y, size_t num_states) const;
+
   /// ACCESSORS
 
   /** Returns the specific formulation of this problem */
@@ -208,6 +314,47 @@ public:
    * graph over which this problem is defined */
   const SparseMatrix &oriented_incidence_matrix() const { return A_; }
 
+  /** Returns the sparse data matrix whose quadratic form is the objective of
+   * the Explicit (M) or SOSync (LGrho) formulation.  Not available for the
+   * Simplified formulation, whose data matrix Q is not formed explicitly. */
+  const SparseMatrix &data_matrix() const;
+
+  /** Returns the set of relative pose measurements defining this problem */
+  const measurements_t &measurements() const { return measurements_; }
+
+  /// INSTRUMENTATION
+
+  /** Returns the elapsed time needed to factor the matrix used to compute
+   * orthogonal projections (0 unless solving the Simplified formulation) */
+  double projection_factorization_time() const {
+    return projection_factorization_time_;
+  }
+
+  /** Returns the elapsed time needed to estimate the norm of the data matrix
+   * when constructing the regularized Cholesky preconditioner */
+  double preconditioner_norm_estimate_time() const {
+    return preconditioner_norm_estimate_time_;
+  }
+
+  /** Returns the elapsed time needed to factor the regularized Cholesky
+   * preconditioner */
+  double preconditioner_factorization_time() const {
+    return preconditioner_factorization_time_;
+  }
+
+  /** Returns the number of products with the data matrix performed so far */
+  size_t num_data_matrix_products() const { return num_data_matrix_products_; }
+
+  /** Returns the number of sparse linear solves (cf.
+   * SESyncOperationCounts::linear_solves) performed so far */
+  size_t num_linear_solves() const { return num_linear_solves_; }
+
+  /** Returns the number of applications of the certificate matrix performed
+   * by LOBPCG during solution verification so far */
+  size_t num_LOBPCG_operator_applications() const {
+    return num_LOBPCG_operator_applications_;
+  }
+
   /// OPTIMIZATION AND GEOMETRY
 
   /** Given a matrix X, this function computes and returns the orthogonal
@@ -215,9 +362,19 @@ public:
   // We inline this function in order to take advantage of Eigen's ability
   // to optimize matrix expressions as compile time
   inline Matrix Pi_product(const Matrix &X) const {
-    if (projection_factorization_ == ProjectionFactorization::Cholesky)
+    SESYNC_KERNEL_SCOPE(Kernel::PiProduct,
+                        X.cols() * (4.0 * Ared_SqrtOmega_.nonZeros() +
+                                    4.0 * projection_factor_nnz_ + X.rows()),
+                        24.0 * (Ared_SqrtOmega_.nonZeros() +
+                                projection_factor_nnz_) +
+                            8.0 * X.cols() *
+                                (3.0 * X.rows() +
+                                 4.0 * Ared_SqrtOmega_.rows()));
+    if (projection_factorization_ == ProjectionFactorization::Cholesky) {
+      ++num_linear_solves_;
       return X - SqrtOmega_AredT_ * L_.solve(Ared_SqrtOmega_ * X);
-    else {
+    } else {
+      num_linear_solves_ += X.cols();
       Matrix PiX = X;
       for (size_t c = 0; c < X.cols(); c++) {
         // Eigen's SPQR support only supports solving with vectors(!) (i.e.
@@ -232,6 +389,12 @@ public:
   // We inline this function in order to take advantage of Eigen's ability to
   // optimize matrix expressions as compile time
   inline Matrix Q_product(const Matrix &X) const {
+    SESYNC_KERNEL_SCOPE(
+        Kernel::QProduct,
+        X.cols() * (2.0 * LGrho_.nonZeros() + 4.0 * SqrtOmega_T_.nonZeros() +
+                    X.rows()),
+        12.0 * (LGrho_.nonZeros() + 2.0 * SqrtOmega_T_.nonZeros()) +
+            24.0 * X.cols() * (X.rows() + SqrtOmega_T_.rows()));
     return LGrho_ * X + TT_SqrtOmega_ * Pi_product(SqrtOmega_T_ * X);
   }
 
@@ -287,6 +450,15 @@ public:
    * to dotY */
   Matrix precondition(const Matrix &Y, const Matrix &dotY) const;
 
+  /** Given a set of points Ys[i] in the domain D of the relaxation and
+   * corresponding tangent vectors dotYs[i] in T_D(Ys[i]), this function applies
+   * the selected preconditioning strategy to each dotYs[i].  When using the
+   * regularized Cholesky preconditioner, all of the required linear solves are
+   * carried out simultaneously (as a single multiple-right-hand-side solve
+   * with the cached factorization). */
+  std::vector<Matrix> precondition(const std::vector<Matrix> &Ys,
+                                   const std::vector<Matrix> &dotYs) const;
+
   /** Given a matrix Y in the domain D of the relaxation and a tangent vector
    * dotY in T_Y(E), the tangent space of Y considered as a generic matrix, this
    * function computes and returns the orthogonal projection of dotY onto
@@ -349,10 +521,38 @@ public:
                        Scalar max_fill_factor = 3,
                        Scalar drop_tol = 1e-3) const;
 
+  /** This function generalizes verify_solution to return (up to)
+   * num_directions orthonormal directions of negative curvature of S(Y),
+   * as the columns of X, together with the corresponding curvatures thetas
+   * (cf. the multiple-direction version of fast_verification).  The first
+   * column of X is always the estimated minimum eigenvector of S(Y).  If
+   * 'interrupt' is supplied, LOBPCG is abandoned as soon as it returns true
+   * (cf. fast_verification). */
+  bool verify_solution(const Matrix &Y, Scalar eta, size_t nx,
+                       size_t num_directions, Vector &thetas, Matrix &X,
+                       size_t &num_iters, size_t max_LOBPCG_iters = 1000,
+                       Scalar max_fill_factor = 3, Scalar drop_tol = 1e-3,
+                       const std::function<bool()> &interrupt = {}) const;
+
   /** Computes and returns the chordal initialization for the
    * rank-restricted semidefinite relaxation */
   Matrix chordal_initialization() const;
 
+  /** Computes and returns the spectral initialization for the rank-restricted
+   * semidefinite relaxation (cf. SESync::spectral_initialization), using at
+   * most max_iters LOBPCG iterations with stopping tolerance tol (or until
+   * 'interrupt' returns true) */
+  Matrix
+  spectral_initialization(size_t max_iters = 100, Scalar tol = 1e-3,
+                          const std::function<bool()> &interrupt = {}) const;
+
+  /** Given a d x dn matrix R = [R_1, ... , R_n] of rotational state estimates,
+   * this function constructs and returns the corresponding point in the domain
+   * of the rank-restricted semidefinite relaxation at the current relaxation
+   * rank r.  If this problem uses the Explicit formulation, the translational
+   * states are set to the optimal translations t(R) for the given rotations. */
+  Matrix lift_rotations(const Matrix &R) const;
+
   /** Randomly samples a point in the domain for the rank-restricted
    * semidefinite relaxation */
   Matrix random_sample() const;
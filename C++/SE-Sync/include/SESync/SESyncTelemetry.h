@@ -0,0 +1,123 @@
+/** This file defines a hierarchical record of the elapsed computation time
+ * spent in each phase of the SE-Sync algorithm, together with counts of its
+ * most expensive operations, and a function to serialize this record to JSON.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SESync/KernelCounters.h"
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+/** Operation counts for (some portion of) an SE-Sync run.  (These are not
+ * currently recorded by the complex-valued planar specialization.) */
+struct SESyncOperationCounts {
+  /** Number of products with the data matrix (Q, M, or the rotational
+   * connection Laplacian, depending upon the problem formulation) */
+  size_t data_matrix_products = 0;
+
+  /** Number of sparse linear solves with the factorization used to compute
+   * orthogonal projections (Cholesky or QR), or with the preconditioner.  A
+   * Cholesky solve with a block of right-hand sides counts once, while the QR
+   * factorization is applied to (and counted for) each column separately. */
+  size_t linear_solves = 0;
+
+  /** Number of (block) products with the certificate matrix performed by
+   * LOBPCG during solution verification */
+  size_t LOBPCG_operator_applications = 0;
+};
+
+/** Elapsed computation times (in seconds) and operation counts for a single
+ * level of the Riemannian Staircase */
+struct SESyncLevelTelemetry {
+  /** The relaxation rank at this level */
+  size_t relaxation_rank = 0;
+
+  /** Time spent in the Riemannian trust-region method */
+  double optimization_time = 0;
+
+  /** Time spent verifying the optimality of the resulting critical point */
+  double verification_time = 0;
+
+  /** Time spent escaping from a saddle point (0 if the level terminated
+   * otherwise) */
+  double escape_time = 0;
+
+  /** Operations performed at this level */
+  SESyncOperationCounts counts;
+
+  /** Kernel-level profile of this level (empty unless SE-Sync was built with
+   * kernel counters enabled; cf. KernelCounters.h) */
+  KernelProfile kernels;
+};
+
+/** Elapsed computation times (in seconds) and operation counts for an entire
+ * SE-Sync run */
+struct SESyncTelemetry {
+  /// PROBLEM CONSTRUCTION
+
+  /** Total time needed to construct the problem instance (only recorded when
+   * SE-Sync is called on a set of measurements, since otherwise the problem is
+   * constructed by the caller) */
+  double problem_construction_time = 0;
+
+  /// The next three values are recorded only for problems of type
+  /// SESyncProblem
+
+  /** Time needed to factor the matrix used to compute orthogonal projections
+   */
+  double projection_factorization_time = 0;
+
+  /** Time needed to estimate the norm of the data matrix for the regularized
+   * Cholesky preconditioner */
+  double preconditioner_norm_estimate_time = 0;
+
+  /** Time needed to factor the regularized Cholesky preconditioner */
+  double preconditioner_factorization_time = 0;
+
+  /// SE-SYNC ALGORITHM
+
+  /** Time needed to compute the initial iterate */
+  double initialization_time = 0;
+
+  /** Total time spent in the Riemannian Staircase */
+  double staircase_time = 0;
+
+  /** Per-level breakdown of the Riemannian Staircase */
+  std::vector<SESyncLevelTelemetry> levels;
+
+  /** Total time spent post-processing the solution of the relaxation */
+  double post_processing_time = 0;
+
+  /** Time spent rounding the solution (in hard-deadline mode, the total time
+   * spent rounding the candidate solutions at each level) */
+  double rounding_time = 0;
+
+  /** Time spent computing the Lagrange multipliers Lambda */
+  double Lambda_time = 0;
+
+  /** Total elapsed computation time (including problem construction, if
+   * recorded) */
+  double total_time = 0;
+
+  /** Operations performed during the entire run */
+  SESyncOperationCounts counts;
+
+  /** Kernel-level profile of the entire run (empty unless SE-Sync was built
+   * with kernel counters enabled) */
+  KernelProfile kernels;
+};
+
+/** Serializes the given telemetry record to a JSON object.  Non-finite values
+ * are represented as null.  Kernel profiles (including the achieved GFLOP/s
+ * and GB/s of each kernel) are included only if kernel counters are enabled.
+ */
+std::string to_json(const SESyncTelemetry &telemetry);
+
+} // namespace SESync
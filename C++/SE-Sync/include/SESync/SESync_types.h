@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <complex>
+
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
@@ -24,6 +26,15 @@ typedef Eigen::DiagonalMatrix<Scalar, Eigen::Dynamic> DiagonalMatrix;
  * documentation page on "Eigen and Multithreading") */
 typedef Eigen::SparseMatrix<Scalar, Eigen::RowMajor> SparseMatrix;
 
+/** Complex-valued counterparts of the above types, used to represent planar
+ * (d = 2) synchronization problems, in which elements of SO(2) are identified
+ * with unit-modulus complex numbers */
+typedef std::complex<Scalar> ComplexScalar;
+typedef Eigen::Matrix<ComplexScalar, Eigen::Dynamic, 1> ComplexVector;
+typedef Eigen::Matrix<ComplexScalar, Eigen::Dynamic, Eigen::Dynamic>
+    ComplexMatrix;
+typedef Eigen::SparseMatrix<ComplexScalar, Eigen::RowMajor> ComplexSparseMatrix;
+
 /** The specific formulation of special Euclidean synchronization problem to
  * solve */
 enum class Formulation {
@@ -54,8 +65,57 @@ enum class ProjectionFactorization { Cholesky, QR };
  * Trust Region when solving this problem */
 enum class Preconditioner { None, Jacobi, RegularizedCholesky };
 
+/** The local optimization method used to compute a first-order critical point
+ * at each level of the Riemannian Staircase */
+enum class LocalOptimizer {
+  /** Riemannian truncated-Newton trust-region method, applied to the entire
+   * iterate */
+  TrustRegion,
+
+  /** Parallel Riemannian block-coordinate descent: the states are partitioned
+   * into blocks, the blocks are colored so that no two blocks of the same
+   * color share a measurement, and the blocks of each color are optimized
+   * concurrently (using a few local trust-region iterations).  Only
+   * operative when solving the Explicit or SOSync formulations (whose
+   * objectives are sparse quadratic forms in the states). */
+  BlockCoordinateDescent
+};
+
 /** The strategy to use for constructing an initial iterate */
-enum class Initialization { Chordal, Random };
+enum class Initialization {
+  /** Chordal initialization of the rotational states (cf. Sec. 5 of the
+   * SE-Sync tech report), together with the optimal translations for these
+   * rotations (if required) */
+  Chordal,
+
+  /** Randomly sample a point in the domain of the rank-restricted relaxation
+   */
+  Random,
+
+  /** Spectral initialization of the rotational states: round the d
+   * eigenvectors of the rotational connection Laplacian corresponding to its d
+   * smallest eigenvalues (computed using LOBPCG) to SO(d)^n, together with the
+   * optimal translations for these rotations (if required).  This requires
+   * only sparse matrix-vector products with the connection Laplacian, and
+   * therefore scales to very large problems. */
+  Spectral,
+
+  /** Rotation-first cascade: first solve the rotation synchronization (SOSync)
+   * problem determined by the rotational data to a loose tolerance, and then
+   * use the resulting rotation estimates (together with the corresponding
+   * optimal translations, if required) to initialize the full special
+   * Euclidean synchronization problem.  Only operative when solving the
+   * Simplified or Explicit formulations. */
+  SOSyncCascade,
+
+  /** Multilevel initialization: construct a hierarchy of successively coarser
+   * pose graphs by repeatedly matching and contracting pairs of adjacent
+   * states, solve the coarsest problem to a loose tolerance, and then prolong
+   * the resulting estimates through the hierarchy (refining them with a few
+   * iterations of the Riemannian trust-region method at each intermediate
+   * level) to initialize the full problem */
+  Multilevel
+};
 
 /** A typedef for a user-definable function that can be used to
  * instrument/monitor the performance of the internal Riemannian
@@ -7,6 +7,7 @@ matrices used in the SE-Sync algorithm.
 
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include <Eigen/Sparse>
@@ -69,11 +70,85 @@ void construct_B1_B2_matrices(const measurements_t &measurements,
  * report) */
 SparseMatrix construct_M_matrix(const measurements_t &measurements);
 
+/// COMPLEX (PLANAR) DATA MATRICES
+///
+/// For planar (d = 2) problems, we identify the rotation [c -s; s c] in SO(2)
+/// with the unit-modulus complex number c + is, and a translation [x; y] in
+/// R^2 with the complex number x + iy.  With this identification, the objective
+/// of the special Euclidean synchronization problem can be written as a
+/// Hermitian quadratic form F(x) = x M x^H of the row vector x = [t | R] in
+/// C^{1 x 2n}; the functions below construct the (complex) data matrices
+/// parameterizing this quadratic form.  These are scaled so that the resulting
+/// objective values coincide with those of the real formulation.
+
+/** Given a planar rotation matrix R in SO(2), this function returns the
+ * corresponding unit-modulus complex number */
+inline ComplexScalar complex_rotation(const Matrix &R) {
+  return ComplexScalar(R(0, 0), R(1, 0));
+}
+
+/** Given a complex number z, this function returns the corresponding 2 x 2
+ * real matrix [Re(z) -Im(z); Im(z) Re(z)] */
+inline Matrix real_rotation(const ComplexScalar &z) {
+  Matrix R(2, 2);
+  R << z.real(), -z.imag(), z.imag(), z.real();
+  return R;
+}
+
+/** Given a vector of planar relative pose measurements, this function
+ * constructs and returns the corresponding complex rotational connection
+ * Laplacian (a Hermitian n x n matrix) */
+ComplexSparseMatrix construct_complex_rotational_connection_Laplacian(
+    const measurements_t &measurements);
+
+/** Given a vector of planar relative pose measurements, this function
+ * constructs and returns the associated m x n complex matrix of raw
+ * translational measurements (the complex analog of the matrix T) */
+ComplexSparseMatrix
+construct_complex_translational_data_matrix(const measurements_t &measurements);
+
+/** Given a vector of planar relative pose measurements, this function
+ * constructs and returns the 2n x 2n Hermitian matrix M parameterizing the
+ * translation-explicit formulation of the planar special Euclidean
+ * synchronization problem */
+ComplexSparseMatrix
+construct_complex_M_matrix(const measurements_t &measurements);
+
+/** Given a p x n complex matrix Y, this function returns its 2p x 2n real
+ * representation, obtained by replacing each element z of Y with the 2 x 2
+ * real matrix [Re(z) -Im(z); Im(z) Re(z)].  This maps the domain of the
+ * complex rank-restricted relaxation of a planar problem into the domain of
+ * the real relaxation at rank 2p, preserving objective values. */
+Matrix real_representation(const ComplexMatrix &Y);
+
+/** Given an N x N Hermitian matrix H = A + iB, this function returns the
+ * 2N x 2N real symmetric matrix [A -B; B A].  This matrix is
+ * positive-semidefinite if and only if H is, and (u, w) is an eigenvector of
+ * this matrix if and only if u + iw is an eigenvector of H. */
+SparseMatrix real_symmetric_embedding(const ComplexSparseMatrix &H);
+
 /** Given the measurement matrix B3 defined in equation (69c) of the tech report
  * and the problem dimension d, this function computes and returns the
  * corresponding chordal initialization for the rotational states */
 Matrix chordal_initialization(size_t d, const SparseMatrix &B3);
 
+/** Given the rotational connection Laplacian LGrho and the problem dimension
+ * d, this function computes and returns the corresponding spectral
+ * initialization for the rotational states.  This is obtained by computing the
+ * d eigenvectors of LGrho corresponding to its d smallest eigenvalues using
+ * (Jacobi-preconditioned) LOBPCG, rounding each of the d x d blocks of the
+ * resulting d x dn matrix to SO(d), and then fixing the gauge so that the first
+ * rotation is the identity.  Here:
+ *
+ * - max_iters is the maximum number of LOBPCG iterations to perform
+ * - tol is the stopping tolerance for LOBPCG
+ * - if 'interrupt' is supplied, LOBPCG is stopped early as soon as it returns
+ *   true (e.g. when the solve has been cancelled, cf. SESyncMonitor)
+ */
+Matrix spectral_initialization(size_t d, const SparseMatrix &LGrho,
+                               size_t max_iters = 100, Scalar tol = 1e-3,
+                               const std::function<bool()> &interrupt = {});
+
 /** Given the measurement matrices B1 and B2 and a matrix R of rotational state
  * estimates, this function computes and returns the corresponding optimal
  * translation estimates */
@@ -84,6 +159,143 @@ Matrix recover_translations(const SparseMatrix &B1, const SparseMatrix &B2,
  * SO(d) */
 Matrix project_to_SOd(const Matrix &M);
 
+/** Given a low-rank factor Y of a solution of the SDP relaxation, whose
+ * rotational states occupy the d * n columns starting at column rot_offset
+ * (any preceding columns contain translational states), this function rounds
+ * Y to a d x (rot_offset + dn) matrix of estimates by computing a rank-d
+ * truncated singular value decomposition of Y, correcting its orientation so
+ * that most of its rotational blocks have positive determinant, and then
+ * projecting each rotational block to SO(d) (cf. Algorithm 2 in the SE-Sync
+ * tech report) */
+Matrix round_solution(const Matrix &Y, size_t d, size_t rot_offset);
+
+/** Given a low-rank factor Y in R^{r x N}, this function computes the numerical
+ * rank k of Y, i.e. the number of its singular values that exceed tol times
+ * the largest one (but at least min_rank), using the eigendecomposition of the
+ * r x r Gram matrix Y * Y'.  If k < r, Y is replaced by the k x N matrix
+ * U' * Y, where the columns of U are the k leading left singular vectors of Y;
+ * since U' * Y is obtained by rotating Y and discarding rows of (relative)
+ * norm at most tol, its Gram matrix (U' * Y)' * (U' * Y) is equal to Y' * Y up
+ * to this tolerance.  The function returns k. */
+size_t truncate_to_numerical_rank(Matrix &Y, Scalar tol, size_t min_rank = 1);
+
+/** Given a vector of relative pose measurements and a matrix X = [t | R] of
+ * pose estimates (or X = R of rotation estimates, if X has only d * n
+ * columns), this function evaluates and returns the value of the maximum-
+ * likelihood estimation objective
+ *
+ * F(X) = sum_ij kappa_ij * |R_j - R_i * R_ij|_F^2 +
+ *               tau_ij * |t_j - t_i - R_i * t_ij|_2^2
+ *
+ * directly from the measurements (omitting the translational terms if X does
+ * not contain translations) */
+Scalar evaluate_objective(const measurements_t &measurements, const Matrix &X);
+
+/** Given a vector of relative pose measurements and a matrix X of pose (or
+ * rotation) estimates as in evaluate_objective, this function returns the
+ * vector whose kth element is the (weighted, squared) residual
+ *
+ * kappa_ij * |R_j - R_i * R_ij|_F^2 + tau_ij * |t_j - t_i - R_i * t_ij|_2^2
+ *
+ * of the kth measurement; these sum to F(X) */
+Vector measurement_residuals(const measurements_t &measurements,
+                             const Matrix &X);
+
+/// PLANAR PROBLEM DETECTION
+
+/** Given a vector of 3D relative pose measurements, this function tests whether
+ * the corresponding problem is (numerically) planar, i.e. whether there is a
+ * unit vector a (fixed in the body frame) such that every relative rotation
+ * R_ij is (approximately) a rotation about a, and every relative translation
+ * t_ij is (approximately) orthogonal to a.  This is the case for e.g. ground
+ * vehicles with a rigidly-mounted sensor.  More precisely, we estimate the
+ * axis a as the minimum eigenvector of
+ *
+ * C := sum_ij (R_ij - I)^T (R_ij - I) + t_ij t_ij^T / |t_ij|^2,
+ *
+ * and then declare the problem planar if |R_ij a - a| <= rotation_tol and
+ * |<t_ij, a>| <= translation_tol for all measurements.  If the problem is
+ * planar, this function returns true and sets Q to a rotation matrix mapping
+ * a to the z-axis e_3.
+ */
+bool detect_planar_structure(const measurements_t &measurements,
+                             Scalar rotation_tol, Scalar translation_tol,
+                             Matrix &Q);
+
+/** Given a vector of 3D relative pose measurements and a rotation Q mapping the
+ * common rotational axis of a planar problem to the z-axis (cf.
+ * detect_planar_structure), this function returns the corresponding vector of
+ * planar (d = 2) measurements, obtained by expressing each measurement in the
+ * rotated frame, and then discarding the out-of-plane components. */
+measurements_t reduce_planar_measurements(const measurements_t &measurements,
+                                          const Matrix &Q);
+
+/** Given a 2 x 3n matrix X = [t | R] of n planar pose estimates (or a 2 x 2n
+ * matrix of planar rotations R) computed from the reduced measurements
+ * returned by reduce_planar_measurements, this function lifts these to the
+ * corresponding 3 x 4n matrix of 3D pose estimates (resp. 3 x 3n matrix of 3D
+ * rotations) in the original frame */
+Matrix lift_planar_poses(const Matrix &X, size_t n, const Matrix &Q);
+
+/** Given a vector of relative pose measurements among n states, this function
+ * computes a coarsened pose graph by greedily matching each state with its
+ * unmatched neighbor along the measurement of greatest rotational precision
+ * (heavy-edge matching), and then contracting each matched pair into a single
+ * state.  On return, 'clusters' contains the (coarse) index of the state into
+ * which each of the n fine states was contracted, and 'offsets' contains the
+ * d x (d+1) relative transforms o_i = [t | R] of the fine states with respect
+ * to their coarse states (so that x_i = x_clusters[i] * o_i).  Measurements
+ * internal to a contracted pair are discarded, and parallel measurements
+ * between the same pair of coarse states are merged into a single measurement
+ * (whose precisions are the sums of those of the merged measurements).  The
+ * function returns the measurements of the coarsened pose graph. */
+measurements_t coarsen_measurements(const measurements_t &measurements,
+                                    std::vector<size_t> &clusters,
+                                    std::vector<Matrix> &offsets);
+
+/** Given a d x (d+1)n_c matrix X = [t | R] of pose estimates (or a d x dn_c
+ * matrix of rotation estimates R) for the states of a pose graph constructed
+ * by coarsen_measurements, together with the 'clusters' and 'offsets' returned
+ * by that function, this function computes and returns the corresponding
+ * estimates x_i = x_clusters[i] * o_i for the states of the fine pose graph */
+Matrix prolong_poses(const Matrix &X, const std::vector<size_t> &clusters,
+                     const std::vector<Matrix> &offsets);
+
+/// GRAPH DECOMPOSITION
+
+/** Given a vector of relative pose measurements among n states, this function
+ * computes the connected components of the pose graph.  On return,
+ * 'component' contains the index of the component containing each of the n
+ * states; components are numbered in increasing order of their
+ * lowest-indexed states.  The function returns the number of components. */
+size_t connected_components(const measurements_t &measurements,
+                            std::vector<size_t> &component);
+
+/** Given a vector of relative pose measurements among n states, this function
+ * computes the 2-edge-connected components of the pose graph, i.e. the
+ * connected components that remain after removing its bridges (the
+ * measurements whose removal would disconnect the graph, such as the edges of
+ * a dangling odometry chain); parallel measurements between the same pair of
+ * states are not bridges.  On return, 'component' contains the index of the
+ * component containing each of the n states; components are numbered in
+ * increasing order of their lowest-indexed states.  The function returns the
+ * number of components; the bridges are exactly the measurements whose
+ * endpoints lie in different components. */
+size_t two_edge_connected_components(const measurements_t &measurements,
+                                     std::vector<size_t> &component);
+
+/** Given a vector of relative pose measurements and an assignment of each
+ * state to one of num_components disjoint subgraphs, this function returns
+ * the measurements of each subgraph, re-indexed in terms of its own states;
+ * measurements between states of different subgraphs are discarded.  On
+ * return, states[c] contains the (original) indices of the states of subgraph
+ * c, in increasing order, so that local state k of subgraph c is state
+ * states[c][k]. */
+std::vector<measurements_t>
+split_measurements(const measurements_t &measurements,
+                   const std::vector<size_t> &component, size_t num_components,
+                   std::vector<std::vector<size_t>> &states);
+
 /** Given two matrices X, Y in SO(d)^n, this function computes and returns the
  * orbit distance d_S(X,Y) between them and (optionally) the optimal
  * registration G_S in SO(d) aligning Y to X, as described in Appendix C.1 of
@@ -119,10 +331,32 @@ Scalar dO(const Matrix &X, const Matrix &Y, Matrix *G_O = nullptr);
  *   factor L is guanteed to have at most max_fill_factor * (nnz(A) / dim(A))
  *   nonzero elements, and any elements l in L_k (the kth column of L)
  *   satisfying |l| <= drop_tol * |L_k|_1 will be set to 0.
+ * - if 'interrupt' is supplied, it is polled after each LOBPCG iteration, and
+ *   LOBPCG is abandoned as soon as it returns true (e.g. when the solve has
+ *   been cancelled, cf. SESyncMonitor); the returned direction is then not
+ *   meaningful, and the caller must check the same condition
  */
 bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
                        Scalar &theta, Vector &x, size_t &num_iters,
                        size_t max_iters = 1000, Scalar max_fill_factor = 3,
-                       Scalar drop_tol = 1e-3);
+                       Scalar drop_tol = 1e-3,
+                       const std::function<bool()> &interrupt = {});
+
+/** This function generalizes the fast solution verification method above to
+ * return *multiple* directions of negative curvature.  Here, if M is not PSD,
+ * X is set to an n x k matrix (1 <= k <= min(num_directions, nx)) whose
+ * (orthonormal) columns are the Ritz vectors computed by LOBPCG along which S
+ * has sufficiently negative curvature, and the vector thetas contains the
+ * corresponding Rayleigh quotients.  The first column of X is always the
+ * estimated minimum eigenvector of S.  If num_operator_applications is not
+ * null, it is set to the number of (block) products with the certificate
+ * matrix performed by LOBPCG.
+ */
+bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
+                       size_t num_directions, Vector &thetas, Matrix &X,
+                       size_t &num_iters, size_t max_iters = 1000,
+                       Scalar max_fill_factor = 3, Scalar drop_tol = 1e-3,
+                       size_t *num_operator_applications = nullptr,
+                       const std::function<bool()> &interrupt = {});
 
 } // namespace SESync
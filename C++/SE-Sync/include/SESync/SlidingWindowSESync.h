@@ -0,0 +1,145 @@
+/** This file provides a fixed-lag (sliding-window) interface to the SE-Sync
+ * algorithm, for use in long-duration applications in which only a certified
+ * estimate of the most recent portion of a trajectory is required.
+ *
+ * The solver maintains a window containing the most recent W states, together
+ * with all of the measurements between them.  As new states arrive, the oldest
+ * states leave the window and their estimates are fixed.  Each measurement
+ * between a fixed state and a state in the window (including loop closures to
+ * fixed states arriving later) is then summarized as a measurement between a
+ * single fixed anchor state (representing the world frame) and the
+ * corresponding state in the window, so that each solve is certifiably optimal
+ * for the window conditioned upon the fixed estimates of the states that have
+ * left it.  (If no measurement connects the window to a fixed state, its pose
+ * in the world frame is unobservable; the solution is then aligned with the
+ * current estimates of the window's states, so that the gauge is preserved.)
+ *
+ * States in the window are mapped onto a fixed set of slots (so that, once the
+ * window is full, the dimension of the windowed problem remains constant), and
+ * the cached factorizations of the windowed problem are modified in place by
+ * rank-k updates and downdates as the window slides (cf.
+ * SESyncProblem::set_measurements), and recomputed periodically.  The cost of
+ * each step is therefore bounded by the size of the window; only the fixed
+ * estimates themselves (d x (d+1) values per state) are retained for the
+ * entire history.
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESync.h"
+#include "SESync/SESyncProblem.h"
+
+namespace SESync {
+
+class SlidingWindowSESync {
+private:
+  /** The options used for each solve */
+  SESyncOpts options_;
+
+  /** The maximum number of states in the window */
+  size_t window_size_;
+
+  /** The number of updates after which the factorizations of the windowed
+   * problem are recomputed from scratch (rather than modified in place) */
+  size_t refactorization_period_;
+
+  /** Dimensional parameter d */
+  size_t d_ = 0;
+
+  /** The current estimate of each state seen so far, expressed in the world
+   * frame as a d x (d+1) matrix [t | R].  The estimates of the states that
+   * have left the window are fixed. */
+  std::vector<Matrix> poses_;
+
+  /** The index of the oldest state in the window */
+  size_t window_start_ = 0;
+
+  /** The measurements between states in the window (in order of arrival) */
+  measurements_t window_measurements_;
+
+  /** Measurements from the world frame (anchor) to states in the window,
+   * obtained by composing measurements from fixed states with the fixed
+   * estimates of those states.  For each measurement, i is the index of the
+   * fixed state from which it was derived, and j is the index of the state in
+   * the window. */
+  measurements_t anchor_measurements_;
+
+  /** The windowed problem */
+  std::unique_ptr<SESyncProblem> problem_;
+
+  /** The number of updates since the windowed problem was last factored */
+  size_t updates_since_factorization_ = 0;
+
+  /** The result of the most recent solve */
+  SESyncResult result_;
+
+  /** Elapsed time needed to update the windowed problem during the most recent
+   * update */
+  double problem_update_time_ = 0;
+
+  /** Elapsed time needed to solve the windowed problem during the most recent
+   * update */
+  double solve_time_ = 0;
+
+  /** Whether the cached factorizations were updated in place during the most
+   * recent update */
+  bool factorizations_updated_ = false;
+
+public:
+  /** Constructs an empty sliding-window solver with the given window size
+   * (which must be at least 2).  If refactorization_period is 0, the
+   * factorizations of the windowed problem are recomputed each time the
+   * window has advanced by window_size states. */
+  SlidingWindowSESync(size_t window_size,
+                      const SESyncOpts &options = SESyncOpts(),
+                      size_t refactorization_period = 0);
+
+  /** Appends the given measurements to the pose graph (using global state
+   * indices; the indices of new states must be consecutive, and each new
+   * state must be connected to the existing graph), advances the window, and
+   * re-solves the windowed problem, warm-starting from the current estimates
+   * at the rank of the previous solution.  Returns the result of the solve;
+   * note that this refers to the windowed problem, whose states are indexed by
+   * slot (cf. pose() to retrieve estimates by global index). */
+  const SESyncResult &update(const measurements_t &measurements);
+
+  /** Returns the number of states seen so far */
+  size_t num_states() const { return poses_.size(); }
+
+  /** Returns the index of the oldest state in the window */
+  size_t window_start() const { return window_start_; }
+
+  /** Returns the current estimate of state k, expressed in the world frame as
+   * a d x (d+1) matrix [t | R] */
+  const Matrix &pose(size_t k) const { return poses_.at(k); }
+
+  /** Returns the current windowed problem (which must have been constructed)
+   */
+  const SESyncProblem &problem() const { return *problem_; }
+
+  /** Returns the result of the most recent solve */
+  const SESyncResult &result() const { return result_; }
+
+  /** Returns the elapsed time needed to update the windowed problem during
+   * the most recent update */
+  double problem_update_time() const { return problem_update_time_; }
+
+  /** Returns the elapsed time needed to solve the windowed problem during the
+   * most recent update */
+  double solve_time() const { return solve_time_; }
+
+  /** Returns the total latency of the most recent update */
+  double update_time() const { return problem_update_time_ + solve_time_; }
+
+  /** Returns true if the cached factorizations were updated in place (rather
+   * than recomputed) during the most recent update */
+  bool factorizations_updated() const { return factorizations_updated_; }
+};
+
+} // namespace SESync
@@ -0,0 +1,141 @@
+/** This file provides a speculative interface to the Riemannian Staircase.
+ * Ordinarily the levels of the Staircase are strictly sequential (optimize at
+ * level r, verify, escape, optimize at level r + 1, ...), so that problems that
+ * regularly require several levels pay for the optimization and verification
+ * at each intermediate level in turn.  On machines with spare cores, the
+ * speculative mode instead starts a second Staircase directly at a higher
+ * level (chosen from the relaxation ranks at which previous solves of the same
+ * dataset were certified), concurrently with the ordinary one.  Each path
+ * solves its own instance of the problem with its own share of the available
+ * threads; the first path to reach a certified global optimum wins, and the
+ * other is cancelled (cf. SESyncMonitor and SESyncPortfolio).
+ *
+ * Copyright (C) 2016 - 2022 by David M. Rosen (dmrosen@mit.edu)
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SESync/RelativePoseMeasurement.h"
+#include "SESync/SESync.h"
+#include "SESync/SESync_types.h"
+
+namespace SESync {
+
+/** Whether a speculative Staircase is started alongside the ordinary one */
+enum class SpeculationMode {
+  /** Speculate only if there are enough threads to give each path
+   * min_threads_per_path of them, and previous solves of the same dataset
+   * needed at least min_historical_levels levels of the Staircase */
+  Auto,
+
+  /** Always speculate (using the rank given by speculative_rank, if no
+   * history is available) */
+  Always,
+
+  /** Never speculate (this is equivalent to calling SESync directly) */
+  Never,
+};
+
+/** This struct contains the parameters that control a speculative solve */
+struct SpeculativeSESyncOpts {
+  SpeculationMode mode = SpeculationMode::Auto;
+
+  /** The total number of threads to divide between the two paths (0 means the
+   * number of hardware threads) */
+  size_t num_threads = 0;
+
+  /** The minimum number of threads that each path must receive in order to
+   * speculate in Auto mode */
+  size_t min_threads_per_path = 2;
+
+  /** The minimum (median) number of levels of the Staircase needed by previous
+   * solves of the same dataset in order to speculate in Auto mode */
+  size_t min_historical_levels = 2;
+
+  /** If this is nonempty, the relaxation ranks at which previous solves of the
+   * dataset were certified are read from this (CSV) file, and the outcome of
+   * this solve is appended to it */
+  std::string history_file = "";
+
+  /** The name of the dataset, used to label the recorded outcomes */
+  std::string dataset_name = "";
+
+  /** The relaxation rank at which to start the speculative path.  If this is
+   * 0, the median of the historical certified ranks is used, or (if there is
+   * no history) the initial rank plus 1.  This value is clamped to the range
+   * [r0 + 1, rmax]. */
+  size_t speculative_rank = 0;
+
+  /** The speculative path starts from the chordal initialization (or from a
+   * random sample, if the base configuration uses a random initialization)
+   * lifted to the speculative rank, perturbed along a random tangent direction
+   * of this relative norm that is supported on the additional rows (a lifted
+   * iterate that is zero in those rows would otherwise never leave them) */
+  Scalar lifting_perturbation = 1e-2;
+
+  /** Whether to print the outcome of each path to stdout */
+  bool verbose = false;
+};
+
+/** The output of a speculative solve */
+struct SpeculativeSESyncResult {
+  /** The result of the winning path: the first one to reach a certified
+   * global optimum, or (if neither did) the one whose rounded solution
+   * attained the lower objective value */
+  SESyncResult result;
+
+  /** Whether a speculative path was started */
+  bool speculated = false;
+
+  /** Whether the speculative path won */
+  bool speculative_won = false;
+
+  /** The relaxation rank at which the speculative path was started */
+  size_t speculative_rank = 0;
+
+  /** The results of the ordinary and speculative paths (with status Cancelled
+   * if a path was cancelled) */
+  SESyncResult base_result;
+  SESyncResult speculative_result;
+
+  /** Elapsed wall-clock times (in seconds) until each path finished (or was
+   * cancelled) */
+  double base_time = 0;
+  double speculative_time = 0;
+
+  /** The certified relaxation ranks of previous solves of the same dataset that
+   * were read from the history file */
+  std::vector<size_t> historical_ranks;
+
+  /** Total elapsed wall-clock time (in seconds) */
+  double total_time = 0;
+};
+
+/** Solves the synchronization problem defined by 'measurements' using the
+ * given options, speculatively running a second Riemannian Staircase at a
+ * higher level concurrently with the ordinary one if this is enabled by
+ * speculative_options.  When speculating, options.num_threads is replaced by
+ * the paths' shares of speculative_options.num_threads, and each path reports
+ * to a private monitor that mirrors the cancellation of options.monitor (so
+ * that nothing is published to options.monitor itself). */
+SpeculativeSESyncResult SpeculativeSESync(
+    const measurements_t &measurements,
+    const SESyncOpts &options = SESyncOpts(),
+    const SpeculativeSESyncOpts &speculative_options = SpeculativeSESyncOpts());
+
+/** Returns the relaxation ranks at which previous solves of the given dataset
+ * were certified, as recorded in the given history file (or an empty vector if
+ * the file does not exist) */
+std::vector<size_t> read_speculation_history(const std::string &filename,
+                                             const std::string &dataset_name);
+
+/** Appends the outcome of a speculative solve (if it was certified) to the
+ * given history file (writing a header line first if the file is empty) */
+void write_speculation_history(const std::string &filename,
+                               const std::string &dataset_name,
+                               const SpeculativeSESyncResult &result);
+
+} // namespace SESync
@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/BlockCoordinateDescent.h"
+#include "SESync/StiefelProduct.h"
+
+namespace SESync {
+
+BlockCoordinateDescent::BlockCoordinateDescent(const SESyncProblem &problem,
+                                               size_t block_size)
+    : problem_(problem) {
+  if (problem.formulation() == Formulation::Simplified)
+    throw std::invalid_argument("Block-coordinate descent requires the "
+                                "Explicit or SOSync formulation");
+  if (block_size == 0)
+    throw std::invalid_argument("Block size must be positive");
+
+  const SparseMatrix &M = problem.data_matrix();
+  size_t n = problem.num_states();
+  size_t d = problem.dimension();
+  bool has_translations = (problem.formulation() == Formulation::Explicit);
+  size_t rot_offset = (has_translations ? n : 0);
+
+  // Returns the state corresponding to column j of the iterate
+  auto state = [&](size_t j) {
+    return (j < rot_offset ? j : (j - rot_offset) / d);
+  };
+
+  /// Partition the states into blocks of consecutive states
+
+  size_t num_blocks = (n + block_size - 1) / block_size;
+  blocks_.resize(num_blocks);
+  std::vector<std::vector<size_t>> neighbors(num_blocks);
+
+  for (size_t b = 0; b < num_blocks; ++b) {
+    Block &block = blocks_[b];
+    block.first_state = b * block_size;
+    block.num_states = std::min(block_size, n - block.first_state);
+
+    size_t nb = block.num_states;
+    size_t num_cols = (has_translations ? nb : 0) + d * nb;
+    block.columns.reserve(num_cols);
+    if (has_translations)
+      for (size_t k = 0; k < nb; ++k)
+        block.columns.push_back(block.first_state + k);
+    for (size_t k = 0; k < d * nb; ++k)
+      block.columns.push_back(rot_offset + d * block.first_state + k);
+
+    // Returns the index of column j within this block (or num_cols, if column
+    // j does not belong to this block)
+    auto local_index = [&](size_t j) {
+      size_t i = state(j);
+      if (i < block.first_state || i >= block.first_state + nb)
+        return num_cols;
+      return (j < rot_offset
+                  ? j - block.first_state
+                  : (has_translations ? nb : 0) + j - rot_offset -
+                        d * block.first_state);
+    };
+
+    // Extract the rows of M corresponding to this block, together with its
+    // principal submatrix, and record the blocks adjacent to this one
+    std::vector<Eigen::Triplet<Scalar>> row_triplets, diagonal_triplets;
+    for (size_t a = 0; a < num_cols; ++a)
+      for (SparseMatrix::InnerIterator it(M, block.columns[a]); it; ++it) {
+        size_t j = it.col();
+        row_triplets.emplace_back(a, j, it.value());
+
+        size_t c = local_index(j);
+        if (c < num_cols)
+          diagonal_triplets.emplace_back(a, c, it.value());
+        else
+          neighbors[b].push_back(state(j) / block_size);
+      }
+
+    block.rows.resize(num_cols, M.cols());
+    block.rows.setFromTriplets(row_triplets.begin(), row_triplets.end());
+    block.diagonal.resize(num_cols, num_cols);
+    block.diagonal.setFromTriplets(diagonal_triplets.begin(),
+                                   diagonal_triplets.end());
+
+    std::sort(neighbors[b].begin(), neighbors[b].end());
+    neighbors[b].erase(std::unique(neighbors[b].begin(), neighbors[b].end()),
+                       neighbors[b].end());
+  }
+
+  /// Greedily color the block graph
+
+  std::vector<size_t> color(num_blocks);
+  for (size_t b = 0; b < num_blocks; ++b) {
+    // Find the smallest color not used by any previously-colored neighbor
+    std::vector<bool> used(neighbors[b].size() + 1, false);
+    for (size_t c : neighbors[b])
+      if (c < b && color[c] < used.size())
+        used[color[c]] = true;
+    color[b] = std::find(used.begin(), used.end(), false) - used.begin();
+
+    if (color[b] >= colors_.size())
+      colors_.resize(color[b] + 1);
+    colors_[color[b]].push_back(b);
+  }
+}
+
+Optimization::Riemannian::TNTResult<Matrix, Scalar> optimize_quadratic_block(
+    const SparseMatrix &D, const Matrix &C, const Matrix &X0, size_t d,
+    size_t num_states, bool has_translations,
+    const Optimization::Riemannian::TNTParams<Scalar> &params) {
+  size_t r = X0.rows();
+  size_t nb = num_states;
+  size_t rot_offset = (has_translations ? nb : 0);
+  StiefelProduct SP(d, r, nb);
+
+  auto rotations = [rot_offset, d, nb](Matrix &V) {
+    return V.block(0, rot_offset, V.rows(), d * nb);
+  };
+
+  auto tangent_space_projection = [&](const Matrix &X, const Matrix &V) {
+    Matrix P = V;
+    rotations(P) = SP.Proj(X.middleCols(rot_offset, d * nb),
+                           V.middleCols(rot_offset, d * nb));
+    return P;
+  };
+
+  Optimization::Objective<Matrix, Scalar, Matrix> F =
+      [&](const Matrix &X, const Matrix &NablaF_X) {
+        return (X * D * X.transpose()).trace() +
+               2 * X.cwiseProduct(C).sum();
+      };
+
+  Optimization::Riemannian::QuadraticModel<Matrix, Matrix, Matrix> QM =
+      [&](const Matrix &X, Matrix &grad,
+          Optimization::Riemannian::LinearOperator<Matrix, Matrix, Matrix>
+              &HessOp,
+          Matrix &NablaF_X) {
+        NablaF_X = 2 * (X * D + C);
+        grad = tangent_space_projection(X, NablaF_X);
+
+        HessOp = [&](const Matrix &X, const Matrix &Xdot,
+                     const Matrix &NablaF_X) {
+          Matrix H = 2 * Xdot * D;
+          rotations(H) -= SP.SymBlockDiagProduct(
+              Xdot.middleCols(rot_offset, d * nb),
+              X.middleCols(rot_offset, d * nb),
+              NablaF_X.middleCols(rot_offset, d * nb));
+          return tangent_space_projection(X, H);
+        };
+      };
+
+  Optimization::Riemannian::RiemannianMetric<Matrix, Matrix, Scalar, Matrix>
+      metric = [](const Matrix &X, const Matrix &V1, const Matrix &V2,
+                  const Matrix &NablaF_X) {
+        return (V1 * V2.transpose()).trace();
+      };
+
+  Optimization::Riemannian::Retraction<Matrix, Matrix, Matrix> retraction =
+      [&](const Matrix &X, const Matrix &Xdot, const Matrix &NablaF_X) {
+        Matrix Xplus = X + Xdot;
+        rotations(Xplus) = SP.retract(X.middleCols(rot_offset, d * nb),
+                                      Xdot.middleCols(rot_offset, d * nb));
+        return Xplus;
+      };
+
+  Matrix NablaF_X;
+  return Optimization::Riemannian::TNT<Matrix, Matrix, Scalar, Matrix>(
+      F, QM, metric, retraction, X0, NablaF_X, std::nullopt, params);
+}
+
+size_t BlockCoordinateDescent::optimize_block(
+    const Block &block, Matrix &Y,
+    const Optimization::Riemannian::TNTParams<Scalar> &params) const {
+  Matrix X(Y.rows(), block.columns.size());
+  for (size_t a = 0; a < block.columns.size(); ++a)
+    X.col(a) = Y.col(block.columns[a]);
+
+  // With the states outside this block held fixed, the objective restricted to
+  // this block is (up to a constant) f(X) = tr(X D X^T) + 2 tr(X C^T), where D
+  // is the principal submatrix of M corresponding to this block, and
+  // C = Y M(:, block) - X D is the coupling with the remaining states
+  Matrix C = Y * block.rows.transpose() - X * block.diagonal;
+
+  Optimization::Riemannian::TNTResult<Matrix, Scalar> result =
+      optimize_quadratic_block(
+          block.diagonal, C, X, problem_.dimension(), block.num_states,
+          problem_.formulation() == Formulation::Explicit, params);
+
+  for (size_t a = 0; a < block.columns.size(); ++a)
+    Y.col(block.columns[a]) = result.x.col(a);
+
+  return result.objective_values.size();
+}
+
+Optimization::Riemannian::TNTResult<Matrix, Scalar>
+BlockCoordinateDescent::optimize(
+    const Matrix &Y0, const Optimization::Riemannian::TNTParams<Scalar> &params,
+    size_t local_iterations,
+    const std::optional<SESyncTNTUserFunction> &user_function) const {
+  auto start_time = Stopwatch::tick();
+
+  // Parameters for the local trust-region solves
+  Optimization::Riemannian::TNTParams<Scalar> local_params = params;
+  local_params.max_iterations = local_iterations;
+  local_params.log_iterates = false;
+  local_params.verbose = false;
+
+  Optimization::Riemannian::TNTResult<Matrix, Scalar> result;
+  result.x = Y0;
+  Matrix &Y = result.x;
+
+  Matrix NablaF_Y = problem_.Euclidean_gradient(Y);
+  Matrix grad = problem_.Riemannian_gradient(Y, NablaF_Y);
+  result.f = problem_.evaluate_objective(Y);
+  result.grad_f_x_norm = grad.norm();
+
+  if (params.verbose)
+    std::cout << "Block-coordinate descent: " << blocks_.size()
+              << " blocks, " << colors_.size()
+              << " colors; initial objective value: " << result.f
+              << ", gradient norm: " << result.grad_f_x_norm << std::endl;
+
+  for (size_t k = 0;; ++k) {
+    result.elapsed_time = Stopwatch::tock(start_time);
+
+    /// Test stopping criteria
+    if (result.grad_f_x_norm < params.gradient_tolerance) {
+      result.status = Optimization::Riemannian::TNTStatus::Gradient;
+      break;
+    }
+    if (k >= params.max_iterations) {
+      result.status = Optimization::Riemannian::TNTStatus::IterationLimit;
+      break;
+    }
+    if (result.elapsed_time >= params.max_computation_time) {
+      result.status = Optimization::Riemannian::TNTStatus::ElapsedTime;
+      break;
+    }
+
+    /// Sweep: optimize the blocks of each color concurrently
+    Matrix Y_prev = Y;
+    size_t num_local_iterations = 0;
+    for (const std::vector<size_t> &blocks : colors_) {
+#pragma omp parallel for schedule(dynamic) reduction(+ : num_local_iterations)
+      for (size_t c = 0; c < blocks.size(); ++c)
+        num_local_iterations += optimize_block(blocks_[blocks[c]], Y,
+                                               local_params);
+    }
+
+    Scalar f_prev = result.f;
+    Scalar f = problem_.evaluate_objective(Y);
+    Scalar df = f_prev - f;
+
+    // Each local solve starts from the current estimate of its block, so a
+    // sweep can only increase the objective if the local solves failed (e.g.
+    // due to numerical difficulties); in that case, reject the sweep and stop
+    if (df < 0) {
+      if (params.verbose)
+        std::cout << "Sweep " << k << " increased the objective value (df = "
+                  << df << "); rejecting it and terminating" << std::endl;
+      Y = Y_prev;
+      result.elapsed_time = Stopwatch::tock(start_time);
+      result.status = Optimization::Riemannian::TNTStatus::Stepsize;
+      break;
+    }
+
+    NablaF_Y = problem_.Euclidean_gradient(Y);
+    grad = problem_.Riemannian_gradient(Y, NablaF_Y);
+    result.f = f;
+    result.grad_f_x_norm = grad.norm();
+    Matrix h = Y - Y_prev;
+    double t = Stopwatch::tock(start_time);
+
+    /// Record output.  (Block-coordinate descent has no preconditioner, trust
+    /// region or gain ratio, so the corresponding statistics are left empty.)
+    result.objective_values.push_back(result.f);
+    result.time.push_back(t);
+    result.gradient_norms.push_back(result.grad_f_x_norm);
+    result.inner_iterations.push_back(num_local_iterations);
+    result.update_step_norms.push_back(h.norm());
+    if (params.log_iterates)
+      result.iterates.push_back(Y);
+
+    if (params.verbose)
+      std::cout << "Sweep " << k << ": f = " << result.f
+                << ", |grad f| = " << result.grad_f_x_norm << ", df = " << df
+                << ", local iterations: " << num_local_iterations
+                << ", elapsed time: " << t << std::endl;
+
+    if (user_function) {
+      Optimization::Riemannian::LinearOperator<Matrix, Matrix, Matrix> HessOp =
+          [this](const Matrix &Y, const Matrix &Ydot, const Matrix &NablaF_Y) {
+            return problem_.Riemannian_Hessian_vector_product(Y, NablaF_Y,
+                                                              Ydot);
+          };
+      // There is no trust-region radius or gain ratio to report
+      Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
+      if ((*user_function)(t, Y, result.f, grad, HessOp, NaN,
+                           num_local_iterations, h, df, NaN, true, NablaF_Y)) {
+        result.elapsed_time = Stopwatch::tock(start_time);
+        result.status = Optimization::Riemannian::TNTStatus::UserFunction;
+        break;
+      }
+    }
+
+    if (df / (std::fabs(f_prev) + 1e-12) < params.relative_decrease_tolerance) {
+      result.elapsed_time = Stopwatch::tock(start_time);
+      result.status = Optimization::Riemannian::TNTStatus::RelativeDecrease;
+      break;
+    }
+  }
+
+  result.preconditioned_grad_f_x_norm =
+      std::numeric_limits<Scalar>::quiet_NaN();
+  return result;
+}
+
+} // namespace SESync
@@ -0,0 +1,64 @@
+#include "SESync/ComplexStiefelProduct.h"
+
+namespace SESync {
+
+ComplexMatrix ComplexStiefelProduct::project(const ComplexMatrix &A) const {
+
+  ComplexMatrix P(p_, n_);
+
+#pragma omp parallel for
+  for (size_t i = 0; i < n_; ++i) {
+    Scalar nrm = A.col(i).norm();
+
+    // The projection of a nonzero vector onto the unit sphere is simply its
+    // normalization; we map the (measure-zero) set of zero vectors to the
+    // first standard basis vector
+    if (nrm > 0)
+      P.col(i) = A.col(i) / nrm;
+    else {
+      P.col(i).setZero();
+      P(0, i) = 1;
+    }
+  }
+  return P;
+}
+
+ComplexMatrix
+ComplexStiefelProduct::SymBlockDiagProduct(const ComplexMatrix &A,
+                                           const ComplexMatrix &B,
+                                           const ComplexMatrix &C) const {
+  // Preallocate result matrix
+  ComplexMatrix R(p_, n_);
+
+#pragma omp parallel for
+  for (size_t i = 0; i < n_; ++i)
+    // Compute the (real part of) the block product Bi^H * Ci, and scale Ai by
+    // this value
+    R.col(i) = A.col(i) * B.col(i).dot(C.col(i)).real();
+
+  return R;
+}
+
+ComplexMatrix ComplexStiefelProduct::retract(const ComplexMatrix &Y,
+                                             const ComplexMatrix &V) const {
+
+  // We use projection-based retraction, as described in "Projection-Like
+  // Retractions on Matrix Manifolds" by Absil and Malick
+
+  return project(Y + V);
+}
+
+ComplexMatrix ComplexStiefelProduct::random_sample(
+    const std::default_random_engine::result_type &seed) const {
+  // Generate a matrix of the appropriate dimension by sampling the real and
+  // imaginary parts of its elements from the standard Gaussian
+  std::default_random_engine generator(seed);
+  std::normal_distribution<Scalar> g;
+
+  ComplexMatrix R(p_, n_);
+  for (size_t r = 0; r < p_; ++r)
+    for (size_t c = 0; c < n_; ++c)
+      R(r, c) = ComplexScalar(g(generator), g(generator));
+  return project(R);
+}
+} // namespace SESync
@@ -0,0 +1,44 @@
+#include <algorithm>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/IncrementalSESync.h"
+
+namespace SESync {
+
+const SESyncResult &
+IncrementalSESync::update(const measurements_t &measurements) {
+  Matrix Y0;
+
+  auto problem_update_start_time = Stopwatch::tick();
+  if (!problem_) {
+    problem_.reset(new SESyncProblem(
+        measurements, options_.formulation, options_.projection_factorization,
+        options_.preconditioner,
+        options_.reg_Cholesky_precon_max_condition_number));
+    factorizations_updated_ = false;
+  } else {
+    size_t num_states = problem_->num_states();
+    factorizations_updated_ = problem_->add_measurements(measurements);
+
+    // Warm-start from the previous solution (if one is available)
+    if (result_.Yopt.size() != 0)
+      Y0 = problem_->extend_iterate(result_.Yopt, num_states);
+  }
+  problem_update_time_ = Stopwatch::tock(problem_update_start_time);
+
+  // Resume the Riemannian Staircase at the rank of the previous solution
+  SESyncOpts options = options_;
+  if (Y0.size() != 0) {
+    options.r0 = Y0.rows();
+    options.rmax = std::max(options.rmax, options.r0);
+  }
+
+  auto solve_start_time = Stopwatch::tick();
+  result_ = SESync(*problem_, options, Y0);
+  solve_time_ = Stopwatch::tock(solve_start_time);
+
+  return result_;
+}
+
+} // namespace SESync
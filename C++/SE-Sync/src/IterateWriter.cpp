@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "SESync/IterateWriter.h"
+
+namespace SESync {
+
+IterateWriter::IterateWriter(const std::string &filename,
+                             bool single_precision, size_t max_queue_size)
+    : filename_(filename),
+      file_(filename, std::ios::binary | std::ios::trunc),
+      single_precision_(single_precision),
+      max_queue_size_(std::max<size_t>(max_queue_size, 1)) {
+  if (!file_)
+    throw std::invalid_argument("Unable to open iterate log file " + filename);
+
+  // Write header
+  file_.write("SESYNCIT", 8);
+  uint64_t scalar_size = single_precision_ ? sizeof(float) : sizeof(Scalar);
+  file_.write(reinterpret_cast<const char *>(&scalar_size),
+              sizeof(scalar_size));
+
+  writer_ = std::thread(&IterateWriter::run, this);
+}
+
+IterateWriter::~IterateWriter() { stop(); }
+
+void IterateWriter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+  }
+  not_empty_.notify_one();
+  if (writer_.joinable())
+    writer_.join();
+}
+
+void IterateWriter::close() {
+  stop();
+  if (failed_)
+    throw std::runtime_error("Error writing iterate log file " + filename_);
+}
+
+void IterateWriter::write(size_t level, size_t iteration, double time,
+                          Scalar objective_value, const Matrix &Y) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_full_.wait(lock, [this]() { return queue_.size() < max_queue_size_; });
+  if (failed_)
+    throw std::runtime_error("Error writing iterate log file " + filename_);
+  queue_.push_back({level, iteration, time, objective_value, Y});
+  lock.unlock();
+  not_empty_.notify_one();
+}
+
+void IterateWriter::run() {
+  // Buffer used to convert iterates to single precision
+  Eigen::MatrixXf Yf;
+
+  while (true) {
+    Record record;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this]() { return closing_ || !queue_.empty(); });
+      if (queue_.empty())
+        break; // closing_ is true, and all records have been written
+      record = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    not_full_.notify_one();
+
+    uint64_t fields[4] = {record.level, record.iteration,
+                          static_cast<uint64_t>(record.Y.rows()),
+                          static_cast<uint64_t>(record.Y.cols())};
+    double values[2] = {record.time, record.objective_value};
+    file_.write(reinterpret_cast<const char *>(fields), sizeof(fields));
+    file_.write(reinterpret_cast<const char *>(values), sizeof(values));
+
+    if (single_precision_) {
+      Yf = record.Y.cast<float>();
+      file_.write(reinterpret_cast<const char *>(Yf.data()),
+                  Yf.size() * sizeof(float));
+    } else
+      file_.write(reinterpret_cast<const char *>(record.Y.data()),
+                  record.Y.size() * sizeof(Scalar));
+
+    if (!file_) {
+      // Record the failure, and discard any pending iterates (waking a solver
+      // blocked in write(), which will then report the failure)
+      std::lock_guard<std::mutex> lock(mutex_);
+      failed_ = true;
+      queue_.clear();
+      break;
+    }
+  }
+
+  if (!failed_ && !file_.flush()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    failed_ = true;
+  }
+  not_full_.notify_all();
+}
+
+} // namespace SESync
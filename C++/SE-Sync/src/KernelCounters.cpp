@@ -0,0 +1,79 @@
+#include "SESync/KernelCounters.h"
+
+namespace SESync {
+
+namespace {
+
+#if defined(SESYNC_KERNEL_COUNTERS)
+/** The cumulative kernel profile of each thread */
+thread_local KernelProfile thread_profile;
+
+/** The innermost active kernel scope of each thread */
+thread_local KernelScope *current_scope = nullptr;
+#endif
+
+} // namespace
+
+const char *kernel_name(Kernel kernel) {
+  switch (kernel) {
+  case Kernel::QProduct:
+    return "Q_product";
+  case Kernel::PiProduct:
+    return "Pi_product";
+  case Kernel::PreconditionerSolve:
+    return "preconditioner_solve";
+  case Kernel::SymBlockDiagProduct:
+    return "SymBlockDiagProduct";
+  case Kernel::Project:
+    return "project";
+  case Kernel::LOBPCGOperator:
+    return "LOBPCG_operator";
+  }
+  return "";
+}
+
+KernelProfile kernel_profile() {
+#if defined(SESYNC_KERNEL_COUNTERS)
+  return thread_profile;
+#else
+  return KernelProfile();
+#endif
+}
+
+KernelProfile kernel_profile_between(const KernelProfile &start,
+                                     const KernelProfile &end) {
+  KernelProfile profile;
+  for (size_t k = 0; k < NumKernels; ++k) {
+    profile[k].calls = end[k].calls - start[k].calls;
+    profile[k].flops = end[k].flops - start[k].flops;
+    profile[k].bytes = end[k].bytes - start[k].bytes;
+    profile[k].time = end[k].time - start[k].time;
+  }
+  return profile;
+}
+
+#if defined(SESYNC_KERNEL_COUNTERS)
+
+KernelScope::KernelScope(Kernel kernel, double flops, double bytes)
+    : kernel_(kernel), start_(std::chrono::high_resolution_clock::now()),
+      parent_(current_scope) {
+  KernelStats &stats = thread_profile[static_cast<size_t>(kernel_)];
+  stats.calls++;
+  stats.flops += flops;
+  stats.bytes += bytes;
+  current_scope = this;
+}
+
+KernelScope::~KernelScope() {
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::high_resolution_clock::now() - start_)
+                       .count();
+  thread_profile[static_cast<size_t>(kernel_)].time += elapsed - nested_time_;
+  if (parent_)
+    parent_->nested_time_ += elapsed;
+  current_scope = parent_;
+}
+
+#endif
+
+} // namespace SESync
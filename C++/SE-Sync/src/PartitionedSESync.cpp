@@ -0,0 +1,1108 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/BlockCoordinateDescent.h"
+#include "SESync/PartitionedSESync.h"
+#include "SESync/SESync_utils.h"
+#include "SESync/StiefelProduct.h"
+
+namespace SESync {
+
+namespace {
+
+/// TRANSPORT
+
+/** The types of messages exchanged between the coordinator and the workers */
+enum class MessageType : uint32_t {
+  /** Coordinator -> worker: the worker's subgraph and optimization parameters
+   */
+  Setup,
+
+  /** Coordinator -> worker: the worker's entire local iterate (its own states
+   * together with its boundary states) */
+  SetIterate,
+
+  /** Coordinator -> worker: updated values of the worker's boundary states */
+  UpdateBoundary,
+
+  /** Coordinator -> worker: optimize the worker's own states.  The reply
+   * contains the updated states and the number of trust-region iterations
+   * performed. */
+  Optimize,
+
+  /** Coordinator -> worker: evaluate the worker's contributions to the
+   * objective, the squared norm of the Riemannian gradient, and the trace of
+   * Lambda at the current iterate */
+  Evaluate,
+
+  /** Coordinator -> worker: compute the worker's rows of the certificate
+   * matrix S = M - Lambda at the current iterate */
+  Certificate,
+
+  /** Coordinator -> worker: exit */
+  Shutdown,
+
+  /** Worker -> coordinator: the reply to any request */
+  Reply,
+
+  /** Worker -> coordinator: the request failed (the payload contains the
+   * error message) */
+  Error
+};
+
+/** A buffer used to (de)serialize the payload of a message */
+class MessageBuffer {
+private:
+  std::vector<char> data_;
+  size_t position_ = 0;
+
+public:
+  std::vector<char> &data() { return data_; }
+  const std::vector<char> &data() const { return data_; }
+
+  template <typename T> void put(const T &x) {
+    const char *bytes = reinterpret_cast<const char *>(&x);
+    data_.insert(data_.end(), bytes, bytes + sizeof(T));
+  }
+
+  template <typename T> T get() {
+    if (position_ + sizeof(T) > data_.size())
+      throw std::runtime_error("Truncated message");
+    T x;
+    std::memcpy(&x, data_.data() + position_, sizeof(T));
+    position_ += sizeof(T);
+    return x;
+  }
+
+  void put_matrix(const Matrix &M) {
+    put<uint64_t>(M.rows());
+    put<uint64_t>(M.cols());
+    const char *bytes = reinterpret_cast<const char *>(M.data());
+    data_.insert(data_.end(), bytes, bytes + sizeof(Scalar) * M.size());
+  }
+
+  Matrix get_matrix() {
+    size_t rows = get<uint64_t>();
+    size_t cols = get<uint64_t>();
+    if (position_ + sizeof(Scalar) * rows * cols > data_.size())
+      throw std::runtime_error("Truncated message");
+    Matrix M(rows, cols);
+    std::memcpy(M.data(), data_.data() + position_,
+                sizeof(Scalar) * rows * cols);
+    position_ += sizeof(Scalar) * rows * cols;
+    return M;
+  }
+
+  void put_string(const std::string &s) {
+    put<uint64_t>(s.size());
+    data_.insert(data_.end(), s.begin(), s.end());
+  }
+
+  std::string get_string() {
+    size_t size = get<uint64_t>();
+    if (position_ + size > data_.size())
+      throw std::runtime_error("Truncated message");
+    std::string s(data_.data() + position_, size);
+    position_ += size;
+    return s;
+  }
+};
+
+/** Writes the given bytes to the socket, throwing on failure */
+void write_all(int socket, const char *bytes, size_t size) {
+  while (size > 0) {
+    ssize_t written = ::send(socket, bytes, size, MSG_NOSIGNAL);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      throw std::runtime_error("Failed to write to socket: " +
+                               std::string(std::strerror(errno)));
+    bytes += written;
+    size -= written;
+  }
+}
+
+/** Reads the given number of bytes from the socket.  Returns false if the
+ * connection was closed before any bytes were read, and throws if it was
+ * closed (or failed) after that. */
+bool read_all(int socket, char *bytes, size_t size) {
+  size_t total = 0;
+  while (total < size) {
+    ssize_t received = ::recv(socket, bytes + total, size - total, 0);
+    if (received < 0 && errno == EINTR)
+      continue;
+    if (received == 0 && total == 0)
+      return false;
+    if (received <= 0)
+      throw std::runtime_error("Failed to read from socket");
+    total += received;
+  }
+  return true;
+}
+
+/** Sends a message (a 4-byte type followed by an 8-byte payload length and the
+ * payload).  Returns the number of bytes sent. */
+size_t send_message(int socket, MessageType type,
+                    const MessageBuffer &payload = MessageBuffer()) {
+  char header[sizeof(uint32_t) + sizeof(uint64_t)];
+  uint32_t t = static_cast<uint32_t>(type);
+  uint64_t size = payload.data().size();
+  std::memcpy(header, &t, sizeof(t));
+  std::memcpy(header + sizeof(t), &size, sizeof(size));
+  write_all(socket, header, sizeof(header));
+  write_all(socket, payload.data().data(), size);
+  return sizeof(header) + size;
+}
+
+/** Receives a message.  Returns the number of bytes received (0 if the
+ * connection was closed). */
+size_t receive_message(int socket, MessageType &type, MessageBuffer &payload) {
+  char header[sizeof(uint32_t) + sizeof(uint64_t)];
+  if (!read_all(socket, header, sizeof(header)))
+    return 0;
+  uint32_t t;
+  uint64_t size;
+  std::memcpy(&t, header, sizeof(t));
+  std::memcpy(&size, header + sizeof(t), sizeof(size));
+  type = static_cast<MessageType>(t);
+  payload.data().resize(size);
+  if (size > 0 && !read_all(socket, payload.data().data(), size))
+    throw std::runtime_error("Connection closed while reading message");
+  return sizeof(header) + size;
+}
+
+/// LAYOUT
+
+/** Given the (global) indices of the states of a subgraph, returns the
+ * (global) indices of the columns of the iterate containing these states, in
+ * the order in which they appear in the subgraph's local iterate: the
+ * translations of these states (if any), followed by their rotations */
+std::vector<size_t> global_columns(const std::vector<size_t> &states, size_t n,
+                                   size_t d, bool has_translations) {
+  std::vector<size_t> columns;
+  columns.reserve((has_translations ? states.size() : 0) + d * states.size());
+  if (has_translations)
+    columns.insert(columns.end(), states.begin(), states.end());
+  size_t rot_offset = (has_translations ? n : 0);
+  for (size_t i : states)
+    for (size_t k = 0; k < d; ++k)
+      columns.push_back(rot_offset + d * i + k);
+  return columns;
+}
+
+/** Returns the local column indices of the first num_own states (if 'own' is
+ * true) or of the remaining states (otherwise) of a subgraph with num_local
+ * states */
+std::vector<size_t> local_columns(size_t num_own, size_t num_local, size_t d,
+                                  bool has_translations, bool own) {
+  size_t first = (own ? 0 : num_own);
+  size_t last = (own ? num_own : num_local);
+  std::vector<size_t> columns;
+  if (has_translations)
+    for (size_t i = first; i < last; ++i)
+      columns.push_back(i);
+  size_t rot_offset = (has_translations ? num_local : 0);
+  for (size_t k = d * first; k < d * last; ++k)
+    columns.push_back(rot_offset + k);
+  return columns;
+}
+
+/** Returns the submatrix of Y consisting of the given columns */
+Matrix extract_columns(const Matrix &Y, const std::vector<size_t> &columns) {
+  Matrix X(Y.rows(), columns.size());
+  for (size_t a = 0; a < columns.size(); ++a)
+    X.col(a) = Y.col(columns[a]);
+  return X;
+}
+
+/** Writes the columns of X into the given columns of Y */
+void insert_columns(Matrix &Y, const std::vector<size_t> &columns,
+                    const Matrix &X) {
+  for (size_t a = 0; a < columns.size(); ++a)
+    Y.col(columns[a]) = X.col(a);
+}
+
+/// WORKER
+
+/** The state of a worker process */
+struct Worker {
+  size_t d = 0;
+  bool has_translations = false;
+
+  /** Number of states owned by this worker, and total number of states
+   * (owned and boundary) in its subgraph */
+  size_t num_own = 0;
+  size_t num_local = 0;
+
+  /** Local indices of the columns containing the owned and boundary states */
+  std::vector<size_t> own_columns;
+  std::vector<size_t> boundary_columns;
+
+  /** Global index of each local column */
+  std::vector<size_t> global_columns;
+
+  /** The rows of the (local) data matrix corresponding to the owned states,
+   * and the corresponding principal submatrix */
+  SparseMatrix rows;
+  SparseMatrix diagonal;
+
+  /** Parameters for the local trust-region solves */
+  Optimization::Riemannian::TNTParams<Scalar> params;
+
+  /** The local iterate */
+  Matrix Y;
+
+  void setup(MessageBuffer &payload) {
+    has_translations = payload.get<uint8_t>();
+    d = payload.get<uint64_t>();
+    size_t n = payload.get<uint64_t>();
+    num_own = payload.get<uint64_t>();
+
+    num_local = payload.get<uint64_t>();
+    std::vector<size_t> states(num_local);
+    for (size_t &i : states)
+      i = payload.get<uint64_t>();
+
+    size_t num_measurements = payload.get<uint64_t>();
+    measurements_t measurements(num_measurements);
+    for (RelativePoseMeasurement &measurement : measurements) {
+      measurement.i = payload.get<uint64_t>();
+      measurement.j = payload.get<uint64_t>();
+      measurement.R = payload.get_matrix();
+      measurement.t = payload.get_matrix();
+      measurement.kappa = payload.get<Scalar>();
+      measurement.tau = payload.get<Scalar>();
+    }
+
+    params.gradient_tolerance = payload.get<Scalar>();
+    params.preconditioned_gradient_tolerance = payload.get<Scalar>();
+    params.relative_decrease_tolerance = payload.get<Scalar>();
+    params.stepsize_tolerance = payload.get<Scalar>();
+    params.max_iterations = payload.get<uint64_t>();
+    params.max_TPCG_iterations = payload.get<uint64_t>();
+    params.kappa_fgr = payload.get<Scalar>();
+    params.theta = payload.get<Scalar>();
+    params.verbose = false;
+    params.log_iterates = false;
+
+    own_columns = local_columns(num_own, num_local, d, has_translations, true);
+    boundary_columns =
+        local_columns(num_own, num_local, d, has_translations, false);
+    global_columns = SESync::global_columns(states, n, d, has_translations);
+
+    // Construct the local data matrix; the rows corresponding to the owned
+    // states are complete, since the subgraph contains every measurement
+    // incident to these states
+    SparseMatrix M =
+        (has_translations
+             ? construct_M_matrix(measurements)
+             : construct_rotational_connection_Laplacian(measurements));
+    if (static_cast<size_t>(M.rows()) != global_columns.size())
+      throw std::invalid_argument("Every state of a subgraph must appear in at "
+                                  "least one of its measurements");
+
+    std::vector<long> local_index(M.cols(), -1);
+    for (size_t a = 0; a < own_columns.size(); ++a)
+      local_index[own_columns[a]] = a;
+
+    std::vector<Eigen::Triplet<Scalar>> row_triplets, diagonal_triplets;
+    for (size_t a = 0; a < own_columns.size(); ++a)
+      for (SparseMatrix::InnerIterator it(M, own_columns[a]); it; ++it) {
+        row_triplets.emplace_back(a, it.col(), it.value());
+        if (local_index[it.col()] >= 0)
+          diagonal_triplets.emplace_back(a, local_index[it.col()], it.value());
+      }
+    rows.resize(own_columns.size(), M.cols());
+    rows.setFromTriplets(row_triplets.begin(), row_triplets.end());
+    diagonal.resize(own_columns.size(), own_columns.size());
+    diagonal.setFromTriplets(diagonal_triplets.begin(),
+                             diagonal_triplets.end());
+  }
+
+  /** Returns the product Y M(:, own), i.e. half of the Euclidean gradient with
+   * respect to the owned states */
+  Matrix half_gradient() const { return Y * rows.transpose(); }
+
+  void optimize(MessageBuffer &reply) {
+    Matrix X = extract_columns(Y, own_columns);
+    Matrix C = half_gradient() - X * diagonal;
+    Optimization::Riemannian::TNTResult<Matrix, Scalar> result =
+        optimize_quadratic_block(diagonal, C, X, d, num_own, has_translations,
+                                 params);
+    insert_columns(Y, own_columns, result.x);
+
+    reply.put_matrix(result.x);
+    reply.put<uint64_t>(result.objective_values.size());
+  }
+
+  void evaluate(MessageBuffer &reply) const {
+    Matrix X = extract_columns(Y, own_columns);
+    Matrix G = half_gradient();
+    size_t rot_offset = (has_translations ? num_own : 0);
+
+    Scalar f = X.cwiseProduct(G).sum();
+
+    Matrix grad = 2 * G;
+    StiefelProduct SP(d, Y.rows(), num_own);
+    grad.middleCols(rot_offset, d * num_own) =
+        SP.Proj(X.middleCols(rot_offset, d * num_own),
+                grad.middleCols(rot_offset, d * num_own));
+
+    // tr(Lambda_i) = tr(G_i^T X_i) for each owned state i
+    Scalar trLambda = X.middleCols(rot_offset, d * num_own)
+                          .cwiseProduct(G.middleCols(rot_offset, d * num_own))
+                          .sum();
+
+    reply.put<Scalar>(f);
+    reply.put<Scalar>(grad.squaredNorm());
+    reply.put<Scalar>(trLambda);
+  }
+
+  void certificate(MessageBuffer &reply) const {
+    Matrix X = extract_columns(Y, own_columns);
+    Matrix G = half_gradient();
+    size_t rot_offset = (has_translations ? num_own : 0);
+
+    std::vector<Eigen::Triplet<Scalar>> triplets;
+    triplets.reserve(rows.nonZeros() + d * d * num_own);
+
+    // Rows of M
+    for (size_t a = 0; a < own_columns.size(); ++a)
+      for (SparseMatrix::InnerIterator it(rows, a); it; ++it)
+        triplets.emplace_back(global_columns[own_columns[a]],
+                              global_columns[it.col()], it.value());
+
+    // Diagonal blocks Lambda_i = Sym(G_i^T X_i) of Lambda
+    for (size_t i = 0; i < num_own; ++i) {
+      size_t c = rot_offset + d * i;
+      Matrix P = G.middleCols(c, d).transpose() * X.middleCols(c, d);
+      Matrix Lambda_i = .5 * (P + P.transpose());
+      for (size_t k = 0; k < d; ++k)
+        for (size_t l = 0; l < d; ++l)
+          triplets.emplace_back(global_columns[own_columns[c + k]],
+                                global_columns[own_columns[c + l]],
+                                -Lambda_i(k, l));
+    }
+
+    reply.put<uint64_t>(triplets.size());
+    for (const Eigen::Triplet<Scalar> &triplet : triplets) {
+      reply.put<uint64_t>(triplet.row());
+      reply.put<uint64_t>(triplet.col());
+      reply.put<Scalar>(triplet.value());
+    }
+  }
+};
+
+/// COORDINATOR
+
+/** The coordinator's connections to the workers.  On destruction, any workers
+ * that are still running are shut down, and locally launched workers are
+ * reaped. */
+class WorkerPool {
+private:
+  std::vector<int> sockets_;
+  std::vector<pid_t> pids_;
+  bool owns_sockets_;
+
+  /** Returns the number of threads of the calling process (or 0 if this
+   * cannot be determined) */
+  static size_t num_threads() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+      if (line.compare(0, 8, "Threads:") == 0)
+        return std::stoul(line.substr(8));
+    return 0;
+  }
+
+  /** Launches a single worker, connected by a Unix domain socket pair */
+  void launch(const std::string &worker_executable) {
+    int sv[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+      throw std::runtime_error("Failed to create socket pair: " +
+                               std::string(std::strerror(errno)));
+
+    // Only async-signal-safe functions may be called in the child of a
+    // (possibly multithreaded) process before exec, so the arguments are
+    // prepared beforehand
+    std::string flag = "--partitioned-worker";
+    std::string socket_arg = std::to_string(sv[1]);
+    char *argv[] = {const_cast<char *>(worker_executable.c_str()),
+                    const_cast<char *>(flag.c_str()),
+                    const_cast<char *>(socket_arg.c_str()), nullptr};
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+      ::close(sv[0]);
+      ::close(sv[1]);
+      throw std::runtime_error("Failed to launch worker process: " +
+                               std::string(std::strerror(errno)));
+    }
+
+    if (pid == 0) {
+      // Worker process: release the coordinator's ends of the sockets
+      ::close(sv[0]);
+      for (int socket : sockets_)
+        ::close(socket);
+
+      if (!worker_executable.empty()) {
+        ::execv(argv[0], argv);
+        ::_exit(127);
+      }
+
+      int status = 0;
+      try {
+        run_partitioned_worker(sv[1]);
+      } catch (...) {
+        status = 1;
+      }
+      ::close(sv[1]);
+      ::_exit(status);
+    }
+
+    ::close(sv[1]);
+    sockets_.push_back(sv[0]);
+    pids_.push_back(pid);
+  }
+
+  /** Shuts down the workers, and reaps those that were launched locally */
+  void shutdown() {
+    for (int socket : sockets_) {
+      try {
+        send_message(socket, MessageType::Shutdown);
+      } catch (...) {
+      }
+      if (owns_sockets_)
+        ::close(socket);
+    }
+    for (pid_t pid : pids_)
+      ::waitpid(pid, nullptr, 0);
+    sockets_.clear();
+    pids_.clear();
+  }
+
+public:
+  size_t bytes_sent = 0;
+  size_t bytes_received = 0;
+
+  /** Connects to externally launched workers over the given sockets */
+  explicit WorkerPool(const std::vector<int> &sockets)
+      : sockets_(sockets), owns_sockets_(false) {}
+
+  /** Launches the given number of workers.  If 'worker_executable' is
+   * nonempty, each worker is started by forking and immediately executing it
+   * (cf. PartitionedSESyncOpts::worker_executable); otherwise, the worker runs
+   * directly in the forked child, which requires the calling process to be
+   * single-threaded. */
+  WorkerPool(size_t num_workers, const std::string &worker_executable)
+      : owns_sockets_(true) {
+    if (worker_executable.empty() && num_threads() > 1)
+      throw std::runtime_error(
+          "Workers can only be forked without a worker executable from a "
+          "single-threaded process (cf. "
+          "PartitionedSESyncOpts::worker_executable)");
+
+    try {
+      for (size_t p = 0; p < num_workers; ++p)
+        launch(worker_executable);
+    } catch (...) {
+      // Shut down (and reap) the workers that were already launched
+      shutdown();
+      throw;
+    }
+  }
+
+  ~WorkerPool() { shutdown(); }
+
+  size_t size() const { return sockets_.size(); }
+
+  void send(size_t p, MessageType type,
+            const MessageBuffer &payload = MessageBuffer()) {
+    bytes_sent += send_message(sockets_[p], type, payload);
+  }
+
+  /** Receives the reply to a request sent to worker p, throwing if the
+   * request failed */
+  MessageBuffer receive(size_t p) {
+    MessageType type;
+    MessageBuffer payload;
+    size_t bytes = receive_message(sockets_[p], type, payload);
+    if (bytes == 0)
+      throw std::runtime_error("Worker " + std::to_string(p) +
+                               " closed the connection");
+    bytes_received += bytes;
+    if (type == MessageType::Error)
+      throw std::runtime_error("Worker " + std::to_string(p) +
+                               " failed: " + payload.get_string());
+    return payload;
+  }
+};
+
+/** Computes an initial estimate X = [t | R] (or R) by composing the
+ * measurements along a breadth-first spanning tree of each connected component
+ * of the pose graph */
+Matrix spanning_tree_initialization(const measurements_t &measurements,
+                                    size_t n, size_t d,
+                                    bool has_translations) {
+  std::vector<std::vector<size_t>> incident(n);
+  for (size_t k = 0; k < measurements.size(); ++k) {
+    incident[measurements[k].i].push_back(k);
+    incident[measurements[k].j].push_back(k);
+  }
+
+  std::vector<Matrix> R(n);
+  std::vector<Vector> t(n);
+  for (size_t root = 0; root < n; ++root) {
+    if (R[root].size() != 0)
+      continue;
+    R[root] = Matrix::Identity(d, d);
+    t[root] = Vector::Zero(d);
+
+    std::queue<size_t> frontier;
+    frontier.push(root);
+    while (!frontier.empty()) {
+      size_t i = frontier.front();
+      frontier.pop();
+      for (size_t k : incident[i]) {
+        const RelativePoseMeasurement &measurement = measurements[k];
+        size_t j = (measurement.i == i ? measurement.j : measurement.i);
+        if (R[j].size() != 0)
+          continue;
+        if (measurement.i == i) {
+          // x_j = x_i * x_ij
+          R[j] = R[i] * measurement.R;
+          t[j] = t[i] + R[i] * measurement.t;
+        } else {
+          // x_j = x_i * x_ji^-1
+          R[j] = R[i] * measurement.R.transpose();
+          t[j] = t[i] - R[j] * measurement.t;
+        }
+        frontier.push(j);
+      }
+    }
+  }
+
+  size_t rot_offset = (has_translations ? n : 0);
+  Matrix X(d, rot_offset + d * n);
+  for (size_t i = 0; i < n; ++i) {
+    if (has_translations)
+      X.col(i) = t[i];
+    X.middleCols(rot_offset + d * i, d) = R[i];
+  }
+  return X;
+}
+
+} // namespace
+
+void run_partitioned_worker(int socket) {
+  Worker worker;
+  MessageType type;
+  MessageBuffer request;
+
+  while (receive_message(socket, type, request) > 0) {
+    if (type == MessageType::Shutdown)
+      return;
+
+    MessageBuffer reply;
+    try {
+      switch (type) {
+      case MessageType::Setup:
+        worker.setup(request);
+        break;
+      case MessageType::SetIterate:
+        worker.Y = request.get_matrix();
+        break;
+      case MessageType::UpdateBoundary:
+        insert_columns(worker.Y, worker.boundary_columns,
+                       request.get_matrix());
+        break;
+      case MessageType::Optimize:
+        worker.optimize(reply);
+        break;
+      case MessageType::Evaluate:
+        worker.evaluate(reply);
+        break;
+      case MessageType::Certificate:
+        worker.certificate(reply);
+        break;
+      default:
+        throw std::runtime_error("Unexpected message type");
+      }
+      send_message(socket, MessageType::Reply, reply);
+    } catch (const std::exception &e) {
+      MessageBuffer error;
+      error.put_string(e.what());
+      send_message(socket, MessageType::Error, error);
+    }
+
+    request = MessageBuffer();
+  }
+}
+
+bool run_partitioned_worker(int argc, char **argv) {
+  if (argc != 3 || std::string(argv[1]) != "--partitioned-worker")
+    return false;
+
+  int socket = std::stoi(argv[2]);
+  run_partitioned_worker(socket);
+  ::close(socket);
+  return true;
+}
+
+PartitionedSESyncResult
+PartitionedSESync(const measurements_t &measurements, const SESyncOpts &options,
+                  const PartitionedSESyncOpts &partition_options) {
+  auto start_time = Stopwatch::tick();
+
+  if (options.formulation == Formulation::Simplified)
+    throw std::invalid_argument("The partitioned solver requires the Explicit "
+                                "or SOSync formulation");
+  if (measurements.empty())
+    throw std::invalid_argument("A problem must contain measurements");
+
+  size_t num_workers = (partition_options.worker_sockets.empty()
+                            ? partition_options.num_workers
+                            : partition_options.worker_sockets.size());
+  if (num_workers == 0)
+    throw std::invalid_argument("At least one worker is required");
+
+  bool has_translations = (options.formulation == Formulation::Explicit);
+  size_t d = measurements[0].R.rows();
+  size_t n = 0;
+  for (const RelativePoseMeasurement &measurement : measurements)
+    n = std::max(n, std::max(measurement.i, measurement.j) + 1);
+  if (num_workers > n)
+    throw std::invalid_argument("The number of workers cannot exceed the "
+                                "number of states");
+  size_t N = (has_translations ? n : 0) + d * n;
+
+  PartitionedSESyncResult partitioned_result;
+  SESyncResult &result = partitioned_result.result;
+  result.status = MaxRank;
+
+  /// PARTITION THE POSE GRAPH
+
+  // Worker p owns the states [first[p], first[p+1])
+  std::vector<size_t> first(num_workers + 1);
+  for (size_t p = 0; p <= num_workers; ++p)
+    first[p] = p * n / num_workers;
+  auto owner = [&](size_t i) {
+    return std::upper_bound(first.begin(), first.end(), i) - first.begin() - 1;
+  };
+
+  // The measurements incident to each worker's states, and the boundary
+  // states (owned by other workers) upon which each worker depends
+  std::vector<measurements_t> subgraphs(num_workers);
+  std::vector<std::vector<size_t>> boundaries(num_workers);
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    size_t p = owner(measurement.i);
+    size_t q = owner(measurement.j);
+    subgraphs[p].push_back(measurement);
+    if (q != p) {
+      subgraphs[q].push_back(measurement);
+      boundaries[p].push_back(measurement.j);
+      boundaries[q].push_back(measurement.i);
+    }
+  }
+
+  std::vector<std::vector<size_t>> states(num_workers);
+  std::vector<std::vector<size_t>> neighbors(num_workers);
+  for (size_t p = 0; p < num_workers; ++p) {
+    std::vector<size_t> &boundary = boundaries[p];
+    std::sort(boundary.begin(), boundary.end());
+    boundary.erase(std::unique(boundary.begin(), boundary.end()),
+                   boundary.end());
+
+    // The subgraph's local states are its own states, followed by its
+    // boundary states
+    for (size_t i = first[p]; i < first[p + 1]; ++i)
+      states[p].push_back(i);
+    states[p].insert(states[p].end(), boundary.begin(), boundary.end());
+
+    for (size_t i : boundary)
+      neighbors[p].push_back(owner(i));
+    std::sort(neighbors[p].begin(), neighbors[p].end());
+    neighbors[p].erase(std::unique(neighbors[p].begin(), neighbors[p].end()),
+                       neighbors[p].end());
+
+    partitioned_result.partition_sizes.push_back(first[p + 1] - first[p]);
+    partitioned_result.boundary_sizes.push_back(boundary.size());
+  }
+
+  // Greedily color the partition graph
+  std::vector<size_t> color(num_workers);
+  std::vector<std::vector<size_t>> colors;
+  for (size_t p = 0; p < num_workers; ++p) {
+    std::vector<bool> used(neighbors[p].size() + 1, false);
+    for (size_t q : neighbors[p])
+      if (q < p && color[q] < used.size())
+        used[color[q]] = true;
+    color[p] = std::find(used.begin(), used.end(), false) - used.begin();
+    if (color[p] >= colors.size())
+      colors.resize(color[p] + 1);
+    colors[color[p]].push_back(p);
+  }
+  partitioned_result.num_colors = colors.size();
+
+  // Global indices of the columns of each worker's local iterate, and of its
+  // own and boundary columns
+  std::vector<std::vector<size_t>> columns(num_workers);
+  std::vector<std::vector<size_t>> own_columns(num_workers);
+  std::vector<std::vector<size_t>> boundary_columns(num_workers);
+  for (size_t p = 0; p < num_workers; ++p) {
+    columns[p] = global_columns(states[p], n, d, has_translations);
+    size_t num_own = first[p + 1] - first[p];
+    for (size_t a : local_columns(num_own, states[p].size(), d,
+                                  has_translations, true))
+      own_columns[p].push_back(columns[p][a]);
+    for (size_t a : local_columns(num_own, states[p].size(), d,
+                                  has_translations, false))
+      boundary_columns[p].push_back(columns[p][a]);
+  }
+
+  if (options.verbose) {
+    std::cout << "Partitioned " << n << " states among " << num_workers
+              << " workers (" << colors.size() << " colors)" << std::endl;
+    for (size_t p = 0; p < num_workers; ++p)
+      std::cout << " Worker " << p << ": "
+                << partitioned_result.partition_sizes[p] << " states, "
+                << partitioned_result.boundary_sizes[p] << " boundary states, "
+                << subgraphs[p].size() << " measurements" << std::endl;
+  }
+
+  /// LAUNCH AND SET UP THE WORKERS
+
+  std::unique_ptr<WorkerPool> pool(
+      partition_options.worker_sockets.empty()
+          ? new WorkerPool(num_workers, partition_options.worker_executable)
+          : new WorkerPool(partition_options.worker_sockets));
+
+  for (size_t p = 0; p < num_workers; ++p) {
+    // Re-index the subgraph's measurements in terms of its local states
+    auto local_index = [&](size_t i) {
+      if (i >= first[p] && i < first[p + 1])
+        return i - first[p];
+      return (first[p + 1] - first[p]) +
+             (std::lower_bound(boundaries[p].begin(), boundaries[p].end(), i) -
+              boundaries[p].begin());
+    };
+
+    MessageBuffer setup;
+    setup.put<uint8_t>(has_translations);
+    setup.put<uint64_t>(d);
+    setup.put<uint64_t>(n);
+    setup.put<uint64_t>(first[p + 1] - first[p]);
+    setup.put<uint64_t>(states[p].size());
+    for (size_t i : states[p])
+      setup.put<uint64_t>(i);
+    setup.put<uint64_t>(subgraphs[p].size());
+    for (const RelativePoseMeasurement &measurement : subgraphs[p]) {
+      setup.put<uint64_t>(local_index(measurement.i));
+      setup.put<uint64_t>(local_index(measurement.j));
+      setup.put_matrix(measurement.R);
+      setup.put_matrix(measurement.t);
+      setup.put<Scalar>(measurement.kappa);
+      setup.put<Scalar>(measurement.tau);
+    }
+    setup.put<Scalar>(options.grad_norm_tol);
+    setup.put<Scalar>(options.preconditioned_grad_norm_tol);
+    setup.put<Scalar>(options.rel_func_decrease_tol);
+    setup.put<Scalar>(options.stepsize_tol);
+    setup.put<uint64_t>(partition_options.local_iterations);
+    setup.put<uint64_t>(options.max_tCG_iterations);
+    setup.put<Scalar>(options.STPCG_kappa);
+    setup.put<Scalar>(options.STPCG_theta);
+
+    pool->send(p, MessageType::Setup, setup);
+    subgraphs[p].clear();
+  }
+  for (size_t p = 0; p < num_workers; ++p)
+    pool->receive(p);
+
+  /// Communication primitives
+
+  // Sends the (entire) iterate Y to the workers
+  auto set_iterate = [&](const Matrix &Y) {
+    for (size_t p = 0; p < num_workers; ++p) {
+      MessageBuffer payload;
+      payload.put_matrix(extract_columns(Y, columns[p]));
+      pool->send(p, MessageType::SetIterate, payload);
+    }
+    for (size_t p = 0; p < num_workers; ++p)
+      pool->receive(p);
+  };
+
+  // Evaluates the objective F(Y), the norm of the Riemannian gradient, and
+  // tr(Lambda) at the workers' current iterate
+  Scalar gradnorm = 0, trLambda = 0;
+  auto evaluate = [&]() {
+    for (size_t p = 0; p < num_workers; ++p)
+      pool->send(p, MessageType::Evaluate);
+    Scalar f = 0, gradnorm_squared = 0;
+    trLambda = 0;
+    for (size_t p = 0; p < num_workers; ++p) {
+      MessageBuffer reply = pool->receive(p);
+      f += reply.get<Scalar>();
+      gradnorm_squared += reply.get<Scalar>();
+      trLambda += reply.get<Scalar>();
+    }
+    gradnorm = std::sqrt(gradnorm_squared);
+    return f;
+  };
+
+  // For each color, the workers that depend upon the states of some worker of
+  // that color
+  std::vector<std::vector<size_t>> dependents(colors.size());
+  for (size_t p = 0; p < num_workers; ++p)
+    for (size_t q : neighbors[p])
+      dependents[color[q]].push_back(p);
+  for (std::vector<size_t> &workers : dependents) {
+    std::sort(workers.begin(), workers.end());
+    workers.erase(std::unique(workers.begin(), workers.end()), workers.end());
+  }
+
+  // Performs one sweep of block-coordinate descent, updating Y; returns the
+  // total number of local trust-region iterations performed
+  auto sweep = [&](Matrix &Y) {
+    size_t num_local_iterations = 0;
+    for (size_t c = 0; c < colors.size(); ++c) {
+      for (size_t p : colors[c])
+        pool->send(p, MessageType::Optimize);
+      for (size_t p : colors[c]) {
+        MessageBuffer reply = pool->receive(p);
+        insert_columns(Y, own_columns[p], reply.get_matrix());
+        num_local_iterations += reply.get<uint64_t>();
+      }
+
+      // Forward the updated states to the workers that depend upon them
+      for (size_t p : dependents[c]) {
+        MessageBuffer payload;
+        payload.put_matrix(extract_columns(Y, boundary_columns[p]));
+        pool->send(p, MessageType::UpdateBoundary, payload);
+      }
+      for (size_t p : dependents[c])
+        pool->receive(p);
+    }
+    return num_local_iterations;
+  };
+
+  /// INITIALIZATION
+
+  Matrix X0 = spanning_tree_initialization(measurements, n, d,
+                                           has_translations);
+  size_t r = std::max(options.r0, d);
+  Matrix Y = Matrix::Zero(r, N);
+  Y.topRows(d) = X0;
+
+  result.initialization_time = Stopwatch::tock(start_time);
+  if (options.verbose)
+    std::cout << "Spanning-tree initialization finished; elapsed time: "
+              << result.initialization_time << " seconds" << std::endl;
+
+  /// RIEMANNIAN STAIRCASE
+
+  size_t rot_offset = (has_translations ? n : 0);
+  set_iterate(Y);
+
+  while (true) {
+    if (Stopwatch::tock(start_time) >= options.max_computation_time) {
+      result.status = ElapsedTime;
+      break;
+    }
+
+    if (options.verbose)
+      std::cout << std::endl
+                << "====== RIEMANNIAN STAIRCASE (level r = " << r
+                << ") ======" << std::endl;
+
+    auto level_start_time = Stopwatch::tick();
+    Scalar f = evaluate();
+    std::vector<Scalar> function_values = {f};
+    std::vector<Scalar> gradient_norms = {gradnorm};
+    std::vector<size_t> inner_iterations;
+    std::vector<double> elapsed_times = {0};
+
+    bool out_of_time = false;
+    for (size_t k = 0;
+         k < options.max_iterations && gradnorm >= options.grad_norm_tol; ++k) {
+      if (Stopwatch::tock(start_time) >= options.max_computation_time) {
+        out_of_time = true;
+        break;
+      }
+
+      size_t num_local_iterations = sweep(Y);
+      ++partitioned_result.num_sweeps;
+
+      Scalar f_prev = f;
+      f = evaluate();
+      function_values.push_back(f);
+      gradient_norms.push_back(gradnorm);
+      inner_iterations.push_back(num_local_iterations);
+      elapsed_times.push_back(Stopwatch::tock(level_start_time));
+
+      if (options.verbose)
+        std::cout << "Sweep " << k << ": f = " << f
+                  << ", |grad f| = " << gradnorm
+                  << ", local iterations: " << num_local_iterations
+                  << std::endl;
+
+      if ((f_prev - f) / (std::fabs(f_prev) + 1e-12) <
+          options.rel_func_decrease_tol)
+        break;
+    }
+
+    result.Yopt = Y;
+    result.SDPval = f;
+    result.gradnorm = gradnorm;
+    result.relaxation_ranks.push_back(r);
+    result.function_values.push_back(function_values);
+    result.gradient_norms.push_back(gradient_norms);
+    result.Hessian_vector_products.push_back(inner_iterations);
+    result.elapsed_optimization_times.push_back(elapsed_times);
+
+    if (out_of_time) {
+      result.status = ElapsedTime;
+      break;
+    }
+
+    /// Certify the solution using the assembled certificate matrix
+
+    auto verification_start_time = Stopwatch::tick();
+    for (size_t p = 0; p < num_workers; ++p)
+      pool->send(p, MessageType::Certificate);
+    std::vector<Eigen::Triplet<Scalar>> triplets;
+    for (size_t p = 0; p < num_workers; ++p) {
+      MessageBuffer reply = pool->receive(p);
+      size_t num_triplets = reply.get<uint64_t>();
+      triplets.reserve(triplets.size() + num_triplets);
+      for (size_t k = 0; k < num_triplets; ++k) {
+        size_t i = reply.get<uint64_t>();
+        size_t j = reply.get<uint64_t>();
+        triplets.emplace_back(i, j, reply.get<Scalar>());
+      }
+    }
+    SparseMatrix S(N, N);
+    S.setFromTriplets(triplets.begin(), triplets.end());
+    triplets.clear();
+    triplets.shrink_to_fit();
+
+    Scalar theta;
+    Vector v;
+    size_t num_LOBPCG_iters;
+    bool global_opt = fast_verification(
+        S, options.min_eig_num_tol, options.LOBPCG_block_size, theta, v,
+        num_LOBPCG_iters, options.LOBPCG_max_iterations,
+        options.LOBPCG_max_fill_factor, options.LOBPCG_drop_tol);
+    S.resize(0, 0);
+    double verification_time = Stopwatch::tock(verification_start_time);
+
+    result.escape_direction_curvatures.push_back(theta);
+    result.LOBPCG_iters.push_back(num_LOBPCG_iters);
+    result.verification_times.push_back(verification_time);
+
+    if (options.verbose)
+      std::cout << "Verification (" << num_LOBPCG_iters
+                << " LOBPCG iterations, " << verification_time
+                << " seconds): minimum eigenvalue estimate " << theta
+                << std::endl;
+
+    if (global_opt) {
+      result.status = GlobalOpt;
+      break;
+    }
+    if (theta >= -options.min_eig_num_tol / 2) {
+      result.status = EigImprecision;
+      break;
+    }
+    if (r >= options.rmax)
+      break; // MaxRank
+
+    /// Escape from the saddle point along Ydot = e_{r+1} v^T
+
+    Matrix Y_augmented = Matrix::Zero(r + 1, N);
+    Y_augmented.topRows(r) = Y;
+    Matrix Ydot = Matrix::Zero(r + 1, N);
+    Ydot.bottomRows(1) = v.transpose();
+    StiefelProduct SP(d, r + 1, n);
+
+    Scalar alpha_min = 1e-6;
+    Scalar alpha =
+        std::max(16 * alpha_min, 10 * options.grad_norm_tol / std::fabs(theta));
+    bool escaped = false;
+    for (; alpha >= alpha_min; alpha /= 2) {
+      Matrix Yplus = Y_augmented + alpha * Ydot;
+      Yplus.middleCols(rot_offset, d * n) =
+          SP.retract(Y_augmented.middleCols(rot_offset, d * n),
+                     alpha * Ydot.middleCols(rot_offset, d * n));
+      set_iterate(Yplus);
+      if (evaluate() < f) {
+        Y = Yplus;
+        escaped = true;
+        break;
+      }
+    }
+
+    if (!escaped) {
+      if (options.verbose)
+        std::cout << "WARNING!  BACKTRACKING LINE SEARCH FAILED TO ESCAPE FROM "
+                     "SADDLE POINT!"
+                  << std::endl;
+      result.status = SaddlePoint;
+      break;
+    }
+
+    result.escape_directions.push_back(1);
+    ++r;
+  }
+
+  /// POST-PROCESSING
+
+  result.xhat = round_solution(result.Yopt, d, rot_offset);
+
+  // Evaluate tr(Lambda) at Yopt, and the objective at xhat (whose layout
+  // coincides with that of a rank-d iterate)
+  set_iterate(result.Yopt);
+  evaluate();
+  result.trLambda = trLambda;
+  set_iterate(result.xhat);
+  result.Fxhat = evaluate();
+
+  result.duality_gap = result.SDPval - result.trLambda;
+  result.suboptimality_bound = result.Fxhat - result.trLambda;
+
+  partitioned_result.bytes_sent = pool->bytes_sent;
+  partitioned_result.bytes_received = pool->bytes_received;
+  pool.reset();
+
+  result.total_computation_time = Stopwatch::tock(start_time);
+
+  if (options.verbose)
+    std::cout << std::endl
+              << "Partitioned SE-Sync finished in "
+              << result.total_computation_time << " seconds: F(xhat) = "
+              << result.Fxhat << ", suboptimality bound "
+              << result.suboptimality_bound << " ("
+              << partitioned_result.bytes_sent +
+                     partitioned_result.bytes_received
+              << " bytes communicated)" << std::endl;
+
+  return partitioned_result;
+}
+
+} // namespace SESync
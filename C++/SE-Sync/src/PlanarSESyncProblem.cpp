@@ -0,0 +1,365 @@
+#include "SESync/PlanarSESyncProblem.h"
+#include "SESync/SESync_utils.h"
+
+#include <stdexcept>
+
+namespace SESync {
+
+PlanarSESyncProblem::PlanarSESyncProblem(const measurements_t &measurements,
+                                         const Formulation &formulation,
+                                         const Preconditioner &precon,
+                                         Scalar reg_chol_precon_max_cond)
+    : form_(formulation), measurements_(measurements), preconditioner_(precon),
+      reg_Chol_precon_max_cond_(reg_chol_precon_max_cond) {
+
+  if (!measurements.empty() && measurements[0].R.rows() != 2)
+    throw std::invalid_argument(
+        "Planar SE-Sync problems require planar (d = 2) measurements");
+
+  if (form_ == Formulation::Explicit)
+    throw std::invalid_argument("Planar SE-Sync problems support only the "
+                                "Simplified and SOSync formulations");
+
+  /// Construct oriented incidence matrix for the underlying pose graph
+  A_ = construct_oriented_incidence_matrix(measurements);
+
+  /// SET PROBLEM DIMENSIONS
+  n_ = A_.rows();
+  m_ = A_.cols();
+
+  /// Set dimensions of the product of complex Stiefel manifolds in which the
+  /// (generalized) rotational states lie
+  CSP_.set_n(n_);
+  CSP_.set_p(r_);
+
+  /// Construct data matrices
+
+  // Construct complex rotational connection Laplacian
+  LGrho_ = construct_complex_rotational_connection_Laplacian(measurements);
+
+  if (form_ == Formulation::Simplified) {
+    // The full data matrix M is needed to construct the certificate matrix
+    M_ = construct_complex_M_matrix(measurements);
+
+    // Construct square root of the (diagonal) matrix of translational
+    // measurement precisions
+    DiagonalMatrix SqrtOmega =
+        construct_translational_precision_matrix(measurements)
+            .diagonal()
+            .cwiseSqrt()
+            .asDiagonal();
+
+    // Construct Ared * SqrtOmega, and cache its transpose
+    Ared_SqrtOmega_ = A_.topRows(n_ - 1) * SqrtOmega;
+    SqrtOmega_AredT_ = Ared_SqrtOmega_.transpose();
+
+    // Construct complex translational data matrix T
+    ComplexSparseMatrix T =
+        construct_complex_translational_data_matrix(measurements);
+
+    SqrtOmega_T_ =
+        SqrtOmega.diagonal().cast<ComplexScalar>().asDiagonal() *
+        ComplexSparseMatrix(T.conjugate());
+    // Likewise, we also cache this adjoint
+    TT_SqrtOmega_ = SqrtOmega_T_.adjoint();
+
+    // Compute and cache the Cholesky factor L of Ared * Omega * Ared^T
+    L_.compute(Ared_SqrtOmega_ * SqrtOmega_AredT_);
+  }
+
+  /// PRECONDITIONER CONSTRUCTION
+
+  if (preconditioner_ == Preconditioner::Jacobi) {
+    // The diagonal of the (Hermitian) rotational connection Laplacian is real
+    Jacobi_precon_ = LGrho_.diagonal().real().cwiseInverse();
+  } else if (preconditioner_ == Preconditioner::RegularizedCholesky) {
+    /// We will construct and cache a Cholesky factorization of the regularized
+    /// data matrix P := D + lambda_reg * I, where D = LGrho for
+    /// SO-synchronization, and D = M for SE-synchronization
+    const ComplexSparseMatrix &D =
+        (form_ == Formulation::SOSync ? LGrho_ : M_);
+
+    // Bound the spectral norm of D using Gershgorin's theorem; for these
+    // (diagonally-dominant) Laplacian-type matrices this bound is within a
+    // small constant factor of ||D||_2, and is much cheaper to obtain than an
+    // iterative eigenvalue estimate
+    Scalar Dnorm = 0;
+    for (size_t k = 0; k < D.outerSize(); ++k) {
+      Scalar row_sum = 0;
+      for (ComplexSparseMatrix::InnerIterator it(D, k); it; ++it)
+        row_sum += std::abs(it.value());
+      Dnorm = std::max(Dnorm, row_sum);
+    }
+
+    // Compute the required value of the regularization parameter lambda_reg
+    Scalar lambda_reg = Dnorm / (reg_Chol_precon_max_cond_ - 1);
+
+    // Construct regularized data matrix P (in column-major format, as
+    // required by CHOLMOD for complex factorizations)
+    Eigen::SparseMatrix<ComplexScalar> P =
+        D + ComplexSparseMatrix(
+                ComplexVector::Constant(D.rows(), lambda_reg).asDiagonal());
+
+    // Compute and cache Cholesky factorization of P
+    reg_Chol_precon_.compute(P);
+  } // Preconditioner construction
+}
+
+void PlanarSESyncProblem::set_relaxation_rank(size_t rank) {
+  r_ = rank;
+  CSP_.set_p(r_);
+}
+
+ComplexMatrix
+PlanarSESyncProblem::data_matrix_product(const ComplexMatrix &X) const {
+  if (form_ == Formulation::SOSync)
+    return LGrho_ * X;
+
+  // form_ == Simplified:  Since the orthogonal projection Pi is real, we
+  // apply it to the real and imaginary parts of Omega^(1/2) * conj(T) * X
+  // simultaneously (using a single solve with the cached Cholesky factor)
+  size_t k = X.cols();
+  ComplexMatrix TX = SqrtOmega_T_ * X;
+
+  Matrix W(TX.rows(), 2 * k);
+  W << TX.real(), TX.imag();
+  Matrix PiW = Pi_product(W);
+
+  ComplexMatrix PiTX(TX.rows(), k);
+  PiTX.real() = PiW.leftCols(k);
+  PiTX.imag() = PiW.rightCols(k);
+
+  return LGrho_ * X + TT_SqrtOmega_ * PiTX;
+}
+
+Scalar PlanarSESyncProblem::evaluate_objective(const ComplexMatrix &Y) const {
+  return (Y * data_matrix_product(Y.adjoint())).trace().real();
+}
+
+ComplexMatrix
+PlanarSESyncProblem::Euclidean_gradient(const ComplexMatrix &Y) const {
+  return 2 * data_matrix_product(Y.adjoint()).adjoint();
+}
+
+ComplexMatrix PlanarSESyncProblem::Riemannian_Hessian_vector_product(
+    const ComplexMatrix &Y, const ComplexMatrix &nablaF_Y,
+    const ComplexMatrix &dotY) const {
+  return CSP_.Proj(Y, 2 * data_matrix_product(dotY.adjoint()).adjoint() -
+                          CSP_.SymBlockDiagProduct(dotY, Y, nablaF_Y));
+}
+
+ComplexMatrix
+PlanarSESyncProblem::precondition(const ComplexMatrix &Y,
+                                  const ComplexMatrix &dotY) const {
+  if (preconditioner_ == Preconditioner::None)
+    return dotY;
+  else if (preconditioner_ == Preconditioner::Jacobi)
+    return CSP_.Proj(Y,
+                     dotY * Jacobi_precon_.cast<ComplexScalar>().asDiagonal());
+  else {
+    // preconditioner == RegularizedCholesky
+    if (form_ == Formulation::SOSync)
+      return CSP_.Proj(Y, reg_Chol_precon_.solve(dotY.adjoint()).adjoint());
+
+    // As in SESyncProblem::precondition, we apply the inverse of the Schur
+    // complement of M with respect to the translational states by solving
+    //
+    //  M  [X]   =   [0]
+    //   [PYdot] = [Ydot]
+    ComplexMatrix rhs = ComplexMatrix::Zero(M_.rows(), dotY.rows());
+    rhs.bottomRows(n_) = dotY.adjoint();
+
+    ComplexMatrix Z = reg_Chol_precon_.solve(rhs);
+
+    return CSP_.Proj(Y, Z.bottomRows(n_).adjoint());
+  }
+}
+
+ComplexMatrix
+PlanarSESyncProblem::round_rotations(const ComplexMatrix &Y) const {
+  // The best rank-1 approximation of Z = Y^H Y is x^H x, where x = u^H Y and u
+  // is a dominant eigenvector of the (small) r x r Gram matrix Y Y^H
+  Eigen::SelfAdjointEigenSolver<ComplexMatrix> eig(Y * Y.adjoint());
+  ComplexMatrix R = eig.eigenvectors().rightCols<1>().adjoint() * Y;
+
+  // Project each element onto the unit circle.  Note that, unlike the real
+  // case, there is no reflection ambiguity to resolve here: complex
+  // conjugation does not preserve Z = Y^H Y
+  for (size_t i = 0; i < n_; ++i) {
+    Scalar modulus = std::abs(R(0, i));
+    R(0, i) = (modulus > 0 ? R(0, i) / modulus : ComplexScalar(1, 0));
+  }
+
+  return R;
+}
+
+Matrix PlanarSESyncProblem::round_solution(const ComplexMatrix &Y) const {
+  ComplexMatrix R = round_rotations(Y);
+
+  // Compute the offset at which the rotation matrix blocks begin
+  size_t rot_offset = (form_ == Formulation::Simplified ? n_ : 0);
+
+  Matrix X(2, rot_offset + 2 * n_);
+
+  for (size_t i = 0; i < n_; ++i)
+    X.block(0, rot_offset + 2 * i, 2, 2) = real_rotation(R(0, i));
+
+  if (form_ == Formulation::Simplified) {
+    // Recover the optimal translations corresponding to the estimated
+    // rotational states
+    ComplexMatrix t = recover_translations(R);
+    X.row(0).head(n_) = t.real();
+    X.row(1).head(n_) = t.imag();
+  }
+
+  return X;
+}
+
+ComplexMatrix
+PlanarSESyncProblem::recover_translations(const ComplexMatrix &R) const {
+  /// The optimal translations t (a 1 x n complex row vector) minimize
+  ///
+  /// || (t * A + R * T^T) * Omega^(1/2) ||^2
+  ///
+  /// Fixing the final translation to 0 (so that t * A = tred * Ared), the
+  /// normal equations for the remaining elements tred are
+  ///
+  /// (Ared * Omega * Ared^T) * tred^T = -Ared * Omega * T * R^T
+  ///
+  /// where Omega^(1/2) * T * R^T = conj(SqrtOmega_T_ * R^H)
+  ComplexVector c = (SqrtOmega_T_ * R.adjoint()).conjugate();
+
+  Matrix C(c.rows(), 2);
+  C << c.real(), c.imag();
+  Matrix tred = -L_.solve(Ared_SqrtOmega_ * C);
+
+  ComplexMatrix t = ComplexMatrix::Zero(1, n_);
+  t.row(0).head(n_ - 1).real() = tred.col(0).transpose();
+  t.row(0).head(n_ - 1).imag() = tred.col(1).transpose();
+
+  // Translate the solution so that the first pose lies at the origin
+  t.array() -= t(0, 0);
+
+  return t;
+}
+
+Vector
+PlanarSESyncProblem::compute_Lambda_diagonal(const ComplexMatrix &Y) const {
+  // Compute S * Y^H, where S is the data matrix defining the quadratic form
+  // for the specific version of the SE-Sync problem we're solving
+  ComplexMatrix SYt = data_matrix_product(Y.adjoint());
+
+  Vector lambda(n_);
+
+#pragma omp parallel for
+  for (size_t i = 0; i < n_; ++i)
+    lambda(i) = (SYt.row(i) * Y.col(i)).value().real();
+
+  return lambda;
+}
+
+SparseMatrix PlanarSESyncProblem::compute_Lambda_from_Lambda_diagonal(
+    const Vector &lambda) const {
+  std::vector<Eigen::Triplet<Scalar>> elements;
+  elements.reserve(2 * n_);
+
+  for (size_t i = 0; i < n_; ++i) {
+    elements.emplace_back(2 * i, 2 * i, lambda(i) / 2);
+    elements.emplace_back(2 * i + 1, 2 * i + 1, lambda(i) / 2);
+  }
+
+  SparseMatrix Lambda(2 * n_, 2 * n_);
+  Lambda.setFromTriplets(elements.begin(), elements.end());
+  return Lambda;
+}
+
+bool PlanarSESyncProblem::verify_solution(
+    const ComplexMatrix &Y, Scalar eta, size_t nx, Scalar &theta,
+    ComplexVector &x, size_t &num_iters, size_t max_LOBPCG_iters,
+    Scalar max_fill_factor, Scalar drop_tol,
+    const std::function<bool()> &interrupt) const {
+
+  /// Construct certificate matrix S
+
+  Vector lambda = compute_Lambda_diagonal(Y);
+
+  // We compute the certificate matrix corresponding to the *full* (i.e.
+  // translation-explicit) form of the problem when solving Simplified
+  // instances
+  const ComplexSparseMatrix &D = (form_ == Formulation::SOSync ? LGrho_ : M_);
+  size_t offset = (form_ == Formulation::SOSync ? 0 : n_);
+
+  std::vector<Eigen::Triplet<ComplexScalar>> elements;
+  elements.reserve(n_);
+  for (size_t i = 0; i < n_; ++i)
+    elements.emplace_back(offset + i, offset + i, lambda(i));
+
+  ComplexSparseMatrix Lambda(D.rows(), D.cols());
+  Lambda.setFromTriplets(elements.begin(), elements.end());
+
+  ComplexSparseMatrix S = D - Lambda;
+
+  /// Test positive-semidefiniteness of the real symmetric embedding of the
+  /// certificate matrix S using fast verification method
+  Vector xr;
+  bool PSD = fast_verification(real_symmetric_embedding(S), eta, nx, theta, xr,
+                               num_iters, max_LOBPCG_iters, max_fill_factor,
+                               drop_tol, interrupt);
+
+  // Recover the corresponding complex eigenvector of S
+  size_t N = S.rows();
+  x.resize(N);
+  x.real() = xr.head(N);
+  x.imag() = xr.tail(N);
+
+  if (!PSD && (form_ == Formulation::Simplified)) {
+    // Extract the (trailing) portion of the tangent vector corresponding to the
+    // rotational states
+    ComplexVector v = x.tail(n_).normalized();
+    x = v;
+
+    // Compute x's Rayleigh quotient with the simplified certificate matrix
+    ComplexVector Sx =
+        data_matrix_product(x) - lambda.cast<ComplexScalar>().cwiseProduct(x);
+    theta = x.dot(Sx).real();
+  }
+
+  return PSD;
+}
+
+ComplexMatrix PlanarSESyncProblem::chordal_initialization() const {
+  /// Fixing R_0 = 1, the minimizer of the relaxed objective
+  /// R * LGrho * R^H over complex row vectors R = [1, R_rest] is obtained by
+  /// solving the linear system
+  ///
+  ///  LGrho_rest,rest * R_rest^H = -LGrho_rest,0
+  ComplexMatrix R = ComplexMatrix::Ones(1, n_);
+
+  if (n_ > 1) {
+    // CHOLMOD's complex-valued factorizations require column-major storage
+    Eigen::SparseMatrix<ComplexScalar> L = LGrho_;
+    Eigen::SparseMatrix<ComplexScalar> Lrr =
+        L.bottomRightCorner(n_ - 1, n_ - 1);
+    ComplexVector b = -L.col(0).toDense().tail(n_ - 1);
+
+    ComplexSparseCholeskyFactorization chol(Lrr);
+    R.rightCols(n_ - 1) = chol.solve(b).adjoint();
+
+    // Project each element onto the unit circle
+    for (size_t i = 1; i < n_; ++i) {
+      Scalar modulus = std::abs(R(0, i));
+      R(0, i) = (modulus > 0 ? R(0, i) / modulus : ComplexScalar(1, 0));
+    }
+  }
+
+  return lift_rotations(R);
+}
+
+ComplexMatrix
+PlanarSESyncProblem::lift_rotations(const ComplexMatrix &R) const {
+  ComplexMatrix Y = ComplexMatrix::Zero(r_, n_);
+  Y.row(0) = R;
+  return Y;
+}
+
+} // namespace SESync
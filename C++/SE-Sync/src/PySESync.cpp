@@ -1,8 +1,14 @@
+#include "SESync/IncrementalSESync.h"
 #include "SESync/RelativePoseMeasurement.h"
+#include "SESync/RobustSESync.h"
 #include "SESync/SESync.h"
+#include "SESync/SESyncBatch.h"
+#include "SESync/SESyncPortfolio.h"
 #include "SESync/SESyncProblem.h"
 #include "SESync/SESync_types.h"
 #include "SESync/SESync_utils.h"
+#include "SESync/SlidingWindowSESync.h"
+#include "SESync/SpeculativeSESync.h"
 
 #include <tuple>
 
@@ -47,13 +53,33 @@ PYBIND11_MODULE(PySESync, m) {
       .value("RegularizedCholesky",
              SESync::Preconditioner::RegularizedCholesky);
 
+  // Local optimization method
+  py::enum_<SESync::LocalOptimizer>(
+      m, "LocalOptimizer",
+      "The local optimization method used at each level of the Riemannian "
+      "Staircase")
+      .value("TrustRegion", SESync::LocalOptimizer::TrustRegion)
+      .value("BlockCoordinateDescent",
+             SESync::LocalOptimizer::BlockCoordinateDescent,
+             "Parallel Riemannian block-coordinate descent (Explicit and "
+             "SOSync formulations only)");
+
   // Initialization method
   py::enum_<SESync::Initialization>(
       m, "Initialization",
       "The initialization method to use constructing an initial estimate, if "
       "none is provided")
       .value("Chordal", SESync::Initialization::Chordal)
-      .value("Random", SESync::Initialization::Random);
+      .value("Random", SESync::Initialization::Random)
+      .value("Spectral", SESync::Initialization::Spectral,
+             "Round the eigenvectors of the rotational connection Laplacian "
+             "corresponding to its smallest eigenvalues")
+      .value("SOSyncCascade", SESync::Initialization::SOSyncCascade,
+             "Initialize from a loose-tolerance solution of the rotation "
+             "synchronization problem")
+      .value("Multilevel", SESync::Initialization::Multilevel,
+             "Solve a hierarchy of coarsened pose graphs, and prolong the "
+             "coarse solution to initialize the full problem");
 
   // SE-Sync algorithm termination status
   py::enum_<SESync::SESyncStatus>(
@@ -72,7 +98,13 @@ PYBIND11_MODULE(PySESync, m) {
              "Staircase iterations before finding an optimal solution")
       .value("ElapsedTime", SESync::SESyncStatus::ElapsedTime,
              "The algorithm exhausted the alloted computation time before "
-             "finding an optimal solution");
+             "finding an optimal solution")
+      .value("Cancelled", SESync::SESyncStatus::Cancelled,
+             "The algorithm was cancelled before finding an optimal "
+             "solution")
+      .value("Unverified", SESync::SESyncStatus::Unverified,
+             "The algorithm computed a first-order critical point whose "
+             "optimality was not verified");
 
   /// Bindings for the RelativePoseMeasurement struct
 
@@ -114,6 +146,13 @@ PYBIND11_MODULE(PySESync, m) {
           "stepsize_tol", &SESync::SESyncOpts::stepsize_tol,
           "Stopping criterion based upon the norm of an accepted update step")
       .def_readwrite("max_time", &SESync::SESyncOpts::max_computation_time)
+      .def_readwrite("hard_deadline", &SESync::SESyncOpts::hard_deadline,
+                     "Whether to treat max_time as a hard deadline for the "
+                     "entire SE-Sync call, including post-processing")
+      .def_readwrite("deadline_reserve_factor",
+                     &SESync::SESyncOpts::deadline_reserve_factor,
+                     "Multiple of the estimated post-processing cost to "
+                     "reserve in hard-deadline mode")
 
       .def_readwrite(
           "max_iterations", &SESync::SESyncOpts::max_iterations,
@@ -135,6 +174,9 @@ PYBIND11_MODULE(PySESync, m) {
                      "Initial level of the Riemannian Staircase")
       .def_readwrite("rmax", &SESync::SESyncOpts::rmax,
                      "Maximum level of the Riemannian Staircase to explore")
+      .def_readwrite("verify", &SESync::SESyncOpts::verify,
+                     "Whether to verify the global optimality of the critical "
+                     "point computed at each level of the Riemannian Staircase")
       .def_readwrite("min_eig_num_tol", &SESync::SESyncOpts::min_eig_num_tol,
                      "Numerical tolerance for accepting the minimum eigenvalue "
                      "of the certificate matrix as nonnegative; this should be "
@@ -161,10 +203,102 @@ PYBIND11_MODULE(PySESync, m) {
       .def_readwrite(
           "reg_Chol_precon_max_cond",
           &SESync::SESyncOpts::reg_Cholesky_precon_max_condition_number)
+      .def_readwrite("local_optimizer", &SESync::SESyncOpts::local_optimizer,
+                     "The local optimization method used at each level of the "
+                     "Riemannian Staircase")
+      .def_readwrite("bcd_block_size", &SESync::SESyncOpts::bcd_block_size,
+                     "Number of consecutive states in each block when using "
+                     "block-coordinate descent")
+      .def_readwrite("bcd_local_iterations",
+                     &SESync::SESyncOpts::bcd_local_iterations,
+                     "Maximum number of trust-region iterations applied to "
+                     "each block during each sweep of block-coordinate "
+                     "descent")
 
+      .def_readwrite("escape_line_search_batch_size",
+                     &SESync::SESyncOpts::escape_line_search_batch_size,
+                     "Number of trial stepsizes evaluated together in the "
+                     "saddle escape line search")
+      .def_readwrite("escape_model_guided_step",
+                     &SESync::SESyncOpts::escape_model_guided_step,
+                     "Whether to predict the initial stepsize of the saddle "
+                     "escape line search using a local model of the objective")
+      .def_readwrite("max_escape_directions",
+                     &SESync::SESyncOpts::max_escape_directions,
+                     "Maximum number of directions of negative curvature to "
+                     "use simultaneously when escaping from a saddle point")
+      .def_readwrite("reduce_rank", &SESync::SESyncOpts::reduce_rank,
+                     "Whether to truncate the critical point found at each "
+                     "level of the Riemannian Staircase to its numerical rank "
+                     "(lowering the relaxation rank accordingly)")
+      .def_readwrite("rank_tol", &SESync::SESyncOpts::rank_tol,
+                     "Relative tolerance on the singular values used to "
+                     "compute numerical ranks")
+      .def_readwrite("use_complex_planar_solver",
+                     &SESync::SESyncOpts::use_complex_planar_solver,
+                     "Whether to solve planar (d = 2) problems using the "
+                     "complex-valued specialization of SE-Sync")
+      .def_readwrite("detect_planar_problems",
+                     &SESync::SESyncOpts::detect_planar_problems,
+                     "Whether to test 3D problems for planarity, and solve "
+                     "planar ones as SE(2) problems")
+      .def_readwrite("planar_rotation_tol",
+                     &SESync::SESyncOpts::planar_rotation_tol,
+                     "Rotational tolerance for planarity detection")
+      .def_readwrite("planar_translation_tol",
+                     &SESync::SESyncOpts::planar_translation_tol,
+                     "Translational tolerance for planarity detection")
+      .def_readwrite("decompose_components",
+                     &SESync::SESyncOpts::decompose_components,
+                     "Whether to solve the connected components of a "
+                     "disconnected pose graph as independent problems")
+      .def_readwrite("eliminate_bridges",
+                     &SESync::SESyncOpts::eliminate_bridges,
+                     "Whether to split the pose graph at its bridges and solve "
+                     "its 2-edge-connected components as independent problems")
+      .def_readwrite("component_threads",
+                     &SESync::SESyncOpts::component_threads,
+                     "Number of threads used to solve the connected components "
+                     "of a disconnected problem (0 = num_threads)")
       .def_readwrite("initialization", &SESync::SESyncOpts::initialization,
                      "Initialization method to use for calculating an initial "
                      "iterate Y0, if none was provided ")
+      .def_readwrite("spectral_init_max_iterations",
+                     &SESync::SESyncOpts::spectral_init_max_iterations,
+                     "Maximum number of LOBPCG iterations to perform when "
+                     "computing the spectral initialization")
+      .def_readwrite("spectral_init_tol",
+                     &SESync::SESyncOpts::spectral_init_tol,
+                     "Stopping tolerance for LOBPCG when computing the "
+                     "spectral initialization")
+      .def_readwrite("cascade_grad_norm_tol",
+                     &SESync::SESyncOpts::cascade_grad_norm_tol,
+                     "Stopping tolerance for the norm of the Riemannian "
+                     "gradient in the cascade's rotation synchronization solve")
+      .def_readwrite(
+          "cascade_preconditioned_grad_norm_tol",
+          &SESync::SESyncOpts::cascade_preconditioned_grad_norm_tol,
+          "Stopping tolerance for the norm of the preconditioned Riemannian "
+          "gradient in the cascade's rotation synchronization solve")
+      .def_readwrite("cascade_rel_func_decrease_tol",
+                     &SESync::SESyncOpts::cascade_rel_func_decrease_tol,
+                     "Stopping tolerance for the relative function decrease "
+                     "in the cascade's rotation synchronization solve")
+      .def_readwrite("multilevel_coarsest_size",
+                     &SESync::SESyncOpts::multilevel_coarsest_size,
+                     "Coarsening stops once a pose graph with at most this "
+                     "many states has been constructed")
+      .def_readwrite("multilevel_max_levels",
+                     &SESync::SESyncOpts::multilevel_max_levels,
+                     "Maximum number of coarsening steps")
+      .def_readwrite("multilevel_min_reduction",
+                     &SESync::SESyncOpts::multilevel_min_reduction,
+                     "Coarsening stops if a coarsening step fails to reduce "
+                     "the number of states by at least this fraction")
+      .def_readwrite("multilevel_refinement_iterations",
+                     &SESync::SESyncOpts::multilevel_refinement_iterations,
+                     "Maximum number of iterations used to refine the "
+                     "prolonged estimates at each intermediate level")
 
       .def_readwrite("verbose", &SESync::SESyncOpts::verbose,
                      "Boolean value indicating whether to print output as the "
@@ -173,9 +307,88 @@ PYBIND11_MODULE(PySESync, m) {
           "log_iterates", &SESync::SESyncOpts::log_iterates,
           "If this value is true, SE-Sync will log and return the entire "
           "sequence of iterates generated by the Riemannian Staircase")
+      .def_readwrite("iterate_log_file", &SESync::SESyncOpts::iterate_log_file,
+                     "If nonempty, stream the iterates generated by the "
+                     "Riemannian Staircase to this binary file")
+      .def_readwrite("iterate_log_stride",
+                     &SESync::SESyncOpts::iterate_log_stride,
+                     "Record only every k-th iterate at each level of the "
+                     "Staircase when streaming iterates to disk")
+      .def_readwrite("iterate_log_single_precision",
+                     &SESync::SESyncOpts::iterate_log_single_precision,
+                     "Store streamed iterates in single precision")
       .def_readwrite("num_threads", &SESync::SESyncOpts::num_threads,
                      "Number of threads to use for parallel parallelization");
 
+  /// Bindings for the SESyncTelemetry structs
+
+  py::class_<SESync::SESyncOperationCounts>(m, "SESyncOperationCounts")
+      .def(py::init<>())
+      .def_readwrite("data_matrix_products",
+                     &SESync::SESyncOperationCounts::data_matrix_products)
+      .def_readwrite("linear_solves",
+                     &SESync::SESyncOperationCounts::linear_solves)
+      .def_readwrite(
+          "LOBPCG_operator_applications",
+          &SESync::SESyncOperationCounts::LOBPCG_operator_applications);
+
+  py::class_<SESync::KernelStats>(m, "KernelStats")
+      .def(py::init<>())
+      .def_readwrite("calls", &SESync::KernelStats::calls)
+      .def_readwrite("flops", &SESync::KernelStats::flops)
+      .def_readwrite("bytes", &SESync::KernelStats::bytes)
+      .def_readwrite("time", &SESync::KernelStats::time)
+      .def("GFLOPS", &SESync::KernelStats::GFLOPS)
+      .def("GBS", &SESync::KernelStats::GBS)
+      .def("intensity", &SESync::KernelStats::intensity);
+
+  m.def("kernel_counters_enabled", &SESync::kernel_counters_enabled,
+        "Returns true if kernel counters were compiled in");
+
+  py::class_<SESync::SESyncLevelTelemetry>(m, "SESyncLevelTelemetry")
+      .def(py::init<>())
+      .def_readwrite("relaxation_rank",
+                     &SESync::SESyncLevelTelemetry::relaxation_rank)
+      .def_readwrite("optimization_time",
+                     &SESync::SESyncLevelTelemetry::optimization_time)
+      .def_readwrite("verification_time",
+                     &SESync::SESyncLevelTelemetry::verification_time)
+      .def_readwrite("escape_time", &SESync::SESyncLevelTelemetry::escape_time)
+      .def_readwrite("counts", &SESync::SESyncLevelTelemetry::counts)
+      .def_readwrite("kernels", &SESync::SESyncLevelTelemetry::kernels);
+
+  py::class_<SESync::SESyncTelemetry>(
+      m, "SESyncTelemetry",
+      "Elapsed computation time spent in each phase of the SE-Sync algorithm, "
+      "together with counts of its most expensive operations")
+      .def(py::init<>())
+      .def_readwrite("problem_construction_time",
+                     &SESync::SESyncTelemetry::problem_construction_time)
+      .def_readwrite("projection_factorization_time",
+                     &SESync::SESyncTelemetry::projection_factorization_time)
+      .def_readwrite(
+          "preconditioner_norm_estimate_time",
+          &SESync::SESyncTelemetry::preconditioner_norm_estimate_time)
+      .def_readwrite(
+          "preconditioner_factorization_time",
+          &SESync::SESyncTelemetry::preconditioner_factorization_time)
+      .def_readwrite("initialization_time",
+                     &SESync::SESyncTelemetry::initialization_time)
+      .def_readwrite("staircase_time", &SESync::SESyncTelemetry::staircase_time)
+      .def_readwrite("levels", &SESync::SESyncTelemetry::levels)
+      .def_readwrite("post_processing_time",
+                     &SESync::SESyncTelemetry::post_processing_time)
+      .def_readwrite("rounding_time", &SESync::SESyncTelemetry::rounding_time)
+      .def_readwrite("Lambda_time", &SESync::SESyncTelemetry::Lambda_time)
+      .def_readwrite("total_time", &SESync::SESyncTelemetry::total_time)
+      .def_readwrite("counts", &SESync::SESyncTelemetry::counts)
+      .def_readwrite("kernels", &SESync::SESyncTelemetry::kernels)
+      .def("to_json",
+           [](const SESync::SESyncTelemetry &telemetry) {
+             return SESync::to_json(telemetry);
+           },
+           "Serialize this record to a JSON string");
+
   /// Bindings for the SESyncResult struct
 
   py::class_<SESync::SESyncResult>(m, "SESyncResult")
@@ -211,6 +424,73 @@ PYBIND11_MODULE(PySESync, m) {
                      &SESync::SESyncResult::initialization_time,
                      "Elapsed time needed to compute an initial estimate for "
                      "the Riemannian Staircase")
+      .def_readwrite("rounding_reserve_time",
+                     &SESync::SESyncResult::rounding_reserve_time,
+                     "Computation time reserved for post-processing in "
+                     "hard-deadline mode")
+      .def_readwrite("cascade_construction_time",
+                     &SESync::SESyncResult::cascade_construction_time,
+                     "Elapsed time needed to construct the cascade's rotation "
+                     "synchronization problem")
+      .def_readwrite("cascade_rotation_time",
+                     &SESync::SESyncResult::cascade_rotation_time,
+                     "Elapsed time needed to solve the cascade's rotation "
+                     "synchronization problem")
+      .def_readwrite("cascade_lifting_time",
+                     &SESync::SESyncResult::cascade_lifting_time,
+                     "Elapsed time needed to lift the cascade's rotation "
+                     "estimates to an initial iterate")
+      .def_readwrite("multilevel_num_states",
+                     &SESync::SESyncResult::multilevel_num_states,
+                     "The number of states in each level of the multilevel "
+                     "hierarchy, from finest to coarsest")
+      .def_readwrite("multilevel_coarsening_time",
+                     &SESync::SESyncResult::multilevel_coarsening_time,
+                     "Elapsed time needed to construct the multilevel "
+                     "hierarchy")
+      .def_readwrite("multilevel_coarse_solve_time",
+                     &SESync::SESyncResult::multilevel_coarse_solve_time,
+                     "Elapsed time needed to solve the coarsest problem in the "
+                     "multilevel hierarchy")
+      .def_readwrite("multilevel_refinement_time",
+                     &SESync::SESyncResult::multilevel_refinement_time,
+                     "Elapsed time needed to prolong and refine the coarse "
+                     "estimates to an initial iterate")
+      .def_readwrite("relaxation_ranks",
+                     &SESync::SESyncResult::relaxation_ranks,
+                     "The relaxation rank at each level of the Riemannian "
+                     "Staircase that was visited")
+      .def_readwrite("numerical_ranks",
+                     &SESync::SESyncResult::numerical_ranks,
+                     "The numerical rank of the critical point found at each "
+                     "level of the Riemannian Staircase that was visited")
+      .def_readwrite("escape_directions",
+                     &SESync::SESyncResult::escape_directions,
+                     "The number of directions of negative curvature used to "
+                     "escape from each saddle point")
+      .def_readwrite("planar_reduction",
+                     &SESync::SESyncResult::planar_reduction,
+                     "Whether a 3D problem was detected to be planar and "
+                     "solved as a planar problem")
+      .def_readwrite("planar_reduction_time",
+                     &SESync::SESyncResult::planar_reduction_time,
+                     "Elapsed time needed to test for planarity and construct "
+                     "the reduced planar problem")
+      .def_readwrite("planar_certification_time",
+                     &SESync::SESyncResult::planar_certification_time,
+                     "Elapsed time needed to certify the lifted estimates of "
+                     "a planar problem on the original 3D problem")
+      .def_readwrite("component_states",
+                     &SESync::SESyncResult::component_states,
+                     "The indices of the states in each connected component, "
+                     "if the pose graph was decomposed")
+      .def_readwrite("component_results",
+                     &SESync::SESyncResult::component_results,
+                     "The result of solving each connected component, if the "
+                     "pose graph was decomposed")
+      .def_readwrite("num_bridges", &SESync::SESyncResult::num_bridges,
+                     "The number of bridges joining the 2-edge-connected "
+                     "components, if the pose graph was split at its bridges")
       .def_readwrite(
           "function_values", &SESync::SESyncResult::function_values,
           "A vector containing the sequence of function values obtained during "
@@ -265,6 +545,8 @@ PYBIND11_MODULE(PySESync, m) {
                      "If log_iterates = true, this will contain the sequence "
                      "of iterates generated by the TNT method at each level of "
                      "the Riemannian Staircase")
+      .def_readwrite("telemetry", &SESync::SESyncResult::telemetry,
+                     "Per-phase timing and operation counts")
       .def_readwrite("status", &SESync::SESyncResult::status,
                      "Termination status of the SE-Sync algorithm");
 
@@ -359,6 +641,16 @@ PYBIND11_MODULE(PySESync, m) {
       "Given the measurement matrix B3 defined in equation (69c) of the tech "
       "report and the problem dimension d, this function computes and returns "
       "the corresponding chordal initialization for the rotational states");
+  m.def("spectral_initialization",
+        [](size_t d, const SESync::SparseMatrix &LGrho, size_t max_iters,
+           SESync::Scalar tol) {
+          return SESync::spectral_initialization(d, LGrho, max_iters, tol);
+        },
+        py::arg("d"), py::arg("LGrho"), py::arg("max_iters") = 100,
+        py::arg("tol") = 1e-3,
+        "Given the rotational connection Laplacian LGrho and the problem "
+        "dimension d, this function computes and returns the corresponding "
+        "spectral initialization for the rotational states");
   m.def("recover_translations", &SESync::recover_translations,
         "Given the measurement matrices B1 and B2 and a matrix R of rotational "
         "state estimates, this function computes and returns the "
@@ -438,6 +730,20 @@ PYBIND11_MODULE(PySESync, m) {
            py::arg("reg_chol_precon_max_cond") = 1e6, "Basic constructor.")
       .def("set_relaxation_rank", &SESync::SESyncProblem::set_relaxation_rank,
            "Set maximum rank of the rank-restricted semidefinite relaxation.")
+      .def("add_measurements", &SESync::SESyncProblem::add_measurements,
+           "Append measurements to this problem, updating its cached "
+           "factorizations in place where possible")
+      .def("set_measurements", &SESync::SESyncProblem::set_measurements,
+           "Replace the measurements of this problem, updating its cached "
+           "factorizations in place where possible")
+      .def("set_measurement_precisions",
+           &SESync::SESyncProblem::set_measurement_precisions,
+           "Replace the precisions of the measurements of this problem, "
+           "refactoring its data matrices using their cached symbolic "
+           "analyses")
+      .def("extend_iterate", &SESync::SESyncProblem::extend_iterate,
+           "Extend a point in the domain of the relaxation for this problem "
+           "(before appending measurements) to the current problem")
       .def("formulation", &SESync::SESyncProblem::formulation,
            "Get the specific formulation of this problem")
       .def(
@@ -513,6 +819,18 @@ PYBIND11_MODULE(PySESync, m) {
            &SESync::SESyncProblem::chordal_initialization,
            "This function computes and returns a chordal initialization for "
            "the rank-restricted semidefinite relaxation")
+      .def("spectral_initialization",
+           [](const SESync::SESyncProblem &problem, size_t max_iters,
+              SESync::Scalar tol) {
+             return problem.spectral_initialization(max_iters, tol);
+           },
+           py::arg("max_iters") = 100, py::arg("tol") = 1e-3,
+           "This function computes and returns a spectral initialization for "
+           "the rank-restricted semidefinite relaxation")
+      .def("lift_rotations", &SESync::SESyncProblem::lift_rotations,
+           "Given a d x dn matrix R of rotational state estimates, this "
+           "function constructs and returns the corresponding point in the "
+           "domain of the rank-restricted semidefinite relaxation")
       .def("random_sample", &SESync::SESyncProblem::random_sample,
            "Randomly sample a point in the domain of the rank-restricted "
            "semidefinite relaxation");
@@ -550,4 +868,300 @@ PYBIND11_MODULE(PySESync, m) {
       "Main SE-Sync function:  Given an SESyncProblem instance, this "
       "function computes and returns an estimated solution using the SE-Sync "
       "algorithm ");
+
+  /// Bindings for the certification of externally computed estimates
+
+  py::class_<SESync::SESyncCertificate>(m, "SESyncCertificate")
+      .def(py::init<>())
+      .def_readwrite("status", &SESync::SESyncCertificate::status,
+                     "GlobalOpt if the estimate was certified")
+      .def_readwrite("xhat", &SESync::SESyncCertificate::xhat,
+                     "The estimate that was certified")
+      .def_readwrite("Fxhat", &SESync::SESyncCertificate::Fxhat,
+                     "The objective value attained by xhat")
+      .def_readwrite("Y", &SESync::SESyncCertificate::Y,
+                     "The lifting of xhat at which the certificate matrix was "
+                     "constructed")
+      .def_readwrite("gradnorm", &SESync::SESyncCertificate::gradnorm,
+                     "The norm of the Riemannian gradient at Y")
+      .def_readwrite("Lambda", &SESync::SESyncCertificate::Lambda,
+                     "The Lagrange multiplier matrix Lambda(Y)")
+      .def_readwrite("trLambda", &SESync::SESyncCertificate::trLambda,
+                     "The trace of Lambda(Y)")
+      .def_readwrite("suboptimality_bound",
+                     &SESync::SESyncCertificate::suboptimality_bound,
+                     "Upper bound F(xhat) - tr(Lambda) on the suboptimality "
+                     "of xhat (valid only if certified)")
+      .def_readwrite("theta", &SESync::SESyncCertificate::theta,
+                     "Approximate minimum eigenvalue of the certificate "
+                     "matrix")
+      .def_readwrite("escape_direction",
+                     &SESync::SESyncCertificate::escape_direction,
+                     "Direction of negative curvature of the certificate "
+                     "matrix (if not certified)")
+      .def_readwrite("LOBPCG_iters", &SESync::SESyncCertificate::LOBPCG_iters)
+      .def_readwrite("lifting_time", &SESync::SESyncCertificate::lifting_time)
+      .def_readwrite("polishing_time",
+                     &SESync::SESyncCertificate::polishing_time)
+      .def_readwrite("verification_time",
+                     &SESync::SESyncCertificate::verification_time)
+      .def_readwrite("total_computation_time",
+                     &SESync::SESyncCertificate::total_computation_time);
+
+  m.def(
+      "certify",
+      [](SESync::SESyncProblem &problem, const SESync::Matrix &xhat,
+         const SESync::SESyncOpts &options, size_t polish_iterations) {
+        // Redirect emitted output from (C++) stdout to (Python) sys.stdout
+        py::scoped_ostream_redirect stream(
+            std::cout, py::module::import("sys").attr("stdout"));
+        return SESync::certify(problem, xhat, options, polish_iterations);
+      },
+      py::arg("problem"), py::arg("xhat"),
+      py::arg("options") = SESync::SESyncOpts(),
+      py::arg("polish_iterations") = 0,
+      "Certify the global optimality of an externally computed estimate, "
+      "optionally polishing it first with a few trust-region iterations");
+
+  /// Bindings for the incremental SE-Sync driver
+
+  py::class_<SESync::IncrementalSESync>(m, "IncrementalSESync")
+      .def(py::init<const SESync::SESyncOpts &>(),
+           py::arg("options") = SESync::SESyncOpts())
+      .def("update", &SESync::IncrementalSESync::update,
+           "Append measurements to the pose graph and re-solve it, "
+           "warm-starting from the previous solution")
+      .def("initialized", &SESync::IncrementalSESync::initialized)
+      .def("result", &SESync::IncrementalSESync::result)
+      .def("problem_update_time",
+           &SESync::IncrementalSESync::problem_update_time)
+      .def("solve_time", &SESync::IncrementalSESync::solve_time)
+      .def("update_time", &SESync::IncrementalSESync::update_time)
+      .def("factorizations_updated",
+           &SESync::IncrementalSESync::factorizations_updated);
+
+  /// Bindings for the sliding-window SE-Sync driver
+
+  py::class_<SESync::SlidingWindowSESync>(m, "SlidingWindowSESync")
+      .def(py::init<size_t, const SESync::SESyncOpts &, size_t>(),
+           py::arg("window_size"), py::arg("options") = SESync::SESyncOpts(),
+           py::arg("refactorization_period") = 0)
+      .def("update", &SESync::SlidingWindowSESync::update,
+           "Append measurements to the pose graph, advance the window, and "
+           "re-solve the windowed problem")
+      .def("num_states", &SESync::SlidingWindowSESync::num_states)
+      .def("window_start", &SESync::SlidingWindowSESync::window_start)
+      .def("pose", &SESync::SlidingWindowSESync::pose,
+           "Current estimate [t | R] of the given state in the world frame")
+      .def("result", &SESync::SlidingWindowSESync::result)
+      .def("problem_update_time",
+           &SESync::SlidingWindowSESync::problem_update_time)
+      .def("solve_time", &SESync::SlidingWindowSESync::solve_time)
+      .def("update_time", &SESync::SlidingWindowSESync::update_time)
+      .def("factorizations_updated",
+           &SESync::SlidingWindowSESync::factorizations_updated);
+
+  /// Bindings for the robust (GNC) SE-Sync driver
+
+  py::class_<SESync::RobustSESyncOpts>(m, "RobustSESyncOpts")
+      .def(py::init<>())
+      .def_readwrite("inlier_threshold",
+                     &SESync::RobustSESyncOpts::inlier_threshold,
+                     "Maximum squared residual of an inlier measurement")
+      .def_readwrite("gnc_factor", &SESync::RobustSESyncOpts::gnc_factor,
+                     "Factor by which the GNC control parameter is increased "
+                     "after each round")
+      .def_readwrite("max_rounds", &SESync::RobustSESyncOpts::max_rounds,
+                     "Maximum number of GNC rounds")
+      .def_readwrite("weight_tol", &SESync::RobustSESyncOpts::weight_tol,
+                     "GNC terminates once every weight lies within this "
+                     "distance of 0 or 1")
+      .def_readwrite("min_weight", &SESync::RobustSESyncOpts::min_weight,
+                     "Lower bound on the weights applied to the measurements")
+      .def_readwrite("reuse_problem",
+                     &SESync::RobustSESyncOpts::reuse_problem,
+                     "Whether to reweight a single problem in place (rather "
+                     "than solving a new problem from scratch in each round)")
+      .def_readwrite("verbose", &SESync::RobustSESyncOpts::verbose);
+
+  py::class_<SESync::RobustSESyncResult>(m, "RobustSESyncResult")
+      .def(py::init<>())
+      .def_readwrite("result", &SESync::RobustSESyncResult::result)
+      .def_readwrite("weights", &SESync::RobustSESyncResult::weights)
+      .def_readwrite("outliers", &SESync::RobustSESyncResult::outliers)
+      .def_readwrite("num_rounds", &SESync::RobustSESyncResult::num_rounds)
+      .def_readwrite("round_times", &SESync::RobustSESyncResult::round_times)
+      .def_readwrite("reweighting_time",
+                     &SESync::RobustSESyncResult::reweighting_time)
+      .def_readwrite("total_computation_time",
+                     &SESync::RobustSESyncResult::total_computation_time);
+
+  m.def("gnc_tls_weights", &SESync::gnc_tls_weights, py::arg("residuals"),
+        py::arg("inlier_threshold"), py::arg("mu"),
+        "Returns the GNC-TLS weights corresponding to the given residuals");
+
+  m.def(
+      "RobustSESync",
+      [](const SESync::measurements_t &measurements,
+         const SESync::SESyncOpts &options,
+         const SESync::RobustSESyncOpts &robust_options) {
+        // Redirect emitted output from (C++) stdout to (Python) sys.stdout
+        py::scoped_ostream_redirect stream(
+            std::cout, py::module::import("sys").attr("stdout"));
+        return SESync::RobustSESync(measurements, options, robust_options);
+      },
+      py::arg("measurements"), py::arg("options") = SESync::SESyncOpts(),
+      py::arg("robust_options") = SESync::RobustSESyncOpts(),
+      "Robustly solve a special Euclidean synchronization problem using "
+      "graduated non-convexity with the truncated least-squares cost");
+
+  /// Bindings for the portfolio SE-Sync driver
+
+  py::class_<SESync::SESyncPortfolioOpts>(m, "SESyncPortfolioOpts")
+      .def(py::init<>())
+      .def_readwrite("variants", &SESync::SESyncPortfolioOpts::variants,
+                     "Configurations to race")
+      .def_readwrite("num_threads", &SESync::SESyncPortfolioOpts::num_threads,
+                     "Total number of threads to divide among the "
+                     "configurations (0 means the number of hardware threads)")
+      .def_readwrite("record_file", &SESync::SESyncPortfolioOpts::record_file,
+                     "CSV file to which the outcomes are appended")
+      .def_readwrite("dataset_name",
+                     &SESync::SESyncPortfolioOpts::dataset_name,
+                     "Name used to label the recorded outcomes")
+      .def_readwrite("verbose", &SESync::SESyncPortfolioOpts::verbose);
+
+  py::class_<SESync::SESyncPortfolioRun>(m, "SESyncPortfolioRun")
+      .def(py::init<>())
+      .def_readwrite("options", &SESync::SESyncPortfolioRun::options)
+      .def_readwrite("result", &SESync::SESyncPortfolioRun::result)
+      .def_readwrite("failed", &SESync::SESyncPortfolioRun::failed)
+      .def_readwrite("num_threads", &SESync::SESyncPortfolioRun::num_threads)
+      .def_readwrite("elapsed_time", &SESync::SESyncPortfolioRun::elapsed_time);
+
+  py::class_<SESync::SESyncPortfolioResult>(m, "SESyncPortfolioResult")
+      .def(py::init<>())
+      .def_readwrite("runs", &SESync::SESyncPortfolioResult::runs)
+      .def_readwrite("winner", &SESync::SESyncPortfolioResult::winner)
+      .def_readwrite("total_time", &SESync::SESyncPortfolioResult::total_time)
+      .def("result", &SESync::SESyncPortfolioResult::result);
+
+  m.def("default_portfolio", &SESync::default_portfolio,
+        py::arg("base") = SESync::SESyncOpts(),
+        "Returns a default set of configurations derived from 'base'");
+
+  m.def("SESyncPortfolio", &SESync::SESyncPortfolio, py::arg("measurements"),
+        py::arg("portfolio_options") = SESync::SESyncPortfolioOpts(),
+        py::call_guard<py::gil_scoped_release>(),
+        "Race several SE-Sync configurations on the same problem");
+
+  /// Bindings for the speculative SE-Sync driver
+
+  py::enum_<SESync::SpeculationMode>(m, "SpeculationMode")
+      .value("Auto", SESync::SpeculationMode::Auto,
+             "Speculate if enough threads are available and previous solves "
+             "of the dataset needed several levels of the Staircase")
+      .value("Always", SESync::SpeculationMode::Always, "Always speculate")
+      .value("Never", SESync::SpeculationMode::Never, "Never speculate");
+
+  py::class_<SESync::SpeculativeSESyncOpts>(m, "SpeculativeSESyncOpts")
+      .def(py::init<>())
+      .def_readwrite("mode", &SESync::SpeculativeSESyncOpts::mode)
+      .def_readwrite("num_threads",
+                     &SESync::SpeculativeSESyncOpts::num_threads,
+                     "Total number of threads to divide between the two paths "
+                     "(0 means the number of hardware threads)")
+      .def_readwrite("min_threads_per_path",
+                     &SESync::SpeculativeSESyncOpts::min_threads_per_path,
+                     "Minimum number of threads per path required to "
+                     "speculate in Auto mode")
+      .def_readwrite("min_historical_levels",
+                     &SESync::SpeculativeSESyncOpts::min_historical_levels,
+                     "Minimum historical number of Staircase levels required "
+                     "to speculate in Auto mode")
+      .def_readwrite("history_file",
+                     &SESync::SpeculativeSESyncOpts::history_file,
+                     "CSV file from which the certified ranks of previous "
+                     "solves are read, and to which the outcome is appended")
+      .def_readwrite("dataset_name",
+                     &SESync::SpeculativeSESyncOpts::dataset_name,
+                     "Name used to label the recorded outcomes")
+      .def_readwrite("speculative_rank",
+                     &SESync::SpeculativeSESyncOpts::speculative_rank,
+                     "Relaxation rank at which to start the speculative path "
+                     "(0 means the median historical certified rank)")
+      .def_readwrite("lifting_perturbation",
+                     &SESync::SpeculativeSESyncOpts::lifting_perturbation,
+                     "Relative norm of the random perturbation of the lifted "
+                     "initial iterate of the speculative path")
+      .def_readwrite("verbose", &SESync::SpeculativeSESyncOpts::verbose);
+
+  py::class_<SESync::SpeculativeSESyncResult>(m, "SpeculativeSESyncResult")
+      .def(py::init<>())
+      .def_readwrite("result", &SESync::SpeculativeSESyncResult::result,
+                     "The result of the winning path")
+      .def_readwrite("speculated",
+                     &SESync::SpeculativeSESyncResult::speculated)
+      .def_readwrite("speculative_won",
+                     &SESync::SpeculativeSESyncResult::speculative_won)
+      .def_readwrite("speculative_rank",
+                     &SESync::SpeculativeSESyncResult::speculative_rank)
+      .def_readwrite("base_result",
+                     &SESync::SpeculativeSESyncResult::base_result)
+      .def_readwrite("speculative_result",
+                     &SESync::SpeculativeSESyncResult::speculative_result)
+      .def_readwrite("base_time", &SESync::SpeculativeSESyncResult::base_time)
+      .def_readwrite("speculative_time",
+                     &SESync::SpeculativeSESyncResult::speculative_time)
+      .def_readwrite("historical_ranks",
+                     &SESync::SpeculativeSESyncResult::historical_ranks)
+      .def_readwrite("total_time",
+                     &SESync::SpeculativeSESyncResult::total_time);
+
+  m.def("SpeculativeSESync", &SESync::SpeculativeSESync,
+        py::arg("measurements"), py::arg("options") = SESync::SESyncOpts(),
+        py::arg("speculative_options") = SESync::SpeculativeSESyncOpts(),
+        py::call_guard<py::gil_scoped_release>(),
+        "Solve a special Euclidean synchronization problem, speculatively "
+        "running a higher level of the Riemannian Staircase concurrently");
+
+  m.def("read_speculation_history", &SESync::read_speculation_history,
+        py::arg("filename"), py::arg("dataset_name"),
+        "Returns the certified relaxation ranks of previous solves of the "
+        "given dataset");
+
+  /// Bindings for the batch SE-Sync driver
+
+  py::class_<SESync::SESyncBatchOpts>(m, "SESyncBatchOpts")
+      .def(py::init<>())
+      .def_readwrite("num_threads", &SESync::SESyncBatchOpts::num_threads,
+                     "Total number of threads to use (0 means the number of "
+                     "hardware threads)")
+      .def_readwrite("measurements_per_thread",
+                     &SESync::SESyncBatchOpts::measurements_per_thread,
+                     "Number of measurements per intra-problem thread")
+      .def_readwrite("verbose", &SESync::SESyncBatchOpts::verbose,
+                     "Print a line as each problem finishes");
+
+  py::class_<SESync::SESyncBatchResult>(m, "SESyncBatchResult")
+      .def(py::init<>())
+      .def_readwrite("results", &SESync::SESyncBatchResult::results)
+      .def_readwrite("num_threads", &SESync::SESyncBatchResult::num_threads)
+      .def_readwrite("total_time", &SESync::SESyncBatchResult::total_time)
+      .def_readwrite("throughput", &SESync::SESyncBatchResult::throughput);
+
+  // NB: The GIL is released while the batch is running, so (C++) output is
+  // not redirected to (Python) sys.stdout here
+  m.def(
+      "SESyncBatch",
+      [](const std::vector<SESync::measurements_t> &problems,
+         const SESync::SESyncOpts &options,
+         const SESync::SESyncBatchOpts &batch_options) {
+        return SESync::SESyncBatch(problems, options, batch_options);
+      },
+      py::arg("problems"), py::arg("options") = SESync::SESyncOpts(),
+      py::arg("batch_options") = SESync::SESyncBatchOpts(),
+      py::call_guard<py::gil_scoped_release>(),
+      "Solve a collection of special Euclidean synchronization problems "
+      "concurrently using a shared pool of threads");
 }
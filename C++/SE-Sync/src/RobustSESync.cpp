@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/RobustSESync.h"
+#include "SESync/SESyncProblem.h"
+#include "SESync/SESync_utils.h"
+
+namespace SESync {
+
+Vector gnc_tls_weights(const Vector &residuals, Scalar inlier_threshold,
+                       Scalar mu) {
+  Vector weights(residuals.size());
+  for (int k = 0; k < residuals.size(); ++k) {
+    Scalar r2 = residuals(k);
+    if (r2 >= (mu + 1) / mu * inlier_threshold)
+      weights(k) = 0;
+    else if (r2 <= mu / (mu + 1) * inlier_threshold)
+      weights(k) = 1;
+    else
+      weights(k) = std::sqrt(inlier_threshold * mu * (mu + 1) / r2) - mu;
+  }
+  return weights;
+}
+
+RobustSESyncResult RobustSESync(const measurements_t &measurements,
+                                const SESyncOpts &options,
+                                const RobustSESyncOpts &robust_options) {
+  if (measurements.empty())
+    throw std::invalid_argument("A problem must contain measurements");
+
+  if (robust_options.inlier_threshold <= 0)
+    throw std::invalid_argument("Inlier threshold must be a positive value");
+
+  if (robust_options.gnc_factor <= 1)
+    throw std::invalid_argument("GNC factor must be greater than 1");
+
+  if (robust_options.max_rounds < 1)
+    throw std::invalid_argument(
+        "Maximum number of GNC rounds must be a positive integer");
+
+  if (robust_options.min_weight <= 0 || robust_options.min_weight > 1)
+    throw std::invalid_argument(
+        "Minimum measurement weight must be a value in the range (0, 1]");
+
+  auto start_time = Stopwatch::tick();
+
+  size_t m = measurements.size();
+  Vector kappa(m), tau(m);
+  for (size_t k = 0; k < m; ++k) {
+    kappa(k) = measurements[k].kappa;
+    tau(k) = measurements[k].tau;
+  }
+
+  RobustSESyncResult robust_result;
+  robust_result.weights = Vector::Ones(m);
+
+  // The reweighted measurements (only used if the problem is not reused)
+  measurements_t weighted_measurements = measurements;
+
+  // The problem whose measurements are reweighted in place.  Since the weights
+  // never exceed 1, the regularization constant of its preconditioner remains
+  // valid throughout (cf. SESyncProblem::set_measurement_precisions).
+  std::unique_ptr<SESyncProblem> problem;
+  if (robust_options.reuse_problem)
+    problem = std::make_unique<SESyncProblem>(
+        measurements, options.formulation, options.projection_factorization,
+        options.preconditioner,
+        options.reg_Cholesky_precon_max_condition_number);
+
+  SESyncResult &result = robust_result.result;
+  Scalar mu = 0;
+  bool final_round = (robust_options.max_rounds == 1);
+
+  for (size_t round = 0;; ++round) {
+    /// SOLVE THE WEIGHTED PROBLEM
+
+    SESyncOpts round_opts = options;
+    round_opts.max_computation_time =
+        options.max_computation_time - Stopwatch::tock(start_time);
+    if (round_opts.max_computation_time <= 0) {
+      result.status = ElapsedTime;
+      break;
+    }
+    if (!final_round)
+      round_opts.iterate_log_file.clear();
+
+    auto round_start_time = Stopwatch::tick();
+    if (robust_options.reuse_problem) {
+      // Warm-start from the previous solution at its existing rank, and
+      // certify only the final round
+      Matrix Y0;
+      if (round > 0) {
+        Y0 = result.Yopt;
+        round_opts.r0 = Y0.rows();
+        round_opts.rmax = std::max(options.rmax, round_opts.r0);
+      }
+      round_opts.verify = options.verify && final_round;
+      result = SESync(*problem, round_opts, Y0);
+    } else
+      result = SESync(weighted_measurements, round_opts);
+    robust_result.round_times.push_back(Stopwatch::tock(round_start_time));
+    robust_result.num_rounds = round + 1;
+
+    if (robust_options.verbose)
+      std::cout << "GNC round " << round << ": "
+                << robust_result.outliers.size()
+                << " outliers, F(xhat) = " << result.Fxhat << ", "
+                << robust_result.round_times.back() << " seconds" << std::endl;
+
+    if (final_round || result.status == ElapsedTime ||
+        result.status == Cancelled)
+      break;
+
+    /// UPDATE THE WEIGHTS
+
+    // The residuals are evaluated with respect to the original (unweighted)
+    // measurements
+    Vector residuals = measurement_residuals(measurements, result.xhat);
+
+    if (round == 0) {
+      // Initialize the control parameter so that the surrogate cost is convex
+      // over the range of the initial residuals (cf. Yang et al., Remark 5)
+      Scalar max_residual = residuals.maxCoeff();
+      mu = (max_residual > robust_options.inlier_threshold
+                ? robust_options.inlier_threshold /
+                      (2 * max_residual - robust_options.inlier_threshold)
+                : std::numeric_limits<Scalar>::infinity());
+    }
+
+    robust_result.weights =
+        (std::isinf(mu) ? Vector(Vector::Ones(m))
+                        : gnc_tls_weights(residuals,
+                                          robust_options.inlier_threshold, mu));
+    mu *= robust_options.gnc_factor;
+
+    robust_result.outliers.clear();
+    bool converged = true;
+    for (size_t k = 0; k < m; ++k) {
+      Scalar w = robust_result.weights(k);
+      if (w < .5)
+        robust_result.outliers.push_back(k);
+      if (std::min(w, 1 - w) > robust_options.weight_tol)
+        converged = false;
+    }
+    final_round = converged || round + 2 >= robust_options.max_rounds;
+
+    // Apply the updated weights
+    auto reweighting_start_time = Stopwatch::tick();
+    Vector w = robust_result.weights.cwiseMax(robust_options.min_weight);
+    if (robust_options.reuse_problem)
+      problem->set_measurement_precisions(w.cwiseProduct(kappa),
+                                          w.cwiseProduct(tau));
+    else
+      for (size_t k = 0; k < m; ++k) {
+        weighted_measurements[k].kappa = w(k) * kappa(k);
+        weighted_measurements[k].tau = w(k) * tau(k);
+      }
+    robust_result.reweighting_time += Stopwatch::tock(reweighting_start_time);
+  }
+
+  robust_result.total_computation_time = Stopwatch::tock(start_time);
+
+  if (robust_options.verbose)
+    std::cout << "Robust solve finished after " << robust_result.num_rounds
+              << " rounds (" << robust_result.outliers.size() << " of " << m
+              << " measurements rejected); total elapsed computation time: "
+              << robust_result.total_computation_time << " seconds"
+              << std::endl;
+
+  return robust_result;
+}
+
+} // namespace SESync
@@ -1,6 +1,9 @@
 ﻿#include <functional>
 
+#include "SESync/BlockCoordinateDescent.h"
+#include "SESync/IterateWriter.h"
 #include "SESync/SESync.h"
+#include "SESync/SESyncBatch.h"
 #include "SESync/SESyncProblem.h"
 #include "SESync/SESync_types.h"
 #include "SESync/SESync_utils.h"
@@ -8,9 +11,363 @@
 #include "Optimization/Riemannian/TNT.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
 
 namespace SESync {
 
+namespace {
+
+/** Returns true if cancellation of the SE-Sync run configured by 'options' has
+ * been requested via its monitor */
+bool cancellation_requested(const SESyncOpts &options) {
+  return options.monitor && options.monitor->cancellation_requested();
+}
+
+/** Returns the running operation counts of 'problem' */
+SESyncOperationCounts operation_counts(const SESyncProblem &problem) {
+  SESyncOperationCounts counts;
+  counts.data_matrix_products = problem.num_data_matrix_products();
+  counts.linear_solves = problem.num_linear_solves();
+  counts.LOBPCG_operator_applications =
+      problem.num_LOBPCG_operator_applications();
+  return counts;
+}
+
+/** Returns the operation counts accrued between 'start' and 'end' */
+SESyncOperationCounts
+operation_counts_between(const SESyncOperationCounts &start,
+                         const SESyncOperationCounts &end) {
+  SESyncOperationCounts counts;
+  counts.data_matrix_products =
+      end.data_matrix_products - start.data_matrix_products;
+  counts.linear_solves = end.linear_solves - start.linear_solves;
+  counts.LOBPCG_operator_applications =
+      end.LOBPCG_operator_applications - start.LOBPCG_operator_applications;
+  return counts;
+}
+
+/** Solves each of the num_components subgraphs of the problem defined by
+ * 'measurements' (where 'component' contains the index of the component
+ * containing each state) as an independent problem, and combines their
+ * results.  The measurements between different components must be bridges of
+ * the pose graph; the components' solutions are composed along these so that
+ * each of them is satisfied exactly. */
+SESyncResult solve_components(const measurements_t &measurements,
+                              const SESyncOpts &options,
+                              const std::vector<size_t> &component,
+                              size_t num_components) {
+  auto start_time = Stopwatch::tick();
+
+  size_t d = measurements[0].R.rows();
+  size_t n = component.size();
+
+  // The aggregate progress of the components, as reported to the caller's
+  // monitor (if any).  This is only ever published from the calling thread;
+  // the components' runs report to their own monitors (cf. SESyncBatch).
+  SESyncProgress progress;
+  auto report_progress = [&](SESyncPhase phase) {
+    if (options.monitor) {
+      progress.phase = phase;
+      progress.elapsed_time = Stopwatch::tock(start_time);
+      options.monitor->publish(progress);
+    }
+  };
+
+  SESyncResult result;
+  std::vector<measurements_t> subgraphs = split_measurements(
+      measurements, component, num_components, result.component_states);
+
+  // The measurements joining different components
+  measurements_t bridges;
+  for (const RelativePoseMeasurement &measurement : measurements)
+    if (component[measurement.i] != component[measurement.j])
+      bridges.push_back(measurement);
+  result.num_bridges = bridges.size();
+
+  if (options.verbose)
+    std::cout << "Pose graph contains " << num_components << " "
+              << (bridges.empty() ? "connected" : "2-edge-connected")
+              << " components (" << bridges.size()
+              << " bridges); solving them independently" << std::endl;
+
+  // States that do not appear in any measurement form trivial components,
+  // which need not be solved
+  std::vector<size_t> nontrivial;
+  std::vector<measurements_t> problems;
+  for (size_t c = 0; c < num_components; ++c)
+    if (!subgraphs[c].empty()) {
+      nontrivial.push_back(c);
+      problems.push_back(std::move(subgraphs[c]));
+    }
+
+  // The components' runs are interleaved, so their own output is suppressed.
+  // Their share of the caller's monitor is limited to its cancellation, which
+  // SESyncBatch forwards to each run's private monitor.
+  SESyncOpts component_opts = options;
+  component_opts.decompose_components = false;
+  component_opts.eliminate_bridges = false;
+  component_opts.detect_planar_problems = false; // Already tested
+  component_opts.iterate_log_file.clear();
+  component_opts.verbose = false;
+
+  // Unless specified otherwise, the components share the caller's allotment
+  // of threads
+  SESyncBatchOpts batch_opts;
+  batch_opts.num_threads = (options.component_threads > 0
+                                ? options.component_threads
+                                : std::max<size_t>(options.num_threads, 1));
+  batch_opts.verbose = options.verbose;
+  report_progress(SESyncPhase::Optimization);
+  SESyncBatchResult batch_result =
+      SESyncBatch(problems, component_opts, batch_opts);
+  report_progress(SESyncPhase::Rounding);
+
+  // Y contains translations only in the explicit formulation, while xhat
+  // contains them in every formulation except SOSync
+  bool Y_has_translations = (options.formulation == Formulation::Explicit);
+  bool x_has_translations = (options.formulation != Formulation::SOSync);
+
+  result.component_results.resize(num_components);
+  for (size_t k = 0; k < nontrivial.size(); ++k)
+    result.component_results[nontrivial[k]] =
+        std::move(batch_result.results[k]);
+  for (size_t c = 0; c < num_components; ++c) {
+    if (!result.component_results[c].Yopt.size()) {
+      // A single unconstrained state, which we place at the origin
+      SESyncResult &trivial = result.component_results[c];
+      trivial.Yopt = Matrix::Zero(d, (Y_has_translations ? 1 : 0) + d);
+      trivial.Yopt.rightCols(d).setIdentity();
+      trivial.xhat = Matrix::Zero(d, (x_has_translations ? 1 : 0) + d);
+      trivial.xhat.rightCols(d).setIdentity();
+      trivial.Lambda.resize(d, d);
+      trivial.SDPval = trivial.gradnorm = trivial.trLambda =
+          trivial.duality_gap = trivial.Fxhat = trivial.suboptimality_bound =
+              0;
+      trivial.total_computation_time = trivial.initialization_time = 0;
+      trivial.status = GlobalOpt;
+    }
+  }
+
+  /// Assemble the combined solution
+
+  size_t r = 0;
+  for (const SESyncResult &component_result : result.component_results)
+    r = std::max<size_t>(r, component_result.Yopt.rows());
+
+  // Each component's solution is determined only up to the action of a
+  // global symmetry, which we fix (relative to the component's own solution)
+  // by composing the components along the bridges: the lifted poses
+  // [c_Y + U_Y t_i, U_Y Y_i] of a component are related to its own (padded)
+  // rank-r solution by an orthogonal transformation U_Y in O(r) and an offset
+  // c_Y, and its rounded poses by a rigid transformation (G_x, c_x) in SE(d).
+  std::vector<Matrix> U_Y(num_components, Matrix::Identity(r, r));
+  std::vector<Vector> c_Y(num_components, Vector::Zero(r));
+  std::vector<Matrix> G_x(num_components, Matrix::Identity(d, d));
+  std::vector<Vector> c_x(num_components, Vector::Zero(d));
+
+  // Returns the (transformed) lifted translation and rotation of state i
+  auto lifted_pose = [&](size_t i, Vector &t, Matrix &Y) {
+    size_t c = component[i];
+    const SESyncResult &component_result = result.component_results[c];
+    const std::vector<size_t> &states = result.component_states[c];
+    size_t nc = states.size();
+    size_t k = std::lower_bound(states.begin(), states.end(), i) -
+               states.begin();
+    size_t rc = component_result.Yopt.rows();
+
+    Matrix Yi = Matrix::Zero(r, d);
+    Yi.topRows(rc) =
+        component_result.Yopt.middleCols((Y_has_translations ? nc : 0) + d * k,
+                                         d);
+    Y = U_Y[c] * Yi;
+
+    t = c_Y[c];
+    if (Y_has_translations)
+      t += U_Y[c].leftCols(rc) * component_result.Yopt.col(k);
+  };
+
+  // Returns the (transformed) rounded translation and rotation of state i
+  auto rounded_pose = [&](size_t i, Vector &t, Matrix &R) {
+    size_t c = component[i];
+    const SESyncResult &component_result = result.component_results[c];
+    const std::vector<size_t> &states = result.component_states[c];
+    size_t nc = states.size();
+    size_t k = std::lower_bound(states.begin(), states.end(), i) -
+               states.begin();
+
+    R = G_x[c] *
+        component_result.xhat.middleCols((x_has_translations ? nc : 0) + d * k,
+                                         d);
+    t = c_x[c];
+    if (x_has_translations)
+      t += G_x[c] * component_result.xhat.col(k);
+  };
+
+  if (!bridges.empty()) {
+    // Traverse the tree of components joined by the bridges breadth-first,
+    // composing each newly-reached component with its parent along the bridge
+    // joining them
+    std::vector<std::vector<size_t>> incident(num_components);
+    for (size_t b = 0; b < bridges.size(); ++b) {
+      incident[component[bridges[b].i]].push_back(b);
+      incident[component[bridges[b].j]].push_back(b);
+    }
+
+    std::vector<bool> placed(num_components, false);
+    std::vector<size_t> frontier;
+    for (size_t root = 0; root < num_components; ++root) {
+      if (placed[root])
+        continue;
+      placed[root] = true;
+      frontier.push_back(root);
+
+      for (size_t f = 0; f < frontier.size(); ++f)
+        for (size_t b : incident[frontier[f]]) {
+          const RelativePoseMeasurement &bridge = bridges[b];
+          bool forward = (component[bridge.i] == frontier[f]);
+          size_t anchor = (forward ? bridge.i : bridge.j);
+          size_t other = (forward ? bridge.j : bridge.i);
+          size_t c = component[other];
+          if (placed[c])
+            continue;
+
+          // Desired lifted pose of the other state:
+          //   Y_j = Y_i R_ij,  t_j = t_i + Y_i t_ij  (forward)
+          //   Y_i = Y_j R_ij^T,  t_i = t_j - Y_i t_ij  (backward)
+          Vector t_anchor, t_other;
+          Matrix Y_anchor, Y_other;
+          lifted_pose(anchor, t_anchor, Y_anchor);
+          lifted_pose(other, t_other, Y_other);
+          Matrix Y_target =
+              Y_anchor * (forward ? bridge.R : Matrix(bridge.R.transpose()));
+          Vector t_target = (forward ? Vector(t_anchor + Y_anchor * bridge.t)
+                                     : Vector(t_anchor - Y_target * bridge.t));
+
+          // Since Y_other and Y_target both have orthonormal columns, the
+          // solution U of the orthogonal Procrustes problem
+          // min |U Y_other - Y_target| maps the former exactly onto the latter
+          Eigen::JacobiSVD<Matrix> svd(Y_target * Y_other.transpose(),
+                                       Eigen::ComputeFullU |
+                                           Eigen::ComputeFullV);
+          // (Note that the transformations of a component that has not yet
+          // been placed are the identity)
+          U_Y[c] = svd.matrixU() * svd.matrixV().transpose();
+          if (Y_has_translations)
+            c_Y[c] = t_target - U_Y[c] * t_other;
+
+          // Likewise for the rounded poses, using the corresponding rigid
+          // transformation in SE(d)
+          Vector x_anchor_t, x_other_t;
+          Matrix x_anchor_R, x_other_R;
+          rounded_pose(anchor, x_anchor_t, x_anchor_R);
+          rounded_pose(other, x_other_t, x_other_R);
+          Matrix R_target =
+              x_anchor_R *
+              (forward ? bridge.R : Matrix(bridge.R.transpose()));
+          Vector x_target_t =
+              (forward ? Vector(x_anchor_t + x_anchor_R * bridge.t)
+                       : Vector(x_anchor_t - R_target * bridge.t));
+          G_x[c] = R_target * x_other_R.transpose();
+          if (x_has_translations)
+            c_x[c] = x_target_t - G_x[c] * x_other_t;
+
+          placed[c] = true;
+          frontier.push_back(c);
+        }
+      frontier.clear();
+    }
+  }
+
+  size_t Y_rot_offset = (Y_has_translations ? n : 0);
+  size_t x_rot_offset = (x_has_translations ? n : 0);
+  result.Yopt = Matrix::Zero(r, Y_rot_offset + d * n);
+  result.xhat = Matrix::Zero(d, x_rot_offset + d * n);
+
+  std::vector<Eigen::Triplet<Scalar>> Lambda_triplets;
+  Scalar gradnorm_squared = 0;
+  result.SDPval = result.trLambda = result.duality_gap = 0;
+  result.initialization_time = 0;
+  result.status = GlobalOpt;
+
+  for (size_t c = 0; c < num_components; ++c) {
+    const SESyncResult &component_result = result.component_results[c];
+    const std::vector<size_t> &states = result.component_states[c];
+
+    for (size_t i : states) {
+      Vector t;
+      Matrix R;
+
+      lifted_pose(i, t, R);
+      if (Y_has_translations)
+        result.Yopt.col(i) = t;
+      result.Yopt.middleCols(Y_rot_offset + d * i, d) = R;
+
+      rounded_pose(i, t, R);
+      if (x_has_translations)
+        result.xhat.col(i) = t;
+      result.xhat.middleCols(x_rot_offset + d * i, d) = R;
+    }
+
+    // Lambda is block-diagonal, with one d x d block per state
+    for (int j = 0; j < component_result.Lambda.outerSize(); ++j)
+      for (SparseMatrix::InnerIterator it(component_result.Lambda, j); it;
+           ++it)
+        Lambda_triplets.emplace_back(d * states[it.row() / d] + it.row() % d,
+                                     d * states[it.col() / d] + it.col() % d,
+                                     it.value());
+
+    result.SDPval += component_result.SDPval;
+    gradnorm_squared += component_result.gradnorm * component_result.gradnorm;
+    result.trLambda += component_result.trLambda;
+    result.duality_gap += component_result.duality_gap;
+
+    if (result.status == GlobalOpt && component_result.status != GlobalOpt)
+      result.status = component_result.status;
+  }
+
+  result.gradnorm = std::sqrt(gradnorm_squared);
+  result.Lambda.resize(d * n, d * n);
+  result.Lambda.setFromTriplets(Lambda_triplets.begin(), Lambda_triplets.end());
+
+  // The objective is the sum of the components' objectives and the
+  // (nonnegative) bridge terms, and the combined certificate matrix is the sum
+  // of the components' certificate matrices and the (positive-semidefinite)
+  // bridge terms of the data matrix.  Since the bridges are satisfied exactly
+  // by the combined solution, tr(Lambda) is therefore a lower bound on the
+  // optimal value of the entire problem whenever every component is
+  // certified.
+  result.Fxhat = evaluate_objective(measurements, result.xhat);
+  result.suboptimality_bound = result.Fxhat - result.trLambda;
+
+  result.total_computation_time = Stopwatch::tock(start_time);
+  result.telemetry.total_time = result.total_computation_time;
+
+  progress.objective_value = result.SDPval;
+  progress.gradient_norm = result.gradnorm;
+  report_progress(SESyncPhase::Finished);
+
+  if (options.verbose) {
+    size_t num_certified = 0;
+    for (const SESyncResult &component_result : result.component_results)
+      num_certified += (component_result.status == GlobalOpt);
+    std::cout << "Solved " << num_components << " components ("
+              << num_certified << " certified) in "
+              << result.total_computation_time << " seconds" << std::endl
+              << "Value of combined rounded pose estimates F(x): "
+              << result.Fxhat << std::endl
+              << "Suboptimality bound of combined estimates: "
+              << result.suboptimality_bound << std::endl
+              << std::endl;
+  }
+
+  return result;
+}
+
+} // namespace
+
 SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
                     const Matrix &Y0) {
 
@@ -32,6 +389,10 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
     throw std::invalid_argument("Numerical tolerance for minimum eigenvalue "
                                 "nonnegativity must be a positive value");
 
+  if (options.rank_tol <= 0 || options.rank_tol >= 1)
+    throw std::invalid_argument("Numerical rank tolerance must be a value in "
+                                "the range (0, 1)");
+
   if (options.LOBPCG_block_size < 1)
     throw std::invalid_argument("LOBPCG block size must be a positive integer");
 
@@ -47,6 +408,10 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
     throw std::invalid_argument(
         "Maximum number of LOBPCG iterations must be a positive value");
 
+  if (options.iterate_log_stride < 1)
+    throw std::invalid_argument(
+        "Iterate logging stride must be a positive integer");
+
   /// ALGORITHM DATA
 
   // The current iterate in the Riemannian Staircase
@@ -101,10 +466,18 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
                 << " decomposition to compute orthogonal projections"
                 << std::endl;
     }
-    std::cout << " Initialization method: "
-              << (options.initialization == Initialization::Chordal ? "chordal"
-                                                                    : "random")
-              << std::endl;
+    std::cout << " Initialization method: ";
+    if (options.initialization == Initialization::Chordal)
+      std::cout << "chordal";
+    else if (options.initialization == Initialization::Random)
+      std::cout << "random";
+    else if (options.initialization == Initialization::Spectral)
+      std::cout << "spectral";
+    else if (options.initialization == Initialization::SOSyncCascade)
+      std::cout << "rotation-first (SO-Sync) cascade";
+    else // initialization == Multilevel
+      std::cout << "multilevel";
+    std::cout << std::endl;
     if (options.log_iterates)
       std::cout << " Logging entire sequence of Riemannian Staircase iterates"
                 << std::endl;
@@ -155,6 +528,33 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
   omp_set_num_threads(options.num_threads);
 #endif
 
+  // Operation counts at the start of the run, and at the start of each level
+  // of the Riemannian Staircase
+  SESyncOperationCounts initial_counts = operation_counts(problem);
+  std::vector<SESyncOperationCounts> level_start_counts;
+
+  // Likewise for the kernel profile (if kernel counters are enabled)
+  KernelProfile initial_kernel_profile = kernel_profile();
+  std::vector<KernelProfile> level_start_kernel_profiles;
+
+  SESyncTelemetry &telemetry = sesync_result.telemetry;
+  telemetry.projection_factorization_time =
+      problem.projection_factorization_time();
+  telemetry.preconditioner_norm_estimate_time =
+      problem.preconditioner_norm_estimate_time();
+  telemetry.preconditioner_factorization_time =
+      problem.preconditioner_factorization_time();
+
+  // The progress of the algorithm, as reported to the monitor (if any)
+  SESyncProgress progress;
+  auto report_progress = [&](SESyncPhase phase) {
+    if (options.monitor) {
+      progress.phase = phase;
+      progress.elapsed_time = Stopwatch::tock(SESync_start_time);
+      options.monitor->publish(progress);
+    }
+  };
+
   /// SET UP OPTIMIZATION
 
   /// Function handles required by the TNT optimization algorithm
@@ -217,9 +617,50 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
     precon = precon_op;
   }
 
+  // Writer used to stream iterates to disk, if requested
+  std::unique_ptr<IterateWriter> iterate_writer;
+  if (!options.iterate_log_file.empty())
+    iterate_writer = std::make_unique<IterateWriter>(
+        options.iterate_log_file, options.iterate_log_single_precision);
+
+  // User function: if a monitor is attached or iterates are being streamed to
+  // disk, we wrap the user-supplied function (if any) in order to record each
+  // iterate, publish the progress of the trust-region method, and poll for
+  // cancellation, after each iteration
+  std::optional<SESyncTNTUserFunction> user_function = options.user_function;
+  if (options.monitor || iterate_writer) {
+    user_function =
+        [&](double t, const Matrix &Y, Scalar f, const Matrix &grad,
+            const Optimization::Riemannian::LinearOperator<Matrix, Matrix,
+                                                           Matrix> &HessOp,
+            Scalar Delta, size_t num_STPCG_iters, const Matrix &h, Scalar df,
+            Scalar rho, bool accepted, Matrix &NablaF_Y) {
+          size_t k = progress.iteration++;
+          if (iterate_writer && k % options.iterate_log_stride == 0)
+            iterate_writer->write(progress.level, k, t, f, Y);
+
+          progress.objective_value = f;
+          progress.gradient_norm = grad.norm();
+          report_progress(SESyncPhase::Optimization);
+
+          bool stop = options.user_function &&
+                      (*options.user_function)(t, Y, f, grad, HessOp, Delta,
+                                               num_STPCG_iters, h, df, rho,
+                                               accepted, NablaF_Y);
+          return stop || cancellation_requested(options);
+        };
+  }
+
+  // Used to abandon the computations that run outside of TNT (LOBPCG and the
+  // saddle escape line search) as soon as cancellation is requested
+  std::function<bool()> interrupt = [&options]() {
+    return cancellation_requested(options);
+  };
+
   /// INITIALIZATION
   if (options.verbose)
     std::cout << "INITIALIZATION:" << std::endl;
+  report_progress(SESyncPhase::Initialization);
 
   problem.set_relaxation_rank(options.r0);
 
@@ -241,14 +682,238 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
         std::cout << "elapsed computation time: " << chordal_init_elapsed_time
                   << " seconds" << std::endl;
 
-    } else {
+    } else if (options.initialization == Initialization::Spectral) {
+      if (options.verbose)
+        std::cout << " Computing spectral initialization ... ";
+
+      auto spectral_init_start_time = Stopwatch::tick();
+      Y = problem.spectral_initialization(options.spectral_init_max_iterations,
+                                          options.spectral_init_tol, interrupt);
+      double spectral_init_elapsed_time =
+          Stopwatch::tock(spectral_init_start_time);
+      if (options.verbose)
+        std::cout << "elapsed computation time: " << spectral_init_elapsed_time
+                  << " seconds" << std::endl;
+
+    } else if (options.initialization == Initialization::SOSyncCascade &&
+               problem.formulation() != Formulation::SOSync) {
+      if (options.verbose)
+        std::cout << " Computing rotation-first (SO-Sync) cascade "
+                     "initialization ... "
+                  << std::endl;
+
+      // Construct the rotation synchronization problem determined by the
+      // rotational data
+      auto cascade_construction_start_time = Stopwatch::tick();
+      SESyncProblem rotation_problem(
+          problem.measurements(), Formulation::SOSync,
+          problem.projection_factorization(), problem.preconditioner(),
+          problem.regularized_Cholesky_preconditioner_max_condition());
+      sesync_result.cascade_construction_time =
+          Stopwatch::tock(cascade_construction_start_time);
+
+      // Solve the rotation synchronization problem to a loose tolerance
+      SESyncOpts rotation_opts = options;
+      rotation_opts.formulation = Formulation::SOSync;
+      rotation_opts.initialization = Initialization::Chordal;
+      rotation_opts.grad_norm_tol = options.cascade_grad_norm_tol;
+      rotation_opts.preconditioned_grad_norm_tol =
+          options.cascade_preconditioned_grad_norm_tol;
+      rotation_opts.rel_func_decrease_tol =
+          options.cascade_rel_func_decrease_tol;
+      rotation_opts.max_computation_time =
+          options.max_computation_time - Stopwatch::tock(SESync_start_time);
+      rotation_opts.user_function = std::nullopt;
+      rotation_opts.log_iterates = false;
+      rotation_opts.iterate_log_file.clear();
+      rotation_opts.verbose = false;
+      // The inner solve must not publish its own progress (in particular, its
+      // Finished phase) to the caller's monitor, but should still honor its
+      // cancellation
+      rotation_opts.monitor = SESyncMonitor::child(options.monitor);
+
+      auto cascade_rotation_start_time = Stopwatch::tick();
+      SESyncResult rotation_result = SESync(rotation_problem, rotation_opts);
+      sesync_result.cascade_rotation_time =
+          Stopwatch::tock(cascade_rotation_start_time);
+
+      // Lift the estimated rotations (recovering the corresponding optimal
+      // translations, if required) to construct the initial iterate
+      auto cascade_lifting_start_time = Stopwatch::tick();
+      Y = problem.lift_rotations(rotation_result.xhat);
+      sesync_result.cascade_lifting_time =
+          Stopwatch::tock(cascade_lifting_start_time);
+
+      if (options.verbose) {
+        std::cout << "  Rotation synchronization problem construction: "
+                  << sesync_result.cascade_construction_time << " seconds"
+                  << std::endl;
+        std::cout << "  Rotation synchronization solve ("
+                  << rotation_result.function_values.size()
+                  << " Staircase levels, F(R) = " << rotation_result.Fxhat
+                  << "): " << sesync_result.cascade_rotation_time << " seconds"
+                  << std::endl;
+        std::cout << "  Lifting rotation estimates: "
+                  << sesync_result.cascade_lifting_time << " seconds"
+                  << std::endl;
+      }
+    } else if (options.initialization == Initialization::Multilevel) {
       if (options.verbose)
-        std::cout << " Sampling a random initialization ... " << std::endl;
-      Y = problem.random_sample();
+        std::cout << " Computing multilevel initialization ... " << std::endl;
+
+      // Construct the hierarchy of coarsened problems: coarse_measurements[l]
+      // contains the measurements of the (l+1)st level, whose states are
+      // obtained by contracting those of the lth level according to
+      // clusters[l] and offsets[l]
+      auto multilevel_coarsening_start_time = Stopwatch::tick();
+      std::vector<measurements_t> coarse_measurements;
+      std::vector<std::vector<size_t>> clusters;
+      std::vector<std::vector<Matrix>> offsets;
+      std::vector<size_t> &num_states = sesync_result.multilevel_num_states;
+      num_states.assign(1, problem.num_states());
+
+      while (num_states.back() > options.multilevel_coarsest_size &&
+             coarse_measurements.size() < options.multilevel_max_levels &&
+             !cancellation_requested(options)) {
+        std::vector<size_t> level_clusters;
+        std::vector<Matrix> level_offsets;
+        measurements_t level_measurements = coarsen_measurements(
+            coarse_measurements.empty() ? problem.measurements()
+                                        : coarse_measurements.back(),
+            level_clusters, level_offsets);
+        size_t nc = (level_measurements.empty()
+                         ? 0
+                         : *std::max_element(level_clusters.begin(),
+                                             level_clusters.end()) +
+                               1);
+
+        // Stop if the coarsened problem is degenerate, or if coarsening has
+        // stalled (e.g. on star-like subgraphs, in which few states can be
+        // matched)
+        if (nc < 2 || nc > (1 - options.multilevel_min_reduction) *
+                               num_states.back())
+          break;
+
+        coarse_measurements.push_back(std::move(level_measurements));
+        clusters.push_back(std::move(level_clusters));
+        offsets.push_back(std::move(level_offsets));
+        num_states.push_back(nc);
+      }
+      sesync_result.multilevel_coarsening_time =
+          Stopwatch::tock(multilevel_coarsening_start_time);
+
+      if (coarse_measurements.empty()) {
+        // The problem is already small enough (or cannot be coarsened), so the
+        // multilevel initialization reduces to the chordal initialization
+        if (options.verbose)
+          std::cout << "  Problem cannot be coarsened; computing chordal "
+                       "initialization ... "
+                    << std::endl;
+        Y = problem.chordal_initialization();
+      } else {
+        // Solve the coarsest problem to a loose tolerance
+        SESyncOpts coarse_opts = options;
+        coarse_opts.formulation = problem.formulation();
+        coarse_opts.initialization = Initialization::Chordal;
+        coarse_opts.grad_norm_tol = options.cascade_grad_norm_tol;
+        coarse_opts.preconditioned_grad_norm_tol =
+            options.cascade_preconditioned_grad_norm_tol;
+        coarse_opts.rel_func_decrease_tol =
+            options.cascade_rel_func_decrease_tol;
+        coarse_opts.max_computation_time =
+            options.max_computation_time - Stopwatch::tock(SESync_start_time);
+        coarse_opts.user_function = std::nullopt;
+        coarse_opts.log_iterates = false;
+        coarse_opts.iterate_log_file.clear();
+        coarse_opts.verbose = false;
+        // The nested runs must not publish their own progress to the caller's
+        // monitor, but should still honor its cancellation
+        coarse_opts.monitor = SESyncMonitor::child(options.monitor);
+
+        auto multilevel_coarse_solve_start_time = Stopwatch::tick();
+        SESyncResult coarse_result =
+            SESync(coarse_measurements.back(), coarse_opts);
+        sesync_result.multilevel_coarse_solve_time =
+            Stopwatch::tock(multilevel_coarse_solve_start_time);
+
+        // Prolong the estimates through the hierarchy, refining them at each
+        // intermediate level using a limited number of iterations at the
+        // initial rank of the Staircase.  Only the rounded estimates of these
+        // refinements are used, so they are neither verified nor run in
+        // hard-deadline mode (which would round every iterate)
+        auto multilevel_refinement_start_time = Stopwatch::tick();
+        SESyncOpts refinement_opts = coarse_opts;
+        refinement_opts.rmax = options.r0;
+        refinement_opts.verify = false;
+        refinement_opts.hard_deadline = false;
+        refinement_opts.max_iterations =
+            options.multilevel_refinement_iterations;
+
+        Matrix X = coarse_result.xhat;
+        size_t d = problem.dimension();
+        for (size_t l = coarse_measurements.size(); l-- > 0;) {
+          X = prolong_poses(X, clusters[l], offsets[l]);
+          if (l == 0)
+            break;
+
+          // If cancelled, only prolong the remaining estimates (which is
+          // cheap), so that the Staircase can still return their rounding
+          if (cancellation_requested(options))
+            continue;
+
+          SESyncProblem level_problem(
+              coarse_measurements[l - 1], problem.formulation(),
+              problem.projection_factorization(), problem.preconditioner(),
+              problem.regularized_Cholesky_preconditioner_max_condition());
+          level_problem.set_relaxation_rank(options.r0);
+          refinement_opts.max_computation_time =
+              options.max_computation_time - Stopwatch::tock(SESync_start_time);
+          X = SESync(level_problem, refinement_opts,
+                     level_problem.lift_rotations(
+                         X.rightCols(d * level_problem.num_states())))
+                  .xhat;
+        }
+
+        // Lift the estimated rotations (recovering the corresponding optimal
+        // translations, if required) to construct the initial iterate
+        Y = problem.lift_rotations(X.rightCols(d * problem.num_states()));
+        sesync_result.multilevel_refinement_time =
+            Stopwatch::tock(multilevel_refinement_start_time);
+
+        if (options.verbose) {
+          std::cout << "  Coarsening (" << num_states.size() << " levels, ";
+          for (size_t l = 0; l < num_states.size(); ++l)
+            std::cout << (l > 0 ? " -> " : "") << num_states[l];
+          std::cout << " states): " << sesync_result.multilevel_coarsening_time
+                    << " seconds" << std::endl;
+          std::cout << "  Coarsest problem solve ("
+                    << coarse_result.function_values.size()
+                    << " Staircase levels, F(x) = " << coarse_result.Fxhat
+                    << "): " << sesync_result.multilevel_coarse_solve_time
+                    << " seconds" << std::endl;
+          std::cout << "  Prolongation and refinement: "
+                    << sesync_result.multilevel_refinement_time << " seconds"
+                    << std::endl;
+        }
+      }
+    } else {
+      if (options.initialization == Initialization::Random) {
+        if (options.verbose)
+          std::cout << " Sampling a random initialization ... " << std::endl;
+        Y = problem.random_sample();
+      } else {
+        // Initialization == SOSyncCascade, but we are already solving a
+        // rotation synchronization problem, so the cascade reduces to the
+        // chordal initialization
+        if (options.verbose)
+          std::cout << " Computing chordal initialization ... " << std::endl;
+        Y = problem.chordal_initialization();
+      }
     }
   }
 
   sesync_result.initialization_time = Stopwatch::tock(SESync_start_time);
+  telemetry.initialization_time = sesync_result.initialization_time;
   if (options.verbose)
     std::cout << " SE-Sync initialization finished; elapsed time: "
               << sesync_result.initialization_time << " seconds" << std::endl
@@ -276,9 +941,98 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
   params.log_iterates = options.log_iterates;
   params.verbose = options.verbose;
 
+  /// Hard-deadline mode
+
+  // Evaluate the objective at a rounded solution xhat.  Note that since xhat
+  // contains the *complete* set of pose estimates, we must extract only the
+  // *rotational* elements of xhat if the SE synchronization problem was solved
+  // using the simplified formulation
+  auto rounded_objective = [&problem](const Matrix &xhat) {
+    return (problem.formulation() == Formulation::Simplified
+                ? problem.evaluate_objective(xhat.block(
+                      0, problem.num_states(), problem.dimension(),
+                      problem.dimension() * problem.num_states()))
+                : problem.evaluate_objective(xhat));
+  };
+
+  // The rounded candidate solution with the lowest objective value found so
+  // far
+  Matrix best_xhat;
+  Scalar best_Fxhat = std::numeric_limits<Scalar>::infinity();
+
+  // The largest observed cost of rounding a candidate, and the cost of
+  // computing the Lagrange multipliers Lambda
+  double rounding_cost = 0;
+  double Lambda_cost = 0;
+
+  // Round the candidate Y, and retain it if it improves upon the best
+  // candidate found so far
+  auto update_best_candidate = [&](const Matrix &Y) {
+    auto candidate_start_time = Stopwatch::tick();
+    Matrix xhat = problem.round_solution(Y);
+    Scalar Fxhat = rounded_objective(xhat);
+    if (Fxhat < best_Fxhat) {
+      best_xhat = xhat;
+      best_Fxhat = Fxhat;
+    }
+    double candidate_time = Stopwatch::tock(candidate_start_time);
+    rounding_cost = std::max(rounding_cost, candidate_time);
+    telemetry.rounding_time += candidate_time;
+    sesync_result.rounding_reserve_time =
+        options.deadline_reserve_factor * (rounding_cost + Lambda_cost);
+  };
+
+  // The computation time remaining before the deadline, after reserving time
+  // for post-processing
+  auto remaining_time = [&]() {
+    return options.max_computation_time - Stopwatch::tock(SESync_start_time) -
+           sesync_result.rounding_reserve_time;
+  };
+
+  if (options.hard_deadline) {
+    // Round the initial iterate: this provides a fallback candidate solution,
+    // together with an estimate of the cost of post-processing
+    auto Lambda_start_time = Stopwatch::tick();
+    problem.compute_Lambda_blocks(Y);
+    Lambda_cost = Stopwatch::tock(Lambda_start_time);
+    update_best_candidate(Y);
+
+    if (options.verbose)
+      std::cout << "Hard deadline: reserving "
+                << sesync_result.rounding_reserve_time
+                << " seconds for post-processing; objective value of rounded "
+                   "initial iterate: "
+                << best_Fxhat << std::endl;
+  }
+
+  // Partition the problem for block-coordinate descent, if requested
+  std::unique_ptr<BlockCoordinateDescent> bcd;
+  if (options.local_optimizer == LocalOptimizer::BlockCoordinateDescent) {
+    if (problem.formulation() != Formulation::Simplified) {
+      bcd = std::make_unique<BlockCoordinateDescent>(problem,
+                                                     options.bcd_block_size);
+      if (options.verbose)
+        std::cout << "Using block-coordinate descent with "
+                  << bcd->num_blocks() << " blocks (" << bcd->num_colors()
+                  << " colors)" << std::endl;
+    } else if (options.verbose)
+      std::cout << "Block-coordinate descent is not available for the "
+                   "Simplified formulation; using the trust-region method"
+                << std::endl;
+  }
+
   auto riemannian_staircase_start_time = Stopwatch::tick();
 
-  for (size_t r = options.r0; r <= options.rmax; r++) {
+  // The objective value at the most recent critical point verified at each
+  // relaxation rank to which the Staircase has descended (cf.
+  // SESyncOpts::reduce_rank)
+  std::map<size_t, Scalar> reduced_rank_values;
+
+  // Note that the relaxation rank may increase by more than 1 between
+  // successive levels of the Staircase when escaping from a saddle point along
+  // multiple directions of negative curvature
+  for (size_t r = options.r0; r <= options.rmax;
+       r = problem.relaxation_rank()) {
     // The elapsed time from the start of the Riemannian Staircase algorithm
     // until the start of this iteration of RTR
     double RTR_iteration_start_time =
@@ -286,15 +1040,33 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
 
     /// Test temporal stopping condition
 
-    if (RTR_iteration_start_time >= options.max_computation_time) {
+    if (options.hard_deadline ? remaining_time() <= 0
+                              : RTR_iteration_start_time >=
+                                    options.max_computation_time) {
       sesync_result.status = ElapsedTime;
       break;
     }
 
+    if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    }
+
+    progress.level = r;
+    progress.iteration = 0;
+    report_progress(SESyncPhase::Optimization);
+
+    telemetry.levels.emplace_back();
+    telemetry.levels.back().relaxation_rank = r;
+    level_start_counts.push_back(operation_counts(problem));
+    level_start_kernel_profiles.push_back(kernel_profile());
+
     // Set  maximum permitted computation time for this level of the
     // Riemannian Staircase
     params.max_computation_time =
-        options.max_computation_time - RTR_iteration_start_time;
+        (options.hard_deadline
+             ? remaining_time()
+             : options.max_computation_time - RTR_iteration_start_time);
 
     if (options.verbose)
       std::cout << std::endl
@@ -305,15 +1077,53 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
 
     /// Run optimization!
     Optimization::Riemannian::TNTResult<Matrix, Scalar> tnt_result =
-        Optimization::Riemannian::TNT<Matrix, Matrix, Scalar, Matrix>(
-            F, QM, metric, retraction, Y, NablaF_Y, precon, params,
-            options.user_function);
+        (bcd ? bcd->optimize(Y, params, options.bcd_local_iterations,
+                             user_function)
+             : Optimization::Riemannian::TNT<Matrix, Matrix, Scalar, Matrix>(
+                   F, QM, metric, retraction, Y, NablaF_Y, precon, params,
+                   user_function));
 
     // Extract the results
     sesync_result.Yopt = tnt_result.x;
     sesync_result.SDPval = tnt_result.f;
+
+    // Record the relaxation rank at this level
+    sesync_result.relaxation_ranks.push_back(r);
+
+    // Compute the numerical rank of this level's critical point, and if it is
+    // rank-deficient (and rank reduction is enabled), drop its redundant rows
+    // and descend to the corresponding level of the Staircase.  To prevent the
+    // Staircase from alternating indefinitely between escaping from and
+    // descending back to the same rank, it only returns to a rank that it has
+    // previously descended to if the objective has decreased sufficiently
+    // (relative to rel_func_decrease_tol) since then.
+    Matrix Ytrunc = sesync_result.Yopt;
+    size_t numerical_rank = truncate_to_numerical_rank(
+        Ytrunc, options.rank_tol, problem.dimension());
+    auto previous_visit = reduced_rank_values.find(numerical_rank);
+    bool sufficient_decrease =
+        previous_visit == reduced_rank_values.end() ||
+        sesync_result.SDPval <
+            previous_visit->second - options.rel_func_decrease_tol *
+                                         std::fabs(previous_visit->second);
+    if (options.reduce_rank && numerical_rank < r && sufficient_decrease) {
+      if (options.verbose)
+        std::cout << "Critical point has numerical rank " << numerical_rank
+                  << "; reducing relaxation rank from " << r << " to "
+                  << numerical_rank << std::endl;
+      problem.set_relaxation_rank(numerical_rank);
+      r = numerical_rank;
+      // Restore the feasibility of the truncated point (discarding rows of
+      // negligible norm perturbs its Stiefel blocks only slightly)
+      sesync_result.Yopt =
+          problem.retract(Ytrunc, Matrix::Zero(Ytrunc.rows(), Ytrunc.cols()));
+      sesync_result.SDPval = problem.evaluate_objective(sesync_result.Yopt);
+      reduced_rank_values[r] = sesync_result.SDPval;
+    }
     sesync_result.gradnorm =
         problem.Riemannian_gradient(sesync_result.Yopt).norm();
+    sesync_result.numerical_ranks.push_back(numerical_rank);
+    telemetry.levels.back().optimization_time = tnt_result.elapsed_time;
 
     // Record sequence of function values
     sesync_result.function_values.push_back(tnt_result.objective_values);
@@ -345,12 +1155,27 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
     if (options.log_iterates)
       sesync_result.iterates.push_back(tnt_result.iterates);
 
+    // Round this level's estimate as a candidate solution (the time needed to
+    // do so has already been reserved)
+    if (options.hard_deadline)
+      update_best_candidate(sesync_result.Yopt);
+
     /// Check TNT termination status
     if (tnt_result.status == Optimization::Riemannian::TNTStatus::ElapsedTime) {
       sesync_result.status = SESyncStatus::ElapsedTime;
       break;
     }
 
+    if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    }
+
+    if (!options.verify) {
+      sesync_result.status = Unverified;
+      break;
+    }
+
     if (options.verbose) {
       // Display some output to the user
       std::cout << std::endl
@@ -364,17 +1189,44 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
 
     /// Check second-order optimality
 
+    // In hard-deadline mode, don't start a verification that (judging by the
+    // previous one) cannot finish in time
+    if (options.hard_deadline && !sesync_result.verification_times.empty() &&
+        sesync_result.verification_times.back() > remaining_time()) {
+      sesync_result.status = ElapsedTime;
+      break;
+    }
+
+    progress.objective_value = sesync_result.SDPval;
+    progress.gradient_norm = sesync_result.gradnorm;
+    report_progress(SESyncPhase::Verification);
+
     size_t num_lobpcg_iters;
     auto verification_start_time = Stopwatch::tick();
 
-    Vector v;     // Escape direction
-    Scalar theta; // Curvature of certificate matrix along escape direction
+    Matrix V;      // Escape direction(s)
+    Vector thetas; // Curvature of certificate matrix along escape direction(s)
+
+    // Don't ascend beyond the maximum level of the Staircase
+    size_t max_escape_directions = std::max<size_t>(
+        1, std::min(options.max_escape_directions, options.rmax - r));
 
     bool global_opt = problem.verify_solution(
         sesync_result.Yopt, options.min_eig_num_tol, options.LOBPCG_block_size,
-        theta, v, num_lobpcg_iters, options.LOBPCG_max_iterations,
-        options.LOBPCG_max_fill_factor, options.LOBPCG_drop_tol);
+        max_escape_directions, thetas, V, num_lobpcg_iters,
+        options.LOBPCG_max_iterations, options.LOBPCG_max_fill_factor,
+        options.LOBPCG_drop_tol, interrupt);
     double verification_elapsed_time = Stopwatch::tock(verification_start_time);
+    telemetry.levels.back().verification_time = verification_elapsed_time;
+
+    // If LOBPCG was abandoned, its result is meaningless
+    if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    }
+
+    // Curvature along the minimum eigenvector
+    Scalar theta = thetas(0);
 
     // Check eigenvalue convergence
     if (!global_opt && theta >= -options.min_eig_num_tol / 2) {
@@ -411,19 +1263,38 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
                   << num_lobpcg_iters << " LOBPCG iterations)." << std::endl;
       }
 
+      if (cancellation_requested(options)) {
+        sesync_result.status = Cancelled;
+        break;
+      }
+      report_progress(SESyncPhase::SaddleEscape);
+
+      if (options.verbose && V.cols() > 1)
+        std::cout << "Escaping along " << V.cols()
+                  << " directions of negative curvature (curvatures: "
+                  << thetas.transpose() << ")" << std::endl;
+
       // Augment the rank of the rank-restricted semidefinite relaxation in
       // preparation for ascending to the next level of the Riemannian
       // Staircase
-      problem.set_relaxation_rank(r + 1);
+      problem.set_relaxation_rank(r + V.cols());
+      sesync_result.escape_directions.push_back(V.cols());
 
       Matrix Yplus;
+      auto escape_start_time = Stopwatch::tick();
       bool escape_success = escape_saddle(
-          problem, sesync_result.Yopt, theta, v, options.grad_norm_tol,
-          options.preconditioned_grad_norm_tol, Yplus);
+          problem, sesync_result.Yopt, thetas, V, options.grad_norm_tol,
+          options.preconditioned_grad_norm_tol, Yplus,
+          options.escape_line_search_batch_size,
+          options.escape_model_guided_step, interrupt);
+      telemetry.levels.back().escape_time = Stopwatch::tock(escape_start_time);
 
       if (escape_success) {
         // Update initialization point for next level in the Staircase
         Y = Yplus;
+      } else if (cancellation_requested(options)) {
+        sesync_result.status = Cancelled;
+        break;
       } else {
         if (options.verbose)
           std::cout
@@ -437,7 +1308,19 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
     } // saddle point
   }   // Riemannian Staircase
 
+  telemetry.staircase_time = Stopwatch::tock(riemannian_staircase_start_time);
+  for (size_t k = 0; k < level_start_counts.size(); ++k) {
+    bool last = (k + 1 == level_start_counts.size());
+    telemetry.levels[k].counts = operation_counts_between(
+        level_start_counts[k],
+        last ? operation_counts(problem) : level_start_counts[k + 1]);
+    telemetry.levels[k].kernels = kernel_profile_between(
+        level_start_kernel_profiles[k],
+        last ? kernel_profile() : level_start_kernel_profiles[k + 1]);
+  }
+
   /// POST-PROCESSING
+  auto post_processing_start_time = Stopwatch::tick();
 
   if (options.verbose) {
     std::cout << std::endl
@@ -469,61 +1352,106 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
                    "time before finding global optimum!"
                 << std::endl;
       break;
+    case Cancelled:
+      std::cout << "WARNING: Algorithm was cancelled before finding global "
+                   "optimum!"
+                << std::endl;
+      break;
+    case Unverified:
+      std::cout << "Optimality of the critical point was not verified"
+                << std::endl;
+      break;
     }
   } // if (options.verbose)
 
-  if (options.verbose)
-    std::cout << std::endl << "Rounding solution ... ";
-
-  // Round solution
-  auto rounding_start_time = Stopwatch::tick();
-  // Recover the complete pose matrix X = [t | R]
-  sesync_result.xhat = problem.round_solution(sesync_result.Yopt);
-  double rounding_elapsed_time = Stopwatch::tock(rounding_start_time);
-
-  if (options.verbose)
-    std::cout << "elapsed computation time: " << rounding_elapsed_time
-              << " seconds" << std::endl
-              << std::endl;
+  // If the Staircase was terminated before completing its first optimization
+  // (due to cancellation or exhaustion of the computational budget during
+  // initialization), report the initial iterate
+  if (sesync_result.Yopt.size() == 0) {
+    sesync_result.Yopt = Y;
+    sesync_result.SDPval = problem.evaluate_objective(Y);
+    sesync_result.gradnorm = problem.Riemannian_gradient(Y).norm();
+  }
 
-  sesync_result.total_computation_time = Stopwatch::tock(SESync_start_time);
+  report_progress(SESyncPhase::Rounding);
 
-  /// Compute some additional interesting bits of data
+  if (options.hard_deadline) {
+    // Every estimate computed by the Staircase has already been rounded;
+    // return the best of these
+    sesync_result.xhat = best_xhat;
+    sesync_result.Fxhat = best_Fxhat;
+  } else {
+    if (options.verbose)
+      std::cout << std::endl << "Rounding solution ... ";
 
-  // Evaluate objective function at ROUNDED solution.
-  // Note that since xhat contains the *complete* set of pose estimates, we must
-  // extract only the *rotational* elements of xhat if the SE synchronization
-  // problem was solved using the simplified formulation
-  sesync_result.Fxhat =
-      (problem.formulation() == Formulation::Simplified
-           ? problem.evaluate_objective(sesync_result.xhat.block(
-                 0, problem.num_states(), problem.dimension(),
-                 problem.dimension() * problem.num_states()))
-           : problem.evaluate_objective(sesync_result.xhat));
+    // Round solution
+    auto rounding_start_time = Stopwatch::tick();
+    // Recover the complete pose matrix X = [t | R]
+    sesync_result.xhat = problem.round_solution(sesync_result.Yopt);
+    double rounding_elapsed_time = Stopwatch::tock(rounding_start_time);
+    telemetry.rounding_time = rounding_elapsed_time;
 
-  // Compute the primal optimal SDP solution Lambda and its objective value
-  Matrix Lambda_blocks = problem.compute_Lambda_blocks(sesync_result.Yopt);
+    if (options.verbose)
+      std::cout << "elapsed computation time: " << rounding_elapsed_time
+                << " seconds" << std::endl
+                << std::endl;
+  }
 
-  sesync_result.trLambda = 0;
-  for (size_t i = 0; i < problem.num_states(); i++)
-    sesync_result.trLambda +=
-        Lambda_blocks
-            .block(0, i * problem.dimension(), problem.dimension(),
-                   problem.dimension())
-            .trace();
+  sesync_result.total_computation_time = Stopwatch::tock(SESync_start_time);
 
-  sesync_result.Lambda =
-      problem.compute_Lambda_from_Lambda_blocks(Lambda_blocks);
+  /// Compute some additional interesting bits of data
 
-  // Get the duality gap for the primal-dual pair (Y'*Y, Lambda) of SDP
-  // estimates
+  // Evaluate objective function at ROUNDED solution
+  if (!options.hard_deadline)
+    sesync_result.Fxhat = rounded_objective(sesync_result.xhat);
+
+  // In hard-deadline mode, skip the computation of the Lagrange multipliers if
+  // it cannot be completed before the deadline (in which case no
+  // suboptimality bound is available)
+  if (options.hard_deadline &&
+      options.max_computation_time - Stopwatch::tock(SESync_start_time) <
+          Lambda_cost) {
+    sesync_result.trLambda = std::numeric_limits<Scalar>::quiet_NaN();
+    sesync_result.duality_gap = std::numeric_limits<Scalar>::quiet_NaN();
+    sesync_result.suboptimality_bound =
+        std::numeric_limits<Scalar>::quiet_NaN();
+  } else {
+    // Compute the primal optimal SDP solution Lambda and its objective value
+    auto Lambda_start_time = Stopwatch::tick();
+    Matrix Lambda_blocks = problem.compute_Lambda_blocks(sesync_result.Yopt);
+
+    sesync_result.trLambda = 0;
+    for (size_t i = 0; i < problem.num_states(); i++)
+      sesync_result.trLambda +=
+          Lambda_blocks
+              .block(0, i * problem.dimension(), problem.dimension(),
+                     problem.dimension())
+              .trace();
+
+    sesync_result.Lambda =
+        problem.compute_Lambda_from_Lambda_blocks(Lambda_blocks);
+    telemetry.Lambda_time = Stopwatch::tock(Lambda_start_time);
+
+    // Get the duality gap for the primal-dual pair (Y'*Y, Lambda) of SDP
+    // estimates
+
+    sesync_result.duality_gap = sesync_result.SDPval - sesync_result.trLambda;
+
+    // Get an upper bound on the (global) suboptimality of the recovered
+    // (rounded) pose estimates
+    sesync_result.suboptimality_bound =
+        sesync_result.Fxhat - sesync_result.trLambda;
+  }
 
-  sesync_result.duality_gap = sesync_result.SDPval - sesync_result.trLambda;
+  if (options.hard_deadline)
+    sesync_result.total_computation_time = Stopwatch::tock(SESync_start_time);
 
-  // Get an upper bound on the (global) suboptimality of the recovered (rounded)
-  // pose estimates
-  sesync_result.suboptimality_bound =
-      sesync_result.Fxhat - sesync_result.trLambda;
+  telemetry.post_processing_time = Stopwatch::tock(post_processing_start_time);
+  telemetry.total_time = Stopwatch::tock(SESync_start_time);
+  telemetry.counts =
+      operation_counts_between(initial_counts, operation_counts(problem));
+  telemetry.kernels =
+      kernel_profile_between(initial_kernel_profile, kernel_profile());
 
   /// FINAL OUTPUT
 
@@ -545,119 +1473,1029 @@ SESyncResult SESync(SESyncProblem &problem, const SESyncOpts &options,
               << sesync_result.suboptimality_bound << std::endl
               << std::endl;
     std::cout << "Total elapsed computation time: "
-              << sesync_result.total_computation_time << " seconds" << std::endl
+              << sesync_result.total_computation_time << " seconds ("
+              << sesync_result.relaxation_ranks.size()
+              << " levels of the Riemannian Staircase)" << std::endl
               << std::endl;
 
+    if (kernel_counters_enabled()) {
+      std::cout << "KERNEL PROFILE:" << std::endl;
+      for (size_t k = 0; k < NumKernels; ++k) {
+        const KernelStats &stats = telemetry.kernels[k];
+        std::cout << kernel_name(static_cast<Kernel>(k)) << ": " << stats.calls
+                  << " calls, " << stats.time << " seconds, "
+                  << stats.GFLOPS() << " GFLOP/s, " << stats.GBS()
+                  << " GB/s (intensity " << stats.intensity()
+                  << " flops/byte)" << std::endl;
+      }
+      std::cout << std::endl;
+    }
+
     std::cout << "===== END SE-SYNC =====" << std::endl << std::endl;
   } // if (options.verbose)
+
+  // Make sure that the iterate log was written completely
+  if (iterate_writer)
+    iterate_writer->close();
+
+  progress.objective_value = sesync_result.SDPval;
+  progress.gradient_norm = sesync_result.gradnorm;
+  report_progress(SESyncPhase::Finished);
+
   return sesync_result;
 }
 
-SESyncResult SESync(const measurements_t &measurements,
-                    const SESyncOpts &options, const Matrix &Y0) {
-  if (options.verbose)
-    std::cout << "Constructing SE-Sync problem instance ... ";
+SESyncResult SESync(PlanarSESyncProblem &problem, const SESyncOpts &options,
+                    const ComplexMatrix &Y0) {
 
-  auto problem_construction_start_time = Stopwatch::tick();
-  SESyncProblem problem(
-      measurements, options.formulation, options.projection_factorization,
-      options.preconditioner, options.reg_Cholesky_precon_max_condition_number);
-  double problem_construction_elapsed_time =
-      Stopwatch::tock(problem_construction_start_time);
-  if (options.verbose)
-    std::cout << "elapsed computation time: "
-              << problem_construction_elapsed_time << " seconds" << std::endl
-              << std::endl;
+  /// INPUT SANITATION
 
-  return SESync(problem, options, Y0);
-}
+  if (options.r0 < 1)
+    throw std::invalid_argument(
+        "Initial relaxation rank must be a positive integer");
 
-bool escape_saddle(const SESyncProblem &problem, const Matrix &Y, Scalar theta,
-                   const Vector &v, Scalar gradient_tolerance,
-                   Scalar preconditioned_gradient_tolerance, Matrix &Yplus) {
+  if (options.rmax < options.r0)
+    throw std::invalid_argument("Maximum relaxation rank must be greater than "
+                                "or equal to initial relaxation rank.");
 
-  /** v is an eigenvector corresponding to a negative eigenvalue of Q - Lambda,
-   * so the KKT conditions for the semidefinite relaxation are not satisfied;
-   * this implies that Y is a saddle point of the rank-restricted semidefinite
-   * optimization.  Fortunately, v_min can be used to compute a descent
-   * direction from this saddle point, as described in Theorem 3.9 of the paper
-   * "A Riemannian Low-Rank Method for Optimization over Semidefinite  Matrices
-   * with Block-Diagonal Constraints". Define the vector Ydot := e_{r+1} * v';
-   * this is a tangent vector to the domain of the SDP and provides a direction
-   * of negative curvature */
+  if (options.max_computation_time <= 0)
+    throw std::invalid_argument(
+        "Maximum computation time must be a positive value");
 
-  // Function value at current iterate (saddle point)
-  Scalar FY = problem.evaluate_objective(Y);
+  if (options.min_eig_num_tol <= 0)
+    throw std::invalid_argument("Numerical tolerance for minimum eigenvalue "
+                                "nonnegativity must be a positive value");
 
-  // Relaxation rank at the NEXT level of the Riemannian Staircase, i.e. we
-  // require that r = Y.rows() + 1
-  size_t r = problem.relaxation_rank();
+  if (options.LOBPCG_block_size < 1)
+    throw std::invalid_argument("LOBPCG block size must be a positive integer");
 
-  // Construct the corresponding representation of the saddle point Y in the
-  // next level of the Riemannian Staircase by adding a row of 0's
-  Matrix Y_augmented = Matrix::Zero(r, Y.cols());
-  Y_augmented.topRows(r - 1) = Y;
+  if (options.iterate_log_stride < 1)
+    throw std::invalid_argument(
+        "Iterate logging stride must be a positive integer");
 
-  Matrix Ydot = Matrix::Zero(r, Y.cols());
-  Ydot.bottomRows<1>() = v.transpose();
+  /// ALGORITHM DATA
 
-  // Set the initial step length to the greater of 10 times the distance needed
-  // to arrive at a trial point whose gradient is large enough to avoid
-  // triggering the gradient norm tolerance stopping condition (according to the
-  // local second-order model), or at least 2^4 times the minimum admissible
-  // steplength,
-  Scalar alpha_min = 1e-6; // Minimum stepsize
-  Scalar alpha =
-      std::max(16 * alpha_min, 10 * gradient_tolerance / fabs(theta));
+  // The current iterate in the Riemannian Staircase
+  ComplexMatrix Y;
 
-  // Vectors of trial stepsizes and corresponding function values
-  std::vector<double> alphas;
-  std::vector<double> fvals;
+  // A cache variable to store the *Euclidean* gradient at the current iterate Y
+  ComplexMatrix NablaF_Y;
 
-  /// Backtracking line search
-  Matrix Ytest;
-  while (alpha >= alpha_min) {
+  // The current estimate of the global minimizer of the complex relaxation
+  ComplexMatrix Yopt;
 
-    // Retract along the given tangent vector using the given stepsize
-    Ytest = problem.retract(Y_augmented, alpha * Ydot);
+  // The output results struct that we will return
+  SESyncResult sesync_result;
+  sesync_result.status = MaxRank;
 
-    // Ensure that the trial point Ytest has a lower function value than
-    // the current iterate Y, and that the gradient at Ytest is
-    // sufficiently large that we will not automatically trigger the
-    // gradient tolerance stopping criterion at the next iteration
-    Scalar FYtest = problem.evaluate_objective(Ytest);
-    Matrix grad_FYtest = problem.Riemannian_gradient(Ytest);
-    Scalar grad_FYtest_norm = grad_FYtest.norm();
-    Scalar preconditioned_grad_FYtest_norm =
-        problem.precondition(Ytest, grad_FYtest).norm();
+  if (options.verbose) {
+    std::cout << "========= SE-Sync (planar complex specialization) =========="
+              << std::endl
+              << std::endl;
+    std::cout << " SE-Sync problem formulation: "
+              << (problem.formulation() == Formulation::Simplified
+                      ? "Simplified"
+                      : "SO-Sync")
+              << std::endl;
+    std::cout << " Initial level of Riemannian staircase (complex rank): "
+              << options.r0 << std::endl;
+    std::cout << " Maximum level of Riemannian staircase (complex rank): "
+              << options.rmax << std::endl
+              << std::endl;
+  }
 
-    // Record trial stepsize and function value
-    alphas.push_back(alpha);
-    fvals.push_back(FYtest);
+  /// ALGORITHM START
+  auto SESync_start_time = Stopwatch::tick();
+
+// Set number of threads
+#if defined(_OPENMP)
+  omp_set_num_threads(options.num_threads);
+#endif
+
+  SESyncTelemetry &telemetry = sesync_result.telemetry;
 
-    if ((FYtest < FY) && (grad_FYtest_norm > gradient_tolerance) &&
-        (preconditioned_grad_FYtest_norm > preconditioned_gradient_tolerance)) {
-      // Accept this trial point and return success
-      Yplus = Ytest;
-      return true;
+  // The progress of the algorithm, as reported to the monitor (if any)
+  SESyncProgress progress;
+  auto report_progress = [&](SESyncPhase phase) {
+    if (options.monitor) {
+      progress.phase = phase;
+      progress.elapsed_time = Stopwatch::tock(SESync_start_time);
+      options.monitor->publish(progress);
     }
-    alpha /= 2;
-  }
+  };
 
-  // If control reaches here, we failed to find a trial point that satisfied
-  // *both* the function decrease *and* gradient bounds.  In order to make
-  // forward progress, we will fall back to accepting the trial point that
-  // simply minimized the objective value, provided that it strictly *decreased*
-  // the objective from the current (saddle) point
+  /// SET UP OPTIMIZATION
 
-  // Find minimum function value from among the trial points
-  auto fmin_iter = std::min_element(fvals.begin(), fvals.end());
-  auto min_idx = std::distance(fvals.begin(), fmin_iter);
+  // Objective
+  Optimization::Objective<ComplexMatrix, Scalar, ComplexMatrix> F =
+      [&problem](const ComplexMatrix &Y, const ComplexMatrix &NablaF_Y) {
+        return problem.evaluate_objective(Y);
+      };
 
-  double f_min = fvals[min_idx];
-  double a_min = alphas[min_idx];
+  // Local quadratic model constructor
+  Optimization::Riemannian::QuadraticModel<ComplexMatrix, ComplexMatrix,
+                                           ComplexMatrix>
+      QM = [&problem](const ComplexMatrix &Y, ComplexMatrix &grad,
+                      Optimization::Riemannian::LinearOperator<
+                          ComplexMatrix, ComplexMatrix, ComplexMatrix> &HessOp,
+                      ComplexMatrix &NablaF_Y) {
+        // Compute and cache Euclidean gradient at the current iterate
+        NablaF_Y = problem.Euclidean_gradient(Y);
 
-  if (f_min < FY) {
+        // Compute Riemannian gradient from Euclidean gradient
+        grad = problem.Riemannian_gradient(Y, NablaF_Y);
+
+        // Define linear operator for computing Riemannian Hessian-vector
+        // products
+        HessOp = [&problem](const ComplexMatrix &Y, const ComplexMatrix &Ydot,
+                            const ComplexMatrix &NablaF_Y) {
+          return problem.Riemannian_Hessian_vector_product(Y, NablaF_Y, Ydot);
+        };
+      };
+
+  // Riemannian metric:  we regard C^{r x n} as a real Euclidean space, with
+  // inner product <V1, V2> := Re(tr(V1^H V2))
+  Optimization::Riemannian::RiemannianMetric<ComplexMatrix, ComplexMatrix,
+                                             Scalar, ComplexMatrix>
+      metric = [](const ComplexMatrix &Y, const ComplexMatrix &V1,
+                  const ComplexMatrix &V2, const ComplexMatrix &NablaF_Y) {
+        return (V1.adjoint() * V2).trace().real();
+      };
+
+  // Retraction operator
+  Optimization::Riemannian::Retraction<ComplexMatrix, ComplexMatrix,
+                                       ComplexMatrix>
+      retraction = [&problem](const ComplexMatrix &Y, const ComplexMatrix &Ydot,
+                              const ComplexMatrix &NablaF_Y) {
+        return problem.retract(Y, Ydot);
+      };
+
+  // Preconditioning operator (optional)
+  std::optional<Optimization::Riemannian::LinearOperator<
+      ComplexMatrix, ComplexMatrix, ComplexMatrix>>
+      precon;
+  if (problem.preconditioner() == Preconditioner::None)
+    precon = std::nullopt;
+  else {
+    Optimization::Riemannian::LinearOperator<ComplexMatrix, ComplexMatrix,
+                                             ComplexMatrix>
+        precon_op = [&problem](const ComplexMatrix &Y,
+                               const ComplexMatrix &Ydot,
+                               const ComplexMatrix &NablaF_Y) {
+          return problem.precondition(Y, Ydot);
+        };
+    precon = precon_op;
+  }
+
+  // Writer used to stream (the real representations of) iterates to disk, if
+  // requested
+  std::unique_ptr<IterateWriter> iterate_writer;
+  if (!options.iterate_log_file.empty())
+    iterate_writer = std::make_unique<IterateWriter>(
+        options.iterate_log_file, options.iterate_log_single_precision);
+
+  // User function: if a monitor is attached or iterates are being streamed to
+  // disk, record each iterate, publish the progress of the trust-region
+  // method, and poll for cancellation, after each iteration
+  std::optional<Optimization::Riemannian::TNTUserFunction<
+      ComplexMatrix, ComplexMatrix, Scalar, ComplexMatrix>>
+      user_function;
+  if (options.monitor || iterate_writer) {
+    user_function =
+        [&](double t, const ComplexMatrix &Y, Scalar f,
+            const ComplexMatrix &grad,
+            const Optimization::Riemannian::LinearOperator<
+                ComplexMatrix, ComplexMatrix, ComplexMatrix> &HessOp,
+            Scalar Delta, size_t num_STPCG_iters, const ComplexMatrix &h,
+            Scalar df, Scalar rho, bool accepted, ComplexMatrix &NablaF_Y) {
+          size_t k = progress.iteration++;
+          if (iterate_writer && k % options.iterate_log_stride == 0)
+            iterate_writer->write(progress.level, k, t, f,
+                                  real_representation(Y));
+
+          progress.objective_value = f;
+          progress.gradient_norm = grad.norm();
+          report_progress(SESyncPhase::Optimization);
+          return cancellation_requested(options);
+        };
+  }
+
+  // Used to abandon the computations that run outside of TNT (LOBPCG and the
+  // saddle escape line search) as soon as cancellation is requested
+  std::function<bool()> interrupt = [&options]() {
+    return cancellation_requested(options);
+  };
+
+  /// INITIALIZATION
+  if (options.verbose)
+    std::cout << "INITIALIZATION:" << std::endl;
+  report_progress(SESyncPhase::Initialization);
+
+  problem.set_relaxation_rank(options.r0);
+
+  if (Y0.size() != 0) {
+    if (options.verbose)
+      std::cout << " Using user-supplied initial iterate Y0" << std::endl;
+
+    Y = Y0;
+  } else if (options.initialization == Initialization::Random) {
+    if (options.verbose)
+      std::cout << " Sampling a random initialization ... " << std::endl;
+    Y = problem.random_sample();
+  } else if (options.initialization == Initialization::SOSyncCascade &&
+             problem.formulation() != Formulation::SOSync) {
+    if (options.verbose)
+      std::cout << " Computing rotation-first (SO-Sync) cascade "
+                   "initialization ... "
+                << std::endl;
+
+    auto cascade_construction_start_time = Stopwatch::tick();
+    PlanarSESyncProblem rotation_problem(
+        problem.measurements(), Formulation::SOSync, problem.preconditioner(),
+        problem.regularized_Cholesky_preconditioner_max_condition());
+    sesync_result.cascade_construction_time =
+        Stopwatch::tock(cascade_construction_start_time);
+
+    SESyncOpts rotation_opts = options;
+    rotation_opts.formulation = Formulation::SOSync;
+    rotation_opts.initialization = Initialization::Chordal;
+    rotation_opts.grad_norm_tol = options.cascade_grad_norm_tol;
+    rotation_opts.preconditioned_grad_norm_tol =
+        options.cascade_preconditioned_grad_norm_tol;
+    rotation_opts.rel_func_decrease_tol = options.cascade_rel_func_decrease_tol;
+    rotation_opts.max_computation_time =
+        options.max_computation_time - Stopwatch::tock(SESync_start_time);
+    rotation_opts.log_iterates = false;
+    rotation_opts.iterate_log_file.clear();
+    rotation_opts.verbose = false;
+    // The inner solve must not publish its own progress (in particular, its
+    // Finished phase) to the caller's monitor, but should still honor its
+    // cancellation
+    rotation_opts.monitor = SESyncMonitor::child(options.monitor);
+
+    auto cascade_rotation_start_time = Stopwatch::tick();
+    SESyncResult rotation_result = SESync(rotation_problem, rotation_opts);
+    sesync_result.cascade_rotation_time =
+        Stopwatch::tock(cascade_rotation_start_time);
+
+    // Extract the unit-modulus complex representation of the estimated
+    // rotations, and lift these to construct the initial iterate
+    auto cascade_lifting_start_time = Stopwatch::tick();
+    ComplexMatrix R(1, problem.num_states());
+    for (size_t i = 0; i < problem.num_states(); ++i)
+      R(0, i) = complex_rotation(rotation_result.xhat.block(0, 2 * i, 2, 2));
+    Y = problem.lift_rotations(R);
+    sesync_result.cascade_lifting_time =
+        Stopwatch::tock(cascade_lifting_start_time);
+  } else {
+    // The spectral and multilevel initializations are not specialized for the
+    // complex representation; since for planar problems the chordal
+    // initialization requires only a single (complex) sparse linear solve, we
+    // use it instead
+    if (options.verbose)
+      std::cout << " Computing chordal initialization ... " << std::endl;
+    Y = problem.chordal_initialization();
+  }
+
+  sesync_result.initialization_time = Stopwatch::tock(SESync_start_time);
+  telemetry.initialization_time = sesync_result.initialization_time;
+  if (options.verbose)
+    std::cout << " SE-Sync initialization finished; elapsed time: "
+              << sesync_result.initialization_time << " seconds" << std::endl
+              << std::endl
+              << "Initial objective value: " << problem.evaluate_objective(Y)
+              << std::endl;
+
+  /// RIEMANNIAN STAIRCASE
+
+  // Configure optimization parameters
+  Optimization::Riemannian::TNTParams<Scalar> params;
+  params.gradient_tolerance = options.grad_norm_tol;
+  params.preconditioned_gradient_tolerance =
+      options.preconditioned_grad_norm_tol;
+  params.relative_decrease_tolerance = options.rel_func_decrease_tol;
+  params.stepsize_tolerance = options.stepsize_tol;
+  params.max_iterations = options.max_iterations;
+  params.max_TPCG_iterations = options.max_tCG_iterations;
+  params.kappa_fgr = options.STPCG_kappa;
+  params.theta = options.STPCG_theta;
+  params.log_iterates = options.log_iterates;
+  params.verbose = options.verbose;
+
+  auto riemannian_staircase_start_time = Stopwatch::tick();
+
+  for (size_t r = options.r0; r <= options.rmax; r++) {
+    double RTR_iteration_start_time =
+        Stopwatch::tock(riemannian_staircase_start_time);
+
+    /// Test temporal stopping condition
+    if (RTR_iteration_start_time >= options.max_computation_time) {
+      sesync_result.status = ElapsedTime;
+      break;
+    }
+
+    if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    }
+
+    progress.level = r;
+    progress.iteration = 0;
+    report_progress(SESyncPhase::Optimization);
+
+    telemetry.levels.emplace_back();
+    telemetry.levels.back().relaxation_rank = r;
+
+    params.max_computation_time =
+        options.max_computation_time - RTR_iteration_start_time;
+
+    if (options.verbose)
+      std::cout << std::endl
+                << std::endl
+                << "====== RIEMANNIAN STAIRCASE (complex level r = " << r
+                << ") ======" << std::endl
+                << std::endl;
+
+    /// Run optimization!
+    Optimization::Riemannian::TNTResult<ComplexMatrix, Scalar> tnt_result =
+        Optimization::Riemannian::TNT<ComplexMatrix, ComplexMatrix, Scalar,
+                                      ComplexMatrix>(
+            F, QM, metric, retraction, Y, NablaF_Y, precon, params,
+            user_function);
+
+    // Extract the results
+    Yopt = tnt_result.x;
+    sesync_result.SDPval = tnt_result.f;
+    sesync_result.gradnorm = problem.Riemannian_gradient(Yopt).norm();
+
+    // Record the optimization history at this level of the Staircase
+    sesync_result.relaxation_ranks.push_back(r);
+    telemetry.levels.back().optimization_time = tnt_result.elapsed_time;
+    sesync_result.function_values.push_back(tnt_result.objective_values);
+    sesync_result.gradient_norms.push_back(tnt_result.gradient_norms);
+    sesync_result.preconditioned_gradient_norms.push_back(
+        tnt_result.preconditioned_gradient_norms);
+    sesync_result.Hessian_vector_products.push_back(
+        tnt_result.inner_iterations);
+    sesync_result.update_step_norms.push_back(tnt_result.update_step_norms);
+    sesync_result.update_step_M_norms.push_back(tnt_result.update_step_M_norms);
+    sesync_result.gain_ratios.push_back(tnt_result.gain_ratios);
+    sesync_result.elapsed_optimization_times.push_back(tnt_result.time);
+
+    // Record sequence of iterates (in their real representation), if requested
+    if (options.log_iterates) {
+      std::vector<Matrix> iterates;
+      iterates.reserve(tnt_result.iterates.size());
+      for (const ComplexMatrix &Yk : tnt_result.iterates)
+        iterates.push_back(real_representation(Yk));
+      sesync_result.iterates.push_back(iterates);
+    }
+
+    /// Check TNT termination status
+    if (tnt_result.status == Optimization::Riemannian::TNTStatus::ElapsedTime) {
+      sesync_result.status = SESyncStatus::ElapsedTime;
+      break;
+    }
+
+    if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    }
+
+    if (!options.verify) {
+      sesync_result.status = Unverified;
+      break;
+    }
+
+    if (options.verbose)
+      std::cout << std::endl
+                << "Found first-order critical point with value F(Y) = "
+                << sesync_result.SDPval
+                << "!  Elapsed computation time: " << tnt_result.elapsed_time
+                << " seconds" << std::endl
+                << std::endl
+                << "Checking second order optimality ... " << std::endl;
+
+    /// Check second-order optimality
+    progress.objective_value = sesync_result.SDPval;
+    progress.gradient_norm = sesync_result.gradnorm;
+    report_progress(SESyncPhase::Verification);
+
+    size_t num_lobpcg_iters;
+    auto verification_start_time = Stopwatch::tick();
+
+    ComplexVector v; // Escape direction
+    Scalar theta;    // Curvature of certificate matrix along escape direction
+
+    bool global_opt = problem.verify_solution(
+        Yopt, options.min_eig_num_tol, options.LOBPCG_block_size, theta, v,
+        num_lobpcg_iters, options.LOBPCG_max_iterations,
+        options.LOBPCG_max_fill_factor, options.LOBPCG_drop_tol, interrupt);
+    double verification_elapsed_time = Stopwatch::tock(verification_start_time);
+    telemetry.levels.back().verification_time = verification_elapsed_time;
+
+    // If LOBPCG was abandoned, its result is meaningless
+    if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    }
+
+    // Check eigenvalue convergence
+    if (!global_opt && theta >= -options.min_eig_num_tol / 2) {
+      if (options.verbose)
+        std::cout
+            << "WARNING! ESCAPE DIRECTION COMPUTATION DID NOT CONVERGE TO "
+               "DESIRED PRECISION!"
+            << std::endl;
+      sesync_result.status = EigImprecision;
+      break;
+    }
+
+    // Record results of eigenvalue computation
+    sesync_result.escape_direction_curvatures.push_back(theta);
+    sesync_result.LOBPCG_iters.push_back(num_lobpcg_iters);
+    sesync_result.verification_times.push_back(verification_elapsed_time);
+
+    if (global_opt) {
+      if (options.verbose)
+        std::cout
+            << "Found second-order critical point! Elapsed computation time: "
+            << verification_elapsed_time << " seconds." << std::endl;
+      sesync_result.status = GlobalOpt;
+      break;
+    }
+
+    /// ESCAPE FROM SADDLE!
+    if (options.verbose)
+      std::cout << "Saddle point detected! Curvature along escape direction: "
+                << theta << ".  Elapsed computation time: "
+                << verification_elapsed_time << " seconds ("
+                << num_lobpcg_iters << " LOBPCG iterations)." << std::endl;
+
+    if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    }
+    report_progress(SESyncPhase::SaddleEscape);
+
+    problem.set_relaxation_rank(r + 1);
+    sesync_result.escape_directions.push_back(1);
+
+    ComplexMatrix Yplus;
+    auto escape_start_time = Stopwatch::tick();
+    bool escape_success =
+        escape_saddle(problem, Yopt, theta, v, options.grad_norm_tol,
+                      options.preconditioned_grad_norm_tol, Yplus, interrupt);
+    telemetry.levels.back().escape_time = Stopwatch::tock(escape_start_time);
+
+    if (escape_success)
+      Y = Yplus;
+    else if (cancellation_requested(options)) {
+      sesync_result.status = Cancelled;
+      break;
+    } else {
+      if (options.verbose)
+        std::cout << "WARNING!  BACKTRACKING LINE SEARCH FAILED TO ESCAPE FROM "
+                     "SADDLE POINT!"
+                  << std::endl;
+      sesync_result.status = SaddlePoint;
+      break;
+    }
+  } // Riemannian Staircase
+
+  telemetry.staircase_time = Stopwatch::tock(riemannian_staircase_start_time);
+
+  /// POST-PROCESSING
+  auto post_processing_start_time = Stopwatch::tick();
+
+  // If the Staircase was terminated before completing its first optimization,
+  // report the initial iterate
+  if (Yopt.size() == 0) {
+    Yopt = Y;
+    sesync_result.SDPval = problem.evaluate_objective(Y);
+    sesync_result.gradnorm = problem.Riemannian_gradient(Y).norm();
+  }
+
+  // Report the solution using the real representation
+  sesync_result.Yopt = real_representation(Yopt);
+
+  // Round solution
+  report_progress(SESyncPhase::Rounding);
+  auto rounding_start_time = Stopwatch::tick();
+  ComplexMatrix Rhat = problem.round_rotations(Yopt);
+  sesync_result.xhat = problem.round_solution(Yopt);
+  double rounding_elapsed_time = Stopwatch::tock(rounding_start_time);
+  telemetry.rounding_time = rounding_elapsed_time;
+
+  sesync_result.total_computation_time = Stopwatch::tock(SESync_start_time);
+
+  // Evaluate objective function at ROUNDED solution
+  sesync_result.Fxhat = problem.evaluate_objective(Rhat);
+
+  // Compute the primal optimal SDP solution Lambda and its objective value
+  auto Lambda_start_time = Stopwatch::tick();
+  Vector lambda = problem.compute_Lambda_diagonal(Yopt);
+  sesync_result.trLambda = lambda.sum();
+  sesync_result.Lambda = problem.compute_Lambda_from_Lambda_diagonal(lambda);
+  telemetry.Lambda_time = Stopwatch::tock(Lambda_start_time);
+
+  sesync_result.duality_gap = sesync_result.SDPval - sesync_result.trLambda;
+  sesync_result.suboptimality_bound =
+      sesync_result.Fxhat - sesync_result.trLambda;
+
+  if (options.verbose) {
+    std::cout << std::endl
+              << "===== END RIEMANNIAN STAIRCASE =====" << std::endl
+              << std::endl;
+    std::cout << "Rounding elapsed computation time: " << rounding_elapsed_time
+              << " seconds" << std::endl;
+    std::cout << "Value of dual SDP solution F(Y): " << sesync_result.SDPval
+              << std::endl;
+    std::cout << "Value of primal SDP solution tr(Lambda): "
+              << sesync_result.trLambda << std::endl;
+    std::cout << "Value of rounded pose estimates F(x): " << sesync_result.Fxhat
+              << std::endl;
+    std::cout << "Suboptimality bound F(x) - tr(Lambda) of recovered pose "
+                 "estimate: "
+              << sesync_result.suboptimality_bound << std::endl;
+    std::cout << "Total elapsed computation time: "
+              << sesync_result.total_computation_time << " seconds" << std::endl
+              << std::endl;
+    std::cout << "===== END SE-SYNC =====" << std::endl << std::endl;
+  }
+
+  telemetry.post_processing_time = Stopwatch::tock(post_processing_start_time);
+  telemetry.total_time = Stopwatch::tock(SESync_start_time);
+
+  // Make sure that the iterate log was written completely
+  if (iterate_writer)
+    iterate_writer->close();
+
+  progress.objective_value = sesync_result.SDPval;
+  progress.gradient_norm = sesync_result.gradnorm;
+  report_progress(SESyncPhase::Finished);
+
+  return sesync_result;
+}
+
+SESyncResult SESync(const measurements_t &measurements,
+                    const SESyncOpts &options, const Matrix &Y0) {
+  if (options.detect_planar_problems && !measurements.empty() &&
+      measurements[0].R.rows() == 3 && Y0.size() == 0) {
+    // Test whether this 3D problem is (numerically) planar
+    auto planar_reduction_start_time = Stopwatch::tick();
+    Matrix Q;
+    if (detect_planar_structure(measurements, options.planar_rotation_tol,
+                                options.planar_translation_tol, Q)) {
+      measurements_t planar_measurements =
+          reduce_planar_measurements(measurements, Q);
+      double planar_reduction_time =
+          Stopwatch::tock(planar_reduction_start_time);
+
+      if (options.verbose)
+        std::cout << "Detected planar 3D problem; solving as a planar "
+                     "problem (reduction time: "
+                  << planar_reduction_time << " seconds)" << std::endl;
+
+      SESyncResult result = SESync(planar_measurements, options);
+
+      // Lift the planar estimates back to SE(3), and evaluate them under the
+      // original 3D objective
+      size_t n = construct_oriented_incidence_matrix(measurements).rows();
+      result.xhat = lift_planar_poses(result.xhat, n, Q);
+      result.Fxhat = evaluate_objective(measurements, result.xhat);
+      result.planar_reduction = true;
+      result.planar_reduction_time = planar_reduction_time;
+
+      if (options.verbose)
+        std::cout << "Value of lifted 3D pose estimates F(x): " << result.Fxhat
+                  << std::endl
+                  << std::endl;
+
+      // The certificate of the reduced planar problem says nothing about the
+      // original one (the out-of-plane residuals discarded by the reduction
+      // are only small, not zero), so a certified planar solution is
+      // certified again at the lifted estimates on the original 3D problem
+      if (result.status == GlobalOpt) {
+        auto planar_certification_start_time = Stopwatch::tick();
+        SESyncProblem problem(measurements, options.formulation,
+                              options.projection_factorization,
+                              options.preconditioner,
+                              options.reg_Cholesky_precon_max_condition_number);
+        SESyncCertificate certificate = certify(problem, result.xhat, options);
+        result.status = certificate.status;
+        result.Lambda = certificate.Lambda;
+        result.trLambda = certificate.trLambda;
+        result.suboptimality_bound = certificate.suboptimality_bound;
+        result.planar_certification_time =
+            Stopwatch::tock(planar_certification_start_time);
+      } else {
+        // There is no certificate for the lifted estimates, and the
+        // multipliers of the reduced problem have the wrong dimension, so
+        // don't report any
+        result.Lambda = SparseMatrix();
+        result.trLambda = result.duality_gap = result.suboptimality_bound =
+            std::numeric_limits<Scalar>::quiet_NaN();
+      }
+
+      double planar_overhead_time =
+          planar_reduction_time + result.planar_certification_time;
+      result.total_computation_time += planar_overhead_time;
+      result.telemetry.total_time += planar_overhead_time;
+
+      return result;
+    } else if (options.verbose)
+      std::cout << "3D problem is not planar within the given tolerances"
+                << std::endl;
+  }
+
+  if ((options.decompose_components || options.eliminate_bridges) &&
+      !measurements.empty() && Y0.size() == 0) {
+    // Solve disconnected problems (or problems containing bridges) component
+    // by component
+    std::vector<size_t> component;
+    size_t num_components =
+        (options.eliminate_bridges
+             ? two_edge_connected_components(measurements, component)
+             : connected_components(measurements, component));
+    if (num_components > 1)
+      return solve_components(measurements, options, component,
+                              num_components);
+  }
+
+  if (options.use_complex_planar_solver && !options.hard_deadline &&
+      !measurements.empty() && measurements[0].R.rows() == 2 &&
+      options.formulation != Formulation::Explicit && Y0.size() == 0) {
+    // Solve this planar problem using the complex-valued specialization
+    if (options.verbose)
+      std::cout << "Constructing planar SE-Sync problem instance ... ";
+
+    if (options.monitor) {
+      SESyncProgress progress;
+      progress.phase = SESyncPhase::Construction;
+      options.monitor->publish(progress);
+    }
+
+    auto problem_construction_start_time = Stopwatch::tick();
+    PlanarSESyncProblem problem(
+        measurements, options.formulation, options.preconditioner,
+        options.reg_Cholesky_precon_max_condition_number);
+    double problem_construction_elapsed_time =
+        Stopwatch::tock(problem_construction_start_time);
+    if (options.verbose)
+      std::cout << "elapsed computation time: "
+                << problem_construction_elapsed_time << " seconds" << std::endl
+                << std::endl;
+
+    // Convert the (real) Staircase levels to complex ranks
+    SESyncOpts planar_opts = options;
+    planar_opts.r0 = (options.r0 + 1) / 2;
+    planar_opts.rmax = (options.rmax + 1) / 2;
+
+    SESyncResult result = SESync(problem, planar_opts);
+    result.telemetry.problem_construction_time =
+        problem_construction_elapsed_time;
+    result.telemetry.total_time += problem_construction_elapsed_time;
+    return result;
+  }
+
+  if (options.verbose)
+    std::cout << "Constructing SE-Sync problem instance ... ";
+
+  if (options.monitor) {
+    SESyncProgress progress;
+    progress.phase = SESyncPhase::Construction;
+    options.monitor->publish(progress);
+  }
+
+  auto problem_construction_start_time = Stopwatch::tick();
+  SESyncProblem problem(
+      measurements, options.formulation, options.projection_factorization,
+      options.preconditioner, options.reg_Cholesky_precon_max_condition_number);
+  double problem_construction_elapsed_time =
+      Stopwatch::tock(problem_construction_start_time);
+  if (options.verbose)
+    std::cout << "elapsed computation time: "
+              << problem_construction_elapsed_time << " seconds" << std::endl
+              << std::endl;
+
+  SESyncResult result = SESync(problem, options, Y0);
+  result.telemetry.problem_construction_time =
+      problem_construction_elapsed_time;
+  result.telemetry.total_time += problem_construction_elapsed_time;
+  return result;
+}
+
+SESyncHandle SESyncAsync(const measurements_t &measurements,
+                         const SESyncOpts &options, const Matrix &Y0) {
+  SESyncOpts async_opts = options;
+  if (!async_opts.monitor)
+    async_opts.monitor = std::make_shared<SESyncMonitor>();
+
+  SESyncHandle handle;
+  handle.monitor = async_opts.monitor;
+  handle.result = std::async(
+      std::launch::async,
+      [measurements, async_opts, Y0]() {
+        return SESync(measurements, async_opts, Y0);
+      });
+
+  return handle;
+}
+
+SESyncCertificate certify(SESyncProblem &problem, const Matrix &xhat,
+                          const SESyncOpts &options, size_t polish_iterations) {
+  size_t n = problem.num_states();
+  size_t d = problem.dimension();
+
+  bool has_translations = (xhat.cols() == (d + 1) * n);
+  if (xhat.rows() != d || (!has_translations && xhat.cols() != d * n))
+    throw std::invalid_argument("Estimate to be certified has incorrect "
+                                "dimensions for the given problem");
+
+  if (options.min_eig_num_tol <= 0)
+    throw std::invalid_argument("Numerical tolerance for minimum eigenvalue "
+                                "nonnegativity must be a positive value");
+
+  SESyncCertificate certificate;
+  auto certify_start_time = Stopwatch::tick();
+
+#if defined(_OPENMP)
+  omp_set_num_threads(options.num_threads);
+#endif
+
+  /// LIFTING
+
+  auto lifting_start_time = Stopwatch::tick();
+  problem.set_relaxation_rank(d);
+  const Matrix R = xhat.rightCols(d * n);
+  if (problem.formulation() == Formulation::Explicit)
+    certificate.Y = (has_translations ? xhat : problem.lift_rotations(R));
+  else
+    certificate.Y = R;
+  certificate.lifting_time = Stopwatch::tock(lifting_start_time);
+
+  /// POLISHING
+
+  if (polish_iterations > 0) {
+    auto polishing_start_time = Stopwatch::tick();
+    SESyncOpts polish_opts = options;
+    polish_opts.r0 = d;
+    polish_opts.rmax = std::max(options.rmax, d);
+    polish_opts.max_iterations = polish_iterations;
+    polish_opts.verify = false;
+    polish_opts.hard_deadline = false;
+    polish_opts.log_iterates = false;
+    polish_opts.iterate_log_file.clear();
+    SESyncResult polished = SESync(problem, polish_opts, certificate.Y);
+    certificate.Y = polished.Yopt;
+    certificate.xhat = polished.xhat;
+    certificate.Fxhat = polished.Fxhat;
+    certificate.polishing_time = Stopwatch::tock(polishing_start_time);
+  } else {
+    certificate.xhat = xhat;
+    if (has_translations && problem.formulation() != Formulation::SOSync)
+      certificate.Fxhat = evaluate_objective(problem.measurements(), xhat);
+    else if (problem.formulation() == Formulation::SOSync)
+      certificate.Fxhat = evaluate_objective(problem.measurements(), R);
+    else
+      certificate.Fxhat = problem.evaluate_objective(certificate.Y);
+  }
+
+  /// VERIFICATION
+
+  auto verification_start_time = Stopwatch::tick();
+  certificate.gradnorm = problem.Riemannian_gradient(certificate.Y).norm();
+
+  Matrix Lambda_blocks = problem.compute_Lambda_blocks(certificate.Y);
+  for (size_t i = 0; i < n; ++i)
+    certificate.trLambda += Lambda_blocks.block(0, i * d, d, d).trace();
+  certificate.Lambda = problem.compute_Lambda_from_Lambda_blocks(Lambda_blocks);
+  certificate.suboptimality_bound = certificate.Fxhat - certificate.trLambda;
+
+  bool global_opt = problem.verify_solution(
+      certificate.Y, options.min_eig_num_tol, options.LOBPCG_block_size,
+      certificate.theta, certificate.escape_direction,
+      certificate.LOBPCG_iters, options.LOBPCG_max_iterations,
+      options.LOBPCG_max_fill_factor, options.LOBPCG_drop_tol);
+  certificate.verification_time = Stopwatch::tock(verification_start_time);
+
+  if (global_opt)
+    certificate.status = GlobalOpt;
+  else if (certificate.theta < -options.min_eig_num_tol / 2)
+    certificate.status = SaddlePoint;
+  else
+    certificate.status = EigImprecision;
+
+  certificate.total_computation_time = Stopwatch::tock(certify_start_time);
+
+  if (options.verbose)
+    std::cout << "Certification "
+              << (global_opt ? "succeeded" : "failed") << " (minimum "
+              << "eigenvalue " << certificate.theta << ", gradient norm "
+              << certificate.gradnorm << ", suboptimality bound "
+              << certificate.suboptimality_bound << "); elapsed computation "
+              << "time: " << certificate.total_computation_time << " seconds"
+              << std::endl;
+
+  return certificate;
+}
+
+bool escape_saddle(const SESyncProblem &problem, const Matrix &Y, Scalar theta,
+                   const Vector &v, Scalar gradient_tolerance,
+                   Scalar preconditioned_gradient_tolerance, Matrix &Yplus,
+                   size_t batch_size, bool model_guided_step,
+                   const std::function<bool()> &interrupt) {
+  return escape_saddle(problem, Y, Vector::Constant(1, theta), Matrix(v),
+                       gradient_tolerance, preconditioned_gradient_tolerance,
+                       Yplus, batch_size, model_guided_step, interrupt);
+}
+
+bool escape_saddle(const SESyncProblem &problem, const Matrix &Y,
+                   const Vector &thetas, const Matrix &V,
+                   Scalar gradient_tolerance,
+                   Scalar preconditioned_gradient_tolerance, Matrix &Yplus,
+                   size_t batch_size, bool model_guided_step,
+                   const std::function<bool()> &interrupt) {
+
+  /** v is an eigenvector corresponding to a negative eigenvalue of Q - Lambda,
+   * so the KKT conditions for the semidefinite relaxation are not satisfied;
+   * this implies that Y is a saddle point of the rank-restricted semidefinite
+   * optimization.  Fortunately, v_min can be used to compute a descent
+   * direction from this saddle point, as described in Theorem 3.9 of the paper
+   * "A Riemannian Low-Rank Method for Optimization over Semidefinite  Matrices
+   * with Block-Diagonal Constraints". Define the vector Ydot := e_{r+1} * v';
+   * this is a tangent vector to the domain of the SDP and provides a direction
+   * of negative curvature.
+   *
+   * More generally, given k orthonormal directions of negative curvature
+   * v_1, ..., v_k (the columns of V), the tangent vector
+   * Ydot := [e_{r+1}, ..., e_{r+k}] * V' / sqrt(k) is a unit-norm direction
+   * along which the curvature is the mean of the curvatures theta_i along the
+   * v_i, which lets us ascend k levels of the Staircase at once */
+
+  // Function value at current iterate (saddle point)
+  Scalar FY = problem.evaluate_objective(Y);
+
+  // Number of directions of negative curvature along which to escape
+  size_t k = V.cols();
+
+  // Curvature along the (unit-norm) escape direction Ydot
+  Scalar theta = thetas.mean();
+
+  // Relaxation rank at the NEXT level of the Riemannian Staircase, i.e. we
+  // require that r = Y.rows() + k
+  size_t r = problem.relaxation_rank();
+
+  // Construct the corresponding representation of the saddle point Y in the
+  // next level of the Riemannian Staircase by adding k rows of 0's
+  Matrix Y_augmented = Matrix::Zero(r, Y.cols());
+  Y_augmented.topRows(r - k) = Y;
+
+  Matrix Ydot = Matrix::Zero(r, Y.cols());
+  Ydot.bottomRows(k) = V.transpose() / sqrt(static_cast<Scalar>(k));
+
+  // Set the initial step length to the greater of 10 times the distance needed
+  // to arrive at a trial point whose gradient is large enough to avoid
+  // triggering the gradient norm tolerance stopping condition (according to the
+  // local second-order model), or at least 2^4 times the minimum admissible
+  // steplength,
+  Scalar alpha_min = 1e-6; // Minimum stepsize
+  Scalar alpha =
+      std::max(16 * alpha_min, 10 * gradient_tolerance / fabs(theta));
+
+  // Vectors of trial stepsizes and corresponding function values
+  std::vector<double> alphas;
+  std::vector<double> fvals;
+
+  if (model_guided_step) {
+    /// Since Y_augmented is zero in the rows in which Ydot is supported,
+    /// flipping the sign of alpha leaves the retracted point's Gram matrix
+    /// (and therefore the objective) unchanged; consequently, the objective
+    /// along the retraction curve is an even function of alpha whose
+    /// second-order coefficient is the curvature theta.  We therefore fit the
+    /// local quartic model
+    ///
+    /// F(alpha) ~ F(Y) + theta * alpha^2 + gamma * alpha^4
+    ///
+    /// using a single objective evaluation at the heuristic stepsize above,
+    /// and then begin the line search at the inflection point
+    /// alpha = sqrt(-theta / (6 * gamma)) of this model, which is where the
+    /// model's directional derivative (and hence, approximately, the norm of
+    /// the gradient) is largest, while still attaining 5/9 of the model's
+    /// maximum decrease
+    Matrix Ytest = problem.retract(Y_augmented, alpha * Ydot);
+    Scalar FYtest = problem.evaluate_objective(Ytest);
+
+    alphas.push_back(alpha);
+    fvals.push_back(FYtest);
+
+    Scalar gamma =
+        (FYtest - FY - theta * alpha * alpha) / (alpha * alpha * alpha * alpha);
+
+    if (gamma > 0) {
+      // Don't start below the stepsize at which the second-order model
+      // predicts that the gradient norm will exceed the gradient tolerance.
+      // Conversely, since the quartic model is only fitted locally (and a tiny
+      // gamma would predict an arbitrarily large stepsize), don't start above
+      // a small multiple of the stepsize at which it was fitted.
+      Scalar alpha_fit = alpha;
+      alpha = std::min(std::max({sqrt(-theta / (6 * gamma)),
+                                 2 * gradient_tolerance / fabs(theta),
+                                 16 * alpha_min}),
+                       4 * alpha_fit);
+    }
+  }
+
+  /// Backtracking line search
+
+  // Trial stepsizes are evaluated in batches of (at most) batch_size
+  // consecutive elements of the geometric sequence alpha, alpha / 2, ...; the
+  // objectives and gradients for all of the trial points in a batch are
+  // computed using a single (multiple-right-hand-side) product with the data
+  // matrix and a single preconditioner solve, and the batch is then scanned in
+  // the original order, so that the accepted step is the same one that the
+  // serial line search would select
+  batch_size = std::max<size_t>(1, batch_size);
+  size_t N = Y.cols();
+
+  while (alpha >= alpha_min) {
+    if (interrupt && interrupt())
+      return false;
+
+    // Assemble the next batch of trial stepsizes
+    std::vector<Scalar> batch_alphas;
+    for (; (batch_alphas.size() < batch_size) && (alpha >= alpha_min);
+         alpha /= 2)
+      batch_alphas.push_back(alpha);
+    size_t B = batch_alphas.size();
+
+    // Retract along the given tangent vector using each trial stepsize
+    std::vector<Matrix> Ytests(B);
+    for (size_t b = 0; b < B; ++b)
+      Ytests[b] = problem.retract(Y_augmented, batch_alphas[b] * Ydot);
+
+    // Compute the products of the data matrix with all trial points at once
+    Matrix Ytests_t(N, B * r);
+    for (size_t b = 0; b < B; ++b)
+      Ytests_t.middleCols(b * r, r) = Ytests[b].transpose();
+    Matrix SYtests_t = problem.data_matrix_product(Ytests_t);
+
+    // Ensure that each trial point Ytest has a lower function value than
+    // the current iterate Y, and that the gradient at Ytest is
+    // sufficiently large that we will not automatically trigger the
+    // gradient tolerance stopping criterion at the next iteration.  We check
+    // these conditions lazily, in order of increasing cost:  the Riemannian
+    // gradient is only computed at trial points that decrease the objective,
+    // and the preconditioned gradient (which requires a linear solve) is only
+    // computed at those trial points that also satisfy the gradient bound
+    std::vector<Scalar> FYtests(B);
+    std::vector<bool> candidate(B, false);
+    std::vector<Matrix> candidate_Ys, candidate_grads;
+    for (size_t b = 0; b < B; ++b) {
+      FYtests[b] = (Ytests[b] * SYtests_t.middleCols(b * r, r)).trace();
+      if (FYtests[b] < FY) {
+        Matrix grad_FYtest = problem.Riemannian_gradient(
+            Ytests[b], 2 * SYtests_t.middleCols(b * r, r).transpose());
+
+        if (grad_FYtest.norm() > gradient_tolerance) {
+          candidate[b] = true;
+          candidate_Ys.push_back(Ytests[b]);
+          candidate_grads.push_back(grad_FYtest);
+        }
+      }
+    }
+    std::vector<Matrix> preconditioned_grad_FYtests =
+        problem.precondition(candidate_Ys, candidate_grads);
+
+    for (size_t b = 0, c = 0; b < B; ++b) {
+      // Record trial stepsize and function value
+      alphas.push_back(batch_alphas[b]);
+      fvals.push_back(FYtests[b]);
+
+      if (candidate[b] && (preconditioned_grad_FYtests[c++].norm() >
+                           preconditioned_gradient_tolerance)) {
+        // Accept this trial point and return success
+        Yplus = Ytests[b];
+        return true;
+      }
+    }
+  }
+
+  // If control reaches here, we failed to find a trial point that satisfied
+  // *both* the function decrease *and* gradient bounds.  In order to make
+  // forward progress, we will fall back to accepting the trial point that
+  // simply minimized the objective value, provided that it strictly *decreased*
+  // the objective from the current (saddle) point
+
+  // Find minimum function value from among the trial points
+  auto fmin_iter = std::min_element(fvals.begin(), fvals.end());
+  auto min_idx = std::distance(fvals.begin(), fmin_iter);
+
+  double f_min = fvals[min_idx];
+  double a_min = alphas[min_idx];
+
+  if (f_min < FY) {
     // If this trial point strictly decreased the objective value, accept it and
     // return success
     Yplus = problem.retract(Y_augmented, a_min * Ydot);
@@ -668,4 +2506,73 @@ bool escape_saddle(const SESyncProblem &problem, const Matrix &Y, Scalar theta,
     return false;
   }
 }
+
+bool escape_saddle(const PlanarSESyncProblem &problem, const ComplexMatrix &Y,
+                   Scalar theta, const ComplexVector &v,
+                   Scalar gradient_tolerance,
+                   Scalar preconditioned_gradient_tolerance,
+                   ComplexMatrix &Yplus,
+                   const std::function<bool()> &interrupt) {
+
+  // As in the real case, the direction Ydot := e_{r+1} * v^H is a tangent
+  // vector along which the objective has negative curvature theta
+
+  // Function value at current iterate (saddle point)
+  Scalar FY = problem.evaluate_objective(Y);
+
+  // Relaxation rank at the NEXT level of the Riemannian Staircase
+  size_t r = problem.relaxation_rank();
+
+  ComplexMatrix Y_augmented = ComplexMatrix::Zero(r, Y.cols());
+  Y_augmented.topRows(r - 1) = Y;
+
+  ComplexMatrix Ydot = ComplexMatrix::Zero(r, Y.cols());
+  Ydot.bottomRows<1>() = v.adjoint();
+
+  Scalar alpha_min = 1e-6; // Minimum stepsize
+  Scalar alpha =
+      std::max(16 * alpha_min, 10 * gradient_tolerance / fabs(theta));
+
+  // Vectors of trial stepsizes and corresponding function values
+  std::vector<double> alphas;
+  std::vector<double> fvals;
+
+  /// Backtracking line search
+  ComplexMatrix Ytest;
+  while (alpha >= alpha_min) {
+    if (interrupt && interrupt())
+      return false;
+
+    Ytest = problem.retract(Y_augmented, alpha * Ydot);
+
+    Scalar FYtest = problem.evaluate_objective(Ytest);
+
+    alphas.push_back(alpha);
+    fvals.push_back(FYtest);
+
+    // Only evaluate the (preconditioned) gradient at trial points that
+    // decrease the objective
+    if (FYtest < FY) {
+      ComplexMatrix grad_FYtest = problem.Riemannian_gradient(Ytest);
+      if ((grad_FYtest.norm() > gradient_tolerance) &&
+          (problem.precondition(Ytest, grad_FYtest).norm() >
+           preconditioned_gradient_tolerance)) {
+        Yplus = Ytest;
+        return true;
+      }
+    }
+    alpha /= 2;
+  }
+
+  // Fall back to accepting the trial point that simply minimized the objective
+  // value, provided that it strictly decreased the objective
+  auto fmin_iter = std::min_element(fvals.begin(), fvals.end());
+  auto min_idx = std::distance(fvals.begin(), fmin_iter);
+
+  if (fvals[min_idx] < FY) {
+    Yplus = problem.retract(Y_augmented, alphas[min_idx] * Ydot);
+    return true;
+  } else
+    return false;
+}
 } // namespace SESync
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/SESyncBatch.h"
+
+namespace SESync {
+
+namespace {
+
+/** A double-ended queue of problem indices owned by a single worker.  The
+ * owner takes tasks from the back, while other workers steal from the front.
+ */
+class TaskDeque {
+private:
+  std::deque<size_t> tasks_;
+  std::mutex mutex_;
+
+public:
+  void push(size_t task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(task);
+  }
+
+  bool pop(size_t &task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty())
+      return false;
+    task = tasks_.back();
+    tasks_.pop_back();
+    return true;
+  }
+
+  bool steal(size_t &task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty())
+      return false;
+    task = tasks_.front();
+    tasks_.pop_front();
+    return true;
+  }
+};
+
+/** The pool of threads shared by all of the problems in a batch */
+class ThreadBudget {
+private:
+  size_t available_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+
+public:
+  explicit ThreadBudget(size_t num_threads) : available_(num_threads) {}
+
+  /** Blocks until at least one thread is available, and then acquires as many
+   * threads as possible (up to 'desired').  Returns the number of threads
+   * acquired. */
+  size_t acquire(size_t desired) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return available_ > 0; });
+    size_t n = std::min(std::max<size_t>(desired, 1), available_);
+    available_ -= n;
+    return n;
+  }
+
+  void release(size_t n) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      available_ += n;
+    }
+    cv_.notify_all();
+  }
+};
+
+} // namespace
+
+SESyncBatchResult SESyncBatch(const std::vector<measurements_t> &problems,
+                              const SESyncOpts &options,
+                              const SESyncBatchOpts &batch_options,
+                              const SESyncBatchCallback &callback) {
+  if (!options.iterate_log_file.empty())
+    throw std::invalid_argument(
+        "Iterate logging is not supported when solving a batch of problems");
+  if (batch_options.measurements_per_thread == 0)
+    throw std::invalid_argument("measurements_per_thread must be positive");
+
+  size_t num_threads = batch_options.num_threads;
+  if (num_threads == 0)
+    num_threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+
+  SESyncBatchResult batch_result;
+  batch_result.results.resize(problems.size());
+  batch_result.num_threads.resize(problems.size(), 0);
+
+  auto batch_start_time = Stopwatch::tick();
+
+  size_t num_workers = std::max<size_t>(
+      std::min<size_t>(num_threads, problems.size()), 1);
+
+  // Distribute the problems among the workers in round-robin fashion, in
+  // increasing order of size, so that each worker starts with its largest
+  // problem, and thieves take the smallest remaining ones
+  std::vector<size_t> order(problems.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&problems](size_t i, size_t j) {
+    return problems[i].size() < problems[j].size();
+  });
+
+  std::vector<TaskDeque> deques(num_workers);
+  for (size_t k = 0; k < order.size(); ++k)
+    deques[k % num_workers].push(order[k]);
+
+  ThreadBudget budget(num_threads);
+  std::mutex output_mutex;
+  std::vector<std::exception_ptr> exceptions(problems.size());
+
+  auto worker = [&](size_t w) {
+    size_t i;
+    while (true) {
+      // Take the next task from this worker's own deque, or steal one
+      bool found = deques[w].pop(i);
+      for (size_t v = 1; !found && v < num_workers; ++v)
+        found = deques[(w + v) % num_workers].steal(i);
+      if (!found)
+        return; // All problems have been claimed
+
+      size_t desired = (problems[i].size() +
+                        batch_options.measurements_per_thread - 1) /
+                       batch_options.measurements_per_thread;
+      size_t threads = budget.acquire(desired);
+
+      // Each run publishes its progress to a private monitor (runs on
+      // different workers must not write to the same one), which mirrors the
+      // cancellation of the batch's monitor
+      SESyncOpts problem_opts = options;
+      problem_opts.num_threads = threads;
+      problem_opts.monitor = SESyncMonitor::child(options.monitor);
+
+      auto start_time = Stopwatch::tick();
+      try {
+        batch_result.results[i] = SESync(problems[i], problem_opts);
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+      }
+      double elapsed_time = Stopwatch::tock(start_time);
+
+      budget.release(threads);
+      batch_result.num_threads[i] = threads;
+
+      if (!exceptions[i] && (batch_options.verbose || callback)) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (batch_options.verbose)
+          std::cout << "Problem " << i << " (" << problems[i].size()
+                    << " measurements, " << threads << " threads) finished in "
+                    << elapsed_time << " seconds" << std::endl;
+        if (callback)
+          callback(i, batch_result.results[i]);
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t w = 1; w < num_workers; ++w)
+    workers.emplace_back(worker, w);
+  worker(0);
+  for (std::thread &t : workers)
+    t.join();
+
+  batch_result.total_time = Stopwatch::tock(batch_start_time);
+  batch_result.throughput =
+      batch_result.total_time > 0 ? problems.size() / batch_result.total_time
+                                  : 0;
+
+  if (batch_options.verbose)
+    std::cout << "Solved " << problems.size() << " problems in "
+              << batch_result.total_time << " seconds ("
+              << batch_result.throughput << " problems/second)" << std::endl;
+
+  for (const std::exception_ptr &e : exceptions)
+    if (e)
+      std::rethrow_exception(e);
+
+  return batch_result;
+}
+
+} // namespace SESync
@@ -0,0 +1,46 @@
+#include "SESync/SESyncMonitor.h"
+
+namespace SESync {
+
+void SESyncMonitor::publish(const SESyncProgress &progress) {
+  // Mark the snapshot as being updated
+  uint64_t seq = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  phase_.store(static_cast<int>(progress.phase), std::memory_order_relaxed);
+  level_.store(progress.level, std::memory_order_relaxed);
+  iteration_.store(progress.iteration, std::memory_order_relaxed);
+  objective_value_.store(progress.objective_value, std::memory_order_relaxed);
+  gradient_norm_.store(progress.gradient_norm, std::memory_order_relaxed);
+  elapsed_time_.store(progress.elapsed_time, std::memory_order_relaxed);
+
+  // Mark the update as complete
+  sequence_.store(seq + 2, std::memory_order_release);
+}
+
+SESyncProgress SESyncMonitor::progress() const {
+  SESyncProgress progress;
+  uint64_t seq0, seq1;
+  do {
+    seq0 = sequence_.load(std::memory_order_acquire);
+
+    progress.phase =
+        static_cast<SESyncPhase>(phase_.load(std::memory_order_relaxed));
+    progress.level = level_.load(std::memory_order_relaxed);
+    progress.iteration = iteration_.load(std::memory_order_relaxed);
+    progress.objective_value =
+        objective_value_.load(std::memory_order_relaxed);
+    progress.gradient_norm = gradient_norm_.load(std::memory_order_relaxed);
+    progress.elapsed_time = elapsed_time_.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    seq1 = sequence_.load(std::memory_order_relaxed);
+
+    // Retry if the snapshot was modified while we were reading it
+  } while ((seq0 & 1) || seq0 != seq1);
+
+  return progress;
+}
+
+} // namespace SESync
@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/SESyncPortfolio.h"
+
+namespace SESync {
+
+namespace {
+
+const char *formulation_name(Formulation formulation) {
+  switch (formulation) {
+  case Formulation::Simplified:
+    return "Simplified";
+  case Formulation::Explicit:
+    return "Explicit";
+  case Formulation::SOSync:
+    return "SOSync";
+  }
+  return "";
+}
+
+const char *
+projection_factorization_name(ProjectionFactorization factorization) {
+  return factorization == ProjectionFactorization::Cholesky ? "Cholesky" : "QR";
+}
+
+const char *preconditioner_name(Preconditioner preconditioner) {
+  switch (preconditioner) {
+  case Preconditioner::None:
+    return "None";
+  case Preconditioner::Jacobi:
+    return "Jacobi";
+  case Preconditioner::RegularizedCholesky:
+    return "RegularizedCholesky";
+  }
+  return "";
+}
+
+const char *initialization_name(Initialization initialization) {
+  switch (initialization) {
+  case Initialization::Chordal:
+    return "Chordal";
+  case Initialization::Random:
+    return "Random";
+  case Initialization::Spectral:
+    return "Spectral";
+  case Initialization::SOSyncCascade:
+    return "SOSyncCascade";
+  case Initialization::Multilevel:
+    return "Multilevel";
+  }
+  return "";
+}
+
+const char *status_name(SESyncStatus status) {
+  switch (status) {
+  case GlobalOpt:
+    return "GlobalOpt";
+  case SaddlePoint:
+    return "SaddlePoint";
+  case EigImprecision:
+    return "EigImprecision";
+  case MaxRank:
+    return "MaxRank";
+  case ElapsedTime:
+    return "ElapsedTime";
+  case Cancelled:
+    return "Cancelled";
+  case Unverified:
+    return "Unverified";
+  }
+  return "";
+}
+
+} // namespace
+
+std::vector<SESyncOpts> default_portfolio(const SESyncOpts &base) {
+  std::vector<SESyncOpts> variants(5, base);
+
+  variants[1].formulation =
+      (base.formulation == Formulation::Explicit ? Formulation::Simplified
+                                                 : Formulation::Explicit);
+
+  variants[2].formulation = Formulation::Simplified;
+  variants[2].projection_factorization =
+      (base.projection_factorization == ProjectionFactorization::QR
+           ? ProjectionFactorization::Cholesky
+           : ProjectionFactorization::QR);
+
+  variants[3].preconditioner =
+      (base.preconditioner == Preconditioner::Jacobi
+           ? Preconditioner::RegularizedCholesky
+           : Preconditioner::Jacobi);
+
+  variants[4].initialization =
+      (base.initialization == Initialization::Random ? Initialization::Chordal
+                                                     : Initialization::Random);
+
+  return variants;
+}
+
+SESyncPortfolioResult
+SESyncPortfolio(const measurements_t &measurements,
+                const SESyncPortfolioOpts &portfolio_options) {
+  std::vector<SESyncOpts> variants = portfolio_options.variants;
+  if (variants.empty())
+    variants = default_portfolio();
+
+  for (const SESyncOpts &options : variants)
+    if (!options.iterate_log_file.empty())
+      throw std::invalid_argument(
+          "Iterate logging is not supported in a portfolio run");
+
+  size_t num_threads = portfolio_options.num_threads;
+  if (num_threads == 0)
+    num_threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+
+  SESyncPortfolioResult portfolio_result;
+  portfolio_result.runs.resize(variants.size());
+
+  // Divide the threads as evenly as possible among the configurations, and
+  // give each one its own monitor, so that it can be cancelled independently;
+  // this mirrors the cancellation of the configuration's own monitor (if any)
+  for (size_t k = 0; k < variants.size(); ++k) {
+    SESyncPortfolioRun &run = portfolio_result.runs[k];
+    run.options = variants[k];
+    run.num_threads = std::max<size_t>(
+        num_threads / variants.size() + (k < num_threads % variants.size()),
+        1);
+    run.options.num_threads = run.num_threads;
+    run.options.monitor = SESyncMonitor::child(variants[k].monitor);
+  }
+
+  std::mutex mutex;
+  bool have_winner = false;
+  std::vector<std::exception_ptr> exceptions(variants.size());
+
+  auto portfolio_start_time = Stopwatch::tick();
+
+  auto race = [&](size_t k) {
+    SESyncPortfolioRun &run = portfolio_result.runs[k];
+    SESyncResult result;
+    try {
+      result = SESync(measurements, run.options);
+    } catch (...) {
+      exceptions[k] = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    run.result = std::move(result);
+    run.failed = static_cast<bool>(exceptions[k]);
+    run.elapsed_time = Stopwatch::tock(portfolio_start_time);
+
+    if (!exceptions[k] && run.result.status == GlobalOpt && !have_winner) {
+      // This is the first configuration to reach a certified global optimum,
+      // so cancel the others
+      have_winner = true;
+      portfolio_result.winner = k;
+      for (size_t l = 0; l < portfolio_result.runs.size(); ++l)
+        if (l != k)
+          portfolio_result.runs[l].options.monitor->request_cancellation();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t k = 0; k < variants.size(); ++k)
+    threads.emplace_back(race, k);
+  for (std::thread &t : threads)
+    t.join();
+
+  portfolio_result.total_time = Stopwatch::tock(portfolio_start_time);
+
+  if (!have_winner) {
+    // No configuration reached a certified global optimum, so select the one
+    // whose rounded solution attained the lowest objective value
+    Scalar best_Fxhat = std::numeric_limits<Scalar>::infinity();
+    for (size_t k = 0; k < portfolio_result.runs.size(); ++k)
+      if (!exceptions[k] &&
+          portfolio_result.runs[k].result.Fxhat < best_Fxhat) {
+        best_Fxhat = portfolio_result.runs[k].result.Fxhat;
+        portfolio_result.winner = k;
+      }
+
+    // If every configuration failed, report the first failure
+    if (best_Fxhat == std::numeric_limits<Scalar>::infinity())
+      for (const std::exception_ptr &e : exceptions)
+        if (e)
+          std::rethrow_exception(e);
+  }
+
+  if (portfolio_options.verbose) {
+    for (size_t k = 0; k < portfolio_result.runs.size(); ++k) {
+      const SESyncPortfolioRun &run = portfolio_result.runs[k];
+      std::cout << "Configuration " << k << " ("
+                << formulation_name(run.options.formulation) << ", "
+                << projection_factorization_name(
+                       run.options.projection_factorization)
+                << ", " << preconditioner_name(run.options.preconditioner)
+                << ", " << initialization_name(run.options.initialization)
+                << ", " << run.num_threads << " threads): ";
+      if (run.failed)
+        std::cout << "failed";
+      else
+        std::cout << status_name(run.result.status) << " after "
+                  << run.elapsed_time << " seconds, F(x) = "
+                  << run.result.Fxhat;
+      if (k == portfolio_result.winner)
+        std::cout << " [winner]";
+      std::cout << std::endl;
+    }
+  }
+
+  if (!portfolio_options.record_file.empty())
+    write_portfolio_record(portfolio_options.record_file,
+                           portfolio_options.dataset_name, portfolio_result);
+
+  return portfolio_result;
+}
+
+void write_portfolio_record(const std::string &filename,
+                            const std::string &dataset_name,
+                            const SESyncPortfolioResult &portfolio_result) {
+  bool empty;
+  {
+    std::ifstream existing(filename, std::ios::ate);
+    empty = !existing || existing.tellg() <= 0;
+  }
+
+  std::ofstream record(filename, std::ios::app);
+  if (!record)
+    throw std::invalid_argument("Unable to open portfolio record file " +
+                                filename);
+
+  if (empty)
+    record << "dataset,formulation,projection_factorization,preconditioner,"
+              "initialization,num_threads,status,elapsed_time,"
+              "total_computation_time,Fxhat,suboptimality_bound,winner"
+           << std::endl;
+
+  for (size_t k = 0; k < portfolio_result.runs.size(); ++k) {
+    const SESyncPortfolioRun &run = portfolio_result.runs[k];
+    record << dataset_name << "," << formulation_name(run.options.formulation)
+           << ","
+           << projection_factorization_name(
+                  run.options.projection_factorization)
+           << "," << preconditioner_name(run.options.preconditioner) << ","
+           << initialization_name(run.options.initialization) << ","
+           << run.num_threads << ",";
+    if (run.failed)
+      record << "Failed," << run.elapsed_time << ",,,";
+    else
+      record << status_name(run.result.status) << "," << run.elapsed_time
+             << "," << run.result.total_computation_time << ","
+             << run.result.Fxhat << "," << run.result.suboptimality_bound;
+    record << "," << (k == portfolio_result.winner ? 1 : 0) << std::endl;
+  }
+}
+
+} // namespace SESync
@@ -2,51 +2,174 @@
 #include "SESync/SESync_utils.h"
 
 #include "Optimization/LinearAlgebra/LOBPCG.h"
+#include "Optimization/Util/Stopwatch.h"
 
+#include <algorithm>
 #include <random>
+#include <stdexcept>
 
 namespace SESync {
 
+namespace {
+
+/** Given a symmetric sparse matrix Delta, this function computes sparse
+ * matrices C_plus and C_minus such that Delta = C_plus * C_plus' - C_minus *
+ * C_minus' (up to rounding error) by means of a dense eigendecomposition of the
+ * principal submatrix of Delta supported on its nonzero rows.  Returns false
+ * if this support exceeds max_support rows. */
+bool low_rank_factor(SparseMatrix Delta, SparseMatrix &C_plus,
+                     SparseMatrix &C_minus, size_t max_support = 256) {
+  Delta.prune(Scalar(0));
+
+  std::vector<int> support;
+  for (int k = 0; k < Delta.outerSize(); ++k)
+    if (Delta.outerIndexPtr()[k + 1] > Delta.outerIndexPtr()[k])
+      support.push_back(k);
+
+  if (support.size() > max_support)
+    return false;
+
+  C_plus.resize(Delta.rows(), 0);
+  C_minus.resize(Delta.rows(), 0);
+  if (support.empty())
+    return true;
+
+  std::vector<int> position(Delta.rows(), -1);
+  for (size_t k = 0; k < support.size(); ++k)
+    position[support[k]] = k;
+
+  Matrix Ds = Matrix::Zero(support.size(), support.size());
+  for (size_t k = 0; k < support.size(); ++k)
+    for (SparseMatrix::InnerIterator it(Delta, support[k]); it; ++it)
+      Ds(k, position[it.col()]) = it.value();
+
+  Eigen::SelfAdjointEigenSolver<Matrix> eig(Ds);
+
+  // Discard the (numerically) zero eigenvalues
+  Scalar tol = 1e-12 * eig.eigenvalues().cwiseAbs().maxCoeff();
+
+  std::vector<Eigen::Triplet<Scalar>> plus_triplets, minus_triplets;
+  size_t plus_rank = 0, minus_rank = 0;
+  for (size_t c = 0; c < support.size(); ++c) {
+    Scalar lambda = eig.eigenvalues()(c);
+    if (std::abs(lambda) <= tol)
+      continue;
+
+    std::vector<Eigen::Triplet<Scalar>> &triplets =
+        (lambda > 0 ? plus_triplets : minus_triplets);
+    size_t &rank = (lambda > 0 ? plus_rank : minus_rank);
+    for (size_t k = 0; k < support.size(); ++k)
+      triplets.emplace_back(support[k], rank,
+                            std::sqrt(std::abs(lambda)) *
+                                eig.eigenvectors()(k, c));
+    ++rank;
+  }
+
+  C_plus.resize(Delta.rows(), plus_rank);
+  C_plus.setFromTriplets(plus_triplets.begin(), plus_triplets.end());
+  C_minus.resize(Delta.rows(), minus_rank);
+  C_minus.setFromTriplets(minus_triplets.begin(), minus_triplets.end());
+  return true;
+}
+
+/** Modifies the given factorization of a matrix A to that of A + Delta, by
+ * means of a rank-k update followed by a rank-k downdate (so that the
+ * intermediate matrix remains positive-definite).  Returns false if the
+ * factorization must instead be recomputed. */
+bool modify_factorization(SparseCholeskyFactorization &factorization,
+                          const SparseMatrix &Delta) {
+  SparseMatrix C_plus, C_minus;
+  return low_rank_factor(Delta, C_plus, C_minus) &&
+         factorization.update(C_plus) && factorization.update(C_minus, true);
+}
+
+} // namespace
+
+bool SparseCholeskyFactorization::update(const SparseMatrix &C,
+                                         bool downdate) {
+  if (!m_factorizationIsOk || !m_cholmodFactor ||
+      static_cast<size_t>(C.rows()) != m_cholmodFactor->n)
+    return false;
+
+  if (C.cols() == 0)
+    return true;
+
+  // CHOLMOD requires the update matrix to be stored in (packed) compressed
+  // column format, with its rows permuted according to the fill-reducing
+  // ordering of the factor
+  Eigen::SparseMatrix<Scalar, Eigen::ColMajor, SparseMatrix::StorageIndex>
+      C_col = C;
+  C_col.makeCompressed();
+  cholmod_sparse C_cm = Eigen::viewAsCholmod(C_col);
+  cholmod_sparse *C_perm = cholmod_submatrix(
+      &C_cm, static_cast<int *>(m_cholmodFactor->Perm), m_cholmodFactor->n,
+      nullptr, -1, true, true, &cholmod());
+  if (!C_perm)
+    return false;
+
+  // NB:  CHOLMOD converts the factor to simplicial LDL' form if necessary
+  int success = cholmod_updown(!downdate, C_perm, m_cholmodFactor, &cholmod());
+  cholmod_free_sparse(&C_perm, &cholmod());
+
+  if (!success || cholmod().status != CHOLMOD_OK) {
+    // The factorization is no longer valid, and must be recomputed
+    m_info = Eigen::NumericalIssue;
+    m_factorizationIsOk = false;
+    return false;
+  }
+  return true;
+}
+
 SESyncProblem::SESyncProblem(
     const measurements_t &measurements, const Formulation &formulation,
     const ProjectionFactorization &projection_factorization,
     const Preconditioner &precon, Scalar reg_chol_precon_max_cond)
-    : form_(formulation), projection_factorization_(projection_factorization),
+    : form_(formulation), measurements_(measurements),
+      projection_factorization_(projection_factorization),
       preconditioner_(precon),
       reg_Chol_precon_max_cond_(reg_chol_precon_max_cond) {
 
+  construct_data_matrices();
+
+  // Set the relaxation rank to its minimum value
+  r_ = d_;
+  SP_.set_p(r_);
+
+  construct_projection_factorization();
+  construct_preconditioner();
+}
+
+void SESyncProblem::construct_data_matrices() {
   /// Construct oriented incidence matrix for the underlying pose graph
-  A_ = construct_oriented_incidence_matrix(measurements);
+  A_ = construct_oriented_incidence_matrix(measurements_);
 
   /// SET PROBLEM DIMENSIONS
 
   /// Set dimensions of the problem
   n_ = A_.rows();
   m_ = A_.cols();
-  d_ = (!measurements.empty() ? measurements[0].R.rows() : 0);
-  r_ = d_;
+  d_ = (!measurements_.empty() ? measurements_[0].R.rows() : 0);
 
   /// Set dimensions of the product of Stiefel manifolds in which the
   /// (generalized) rotational states lie
   SP_.set_k(d_);
   SP_.set_n(n_);
-  SP_.set_p(r_);
 
   /// Construct B matrices
 
   // Matrix B3 is required by all methods to construct chordal initializations
-  B3_ = construct_B3_matrix(measurements);
+  B3_ = construct_B3_matrix(measurements_);
 
   if (form_ != Formulation::SOSync) {
     // When solving the Simplified or Explicit forms of the problem, we also
     // require the matrices B1 and B2 to calculate chordal initializations
     // and/or recover the optimal assignment t(R) of the translational states
     // corresponding to the estimate for the robot orientations
-    construct_B1_B2_matrices(measurements, B1_, B2_);
+    construct_B1_B2_matrices(measurements_, B1_, B2_);
 
     // The full data matrix M is also needed for either form of
     // SE-synchronization
-    M_ = construct_M_matrix(measurements);
+    M_ = construct_M_matrix(measurements_);
   }
 
   /// Construct any additional auxiliary data matrices that are required
@@ -57,17 +180,17 @@ SESyncProblem::SESyncProblem(
     /// formulations of the problem
 
     // Construct rotational connection Laplacian
-    LGrho_ = construct_rotational_connection_Laplacian(measurements);
+    LGrho_ = construct_rotational_connection_Laplacian(measurements_);
 
     if (form_ == Formulation::Simplified) {
 
-      /// Construct the auxiliary data (matrices and cached factorizations)
-      /// needed to compute products with the objective matrix Q
+      /// Construct the auxiliary data matrices needed to compute products with
+      /// the objective matrix Q
 
       // Construct square root of the (diagonal) matrix of translational
       // measurement precisions
       DiagonalMatrix SqrtOmega =
-          construct_translational_precision_matrix(measurements)
+          construct_translational_precision_matrix(measurements_)
               .diagonal()
               .cwiseSqrt()
               .asDiagonal();
@@ -81,31 +204,57 @@ SESyncProblem::SESyncProblem(
       SqrtOmega_AredT_ = Ared_SqrtOmega_.transpose();
 
       // Construct translational data matrix T
-      SparseMatrix T = construct_translational_data_matrix(measurements);
+      SparseMatrix T = construct_translational_data_matrix(measurements_);
 
       SqrtOmega_T_ = SqrtOmega * T;
       // Likewise, we also cache this transpose
       TT_SqrtOmega_ = SqrtOmega_T_.transpose();
-
-      /// Construct matrices necessary to compute orthogonal projection onto the
-      /// kernel of the weighted reduced oriented incidence matrix
-      /// Ared_SqrtOmega
-      if (projection_factorization_ == ProjectionFactorization::Cholesky) {
-        // Compute and cache the Cholesky factor L of Ared * Omega * Ared^T
-        L_.compute(Ared_SqrtOmega_ * SqrtOmega_AredT_);
-      } else {
-        // Compute the QR decomposition of Omega^(1/2) * Ared^T (cf. eq. (98) of
-        // the tech report).Note that Eigen's sparse QR factorization can only
-        // be called on matrices stored in compressed format
-        SqrtOmega_AredT_.makeCompressed();
-
-        QR_ = new SparseQRFactorization();
-        QR_->compute(SqrtOmega_AredT_);
-      }
     } // if (form_ == Formulation::Simplified)
   }   // Auxiliary data matrix construction
+}
+
+bool SESyncProblem::construct_projection_factorization(bool refactor) {
+  if (form_ != Formulation::Simplified)
+    return true;
+
+  bool refactored = refactor;
+
+  /// Construct matrices necessary to compute orthogonal projection onto the
+  /// kernel of the weighted reduced oriented incidence matrix Ared_SqrtOmega
+  auto projection_factorization_start_time = Stopwatch::tick();
+  if (projection_factorization_ == ProjectionFactorization::Cholesky) {
+    // Compute and cache the Cholesky factor L of Ared * Omega * Ared^T
+    SparseMatrix AOA = Ared_SqrtOmega_ * SqrtOmega_AredT_;
+    if (refactor)
+      L_.factorize(AOA);
+    if (!refactor || L_.info() != Eigen::Success) {
+      L_.compute(AOA);
+      refactored = false;
+    }
+    projection_factor_nnz_ = L_.cholmod().lnz;
+  } else {
+    // Compute the QR decomposition of Omega^(1/2) * Ared^T (cf. eq. (98) of
+    // the tech report).Note that Eigen's sparse QR factorization can only
+    // be called on matrices stored in compressed format
+    SqrtOmega_AredT_.makeCompressed();
+
+    if (QR_)
+      delete QR_;
+    QR_ = new SparseQRFactorization();
+    QR_->compute(SqrtOmega_AredT_);
+    projection_factor_nnz_ = QR_->matrixR().nonZeros();
+
+    // (Eigen's SPQR interface does not expose the symbolic analysis)
+    refactored = false;
+  }
+  projection_factorization_time_ =
+      Stopwatch::tock(projection_factorization_start_time);
+  return refactored;
+}
 
-  /// PRECONDITIONER CONSTRUCTION
+bool SESyncProblem::construct_preconditioner(bool estimate_norm,
+                                             bool refactor) {
+  bool refactored = refactor;
 
   if (preconditioner_ == Preconditioner::Jacobi) {
 
@@ -127,48 +276,269 @@ SESyncProblem::SESyncProblem(
     // M for SE-synchronization
     const SparseMatrix &D = (form_ == Formulation::SOSync ? LGrho_ : M_);
 
-    /// Next, we must estimate the spectral norm of D in order to determine
-    /// the value of the regularization constant lambda_reg necessary to
-    /// guarantee that the upper bound for the desired condition number of the
-    /// preconditioner P is achieved
+    if (estimate_norm) {
+      /// Next, we must estimate the spectral norm of D in order to determine
+      /// the value of the regularization constant lambda_reg necessary to
+      /// guarantee that the upper bound for the desired condition number of
+      /// the preconditioner P is achieved
+
+      // Here we use the fact that D >= 0, so that
+      // ||D||_2 = lambda_max(D) = - lambda_min(-D)
+
+      Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix> neg_D_op =
+          [&D](const Matrix &X) -> Matrix { return -(D * X); };
+
+      // Estimate the algebraically-smallest eigenvalue of -D using LOBPCG
+
+      auto norm_estimate_start_time = Stopwatch::tick();
+      size_t num_iters;
+      size_t nc;
+      Vector theta;
+      Matrix X;
+      std::tie(theta, X) = Optimization::LinearAlgebra::LOBPCG<Vector, Matrix>(
+          neg_D_op,
+          std::optional<
+              Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(
+              std::nullopt),
+          std::optional<
+              Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(
+              std::nullopt),
+          D.rows(), 4, 1, 100, num_iters, nc, 1e-2);
+
+      // Extract estimated norm of M
+      Scalar Dnorm = -theta(0);
+      preconditioner_norm_estimate_time_ =
+          Stopwatch::tock(norm_estimate_start_time);
+
+      // Compute the required value of the regularization parameter
+      // lambda_reg
+      reg_Chol_precon_lambda_ = Dnorm / (reg_Chol_precon_max_cond_ - 1);
+    }
+
+    /// Construct and factor the regularized data matrix P := D + lambda_reg * I
+
+    // Construct regularized data matrix Mbar
+    SparseMatrix P =
+        D + SparseMatrix(Vector::Constant(D.rows(), reg_Chol_precon_lambda_)
+                             .asDiagonal());
+
+    // Compute and cache Cholesky factorization of Mbar
+    auto preconditioner_factorization_start_time = Stopwatch::tick();
+    if (refactor)
+      reg_Chol_precon_.factorize(P);
+    if (!refactor || reg_Chol_precon_.info() != Eigen::Success) {
+      reg_Chol_precon_.compute(P);
+      refactored = false;
+    }
+    preconditioner_factor_nnz_ = reg_Chol_precon_.cholmod().lnz;
+    preconditioner_factorization_time_ =
+        Stopwatch::tock(preconditioner_factorization_start_time);
+  } // Preconditioner construction
+  return refactored;
+}
 
-    // Here we use the fact that D >= 0, so that
-    // ||D||_2 = lambda_max(D) = - lambda_min(-D)
+bool SESyncProblem::add_measurements(const measurements_t &measurements) {
+  if (measurements.empty())
+    return true;
+
+  size_t n_new = n_;
+  for (const RelativePoseMeasurement &measurement : measurements)
+    n_new = std::max(n_new, std::max(measurement.i, measurement.j) + 1);
+
+  // Verify that the new states are numbered consecutively, starting at n_
+  std::vector<bool> referenced(n_new - n_, false);
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    if (measurement.i >= n_)
+      referenced[measurement.i - n_] = true;
+    if (measurement.j >= n_)
+      referenced[measurement.j - n_] = true;
+  }
+  if (std::find(referenced.begin(), referenced.end(), false) !=
+      referenced.end())
+    throw std::invalid_argument("The indices of the new states introduced by "
+                                "appended measurements must be consecutive");
+
+  // Verify that each new state is connected to the existing pose graph (which
+  // is itself connected), using a union-find structure over the new states in
+  // which the existing states are represented by the single element 0;
+  // otherwise, the data matrices of the extended problem would be singular
+  std::vector<size_t> parent(n_new - n_ + 1);
+  for (size_t k = 0; k < parent.size(); ++k)
+    parent[k] = k;
+  auto find = [&parent](size_t k) {
+    while (parent[k] != k)
+      k = parent[k] = parent[parent[k]];
+    return k;
+  };
+  auto element = [this](size_t i) { return (i < n_ ? 0 : i - n_ + 1); };
+  for (const RelativePoseMeasurement &measurement : measurements)
+    parent[find(element(measurement.i))] = find(element(measurement.j));
+  for (size_t k = 1; k < parent.size(); ++k)
+    if (find(k) != find(0))
+      throw std::invalid_argument("Each new state introduced by appended "
+                                  "measurements must be connected to the "
+                                  "existing pose graph");
+
+  measurements_t all_measurements = measurements_;
+  all_measurements.insert(all_measurements.end(), measurements.begin(),
+                          measurements.end());
+  return set_measurements(all_measurements);
+}
 
-    Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix> neg_D_op =
-        [&D](const Matrix &X) -> Matrix { return -(D * X); };
+bool SESyncProblem::set_measurements(const measurements_t &measurements) {
+  if (measurements.empty())
+    throw std::invalid_argument("A problem must contain measurements");
+
+  for (const RelativePoseMeasurement &measurement : measurements)
+    if (measurement.R.rows() != d_)
+      throw std::invalid_argument(
+          "Measurements must have the same dimension as the problem");
+
+  // Cache the matrices factored by L_ and the preconditioner, in order to
+  // compute their changes below
+  SparseMatrix AOA_old, D_old;
+  if (form_ == Formulation::Simplified &&
+      projection_factorization_ == ProjectionFactorization::Cholesky)
+    AOA_old = Ared_SqrtOmega_ * SqrtOmega_AredT_;
+  if (preconditioner_ == Preconditioner::RegularizedCholesky)
+    D_old = (form_ == Formulation::SOSync ? LGrho_ : M_);
+
+  size_t n_old = n_;
+  measurements_ = measurements;
+
+  // Reassemble the (sparse) data matrices; this requires only linear time
+  construct_data_matrices();
+
+  if (n_ != n_old) {
+    // CHOLMOD factorizations have fixed dimensions, so if the number of states
+    // has changed, we must recompute them.  We reuse the previous
+    // regularization constant lambda_reg for the preconditioner (since the
+    // norm of the data matrix changes only slightly when a few measurements
+    // are modified), in order to avoid re-estimating the norm of the data
+    // matrix
+    construct_projection_factorization();
+    construct_preconditioner(false);
+    return false;
+  }
 
-    // Estimate the algebraically-smallest eigenvalue of -D using LOBPCG
+  bool updated = true;
+
+  if (form_ == Formulation::Simplified) {
+    auto projection_factorization_start_time = Stopwatch::tick();
+    SparseMatrix AOA;
+    if (projection_factorization_ == ProjectionFactorization::Cholesky)
+      AOA = Ared_SqrtOmega_ * SqrtOmega_AredT_;
+    if (projection_factorization_ == ProjectionFactorization::Cholesky &&
+        modify_factorization(L_, AOA - AOA_old))
+      projection_factorization_time_ =
+          Stopwatch::tock(projection_factorization_start_time);
+    else {
+      // (SPQR does not support modifying a factorization in place)
+      construct_projection_factorization();
+      updated = false;
+    }
+  }
 
-    size_t num_iters;
-    size_t nc;
-    Vector theta;
-    Matrix X;
-    std::tie(theta, X) = Optimization::LinearAlgebra::LOBPCG<Vector, Matrix>(
-        neg_D_op,
-        std::optional<
-            Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(
-            std::nullopt),
-        std::optional<
-            Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(
-            std::nullopt),
-        D.rows(), 4, 1, 100, num_iters, nc, 1e-2);
+  if (preconditioner_ == Preconditioner::RegularizedCholesky) {
+    auto preconditioner_factorization_start_time = Stopwatch::tick();
+    if (modify_factorization(reg_Chol_precon_,
+                             (form_ == Formulation::SOSync ? LGrho_ : M_) -
+                                 D_old))
+      preconditioner_factorization_time_ =
+          Stopwatch::tock(preconditioner_factorization_start_time);
+    else {
+      construct_preconditioner(false);
+      updated = false;
+    }
+  } else
+    construct_preconditioner();
+
+  return updated;
+}
 
-    // Extract estimated norm of M
-    Scalar Dnorm = -theta(0);
+bool SESyncProblem::set_measurement_precisions(const Vector &kappa,
+                                               const Vector &tau) {
+  if (static_cast<size_t>(kappa.size()) != m_ ||
+      static_cast<size_t>(tau.size()) != m_)
+    throw std::invalid_argument(
+        "The number of precisions must equal the number of measurements");
 
-    // Compute the required value of the regularization parameter lambda_reg
-    Scalar lambda_reg = Dnorm / (reg_Chol_precon_max_cond_ - 1);
+  if ((kappa.array() <= 0).any() || (tau.array() <= 0).any())
+    throw std::invalid_argument("Measurement precisions must be positive");
 
-    /// Construct and factor the regularized data matrix P := D + lambda_reg * I
+  for (size_t k = 0; k < m_; ++k) {
+    measurements_[k].kappa = kappa(k);
+    measurements_[k].tau = tau(k);
+  }
 
-    // Construct regularized data matrix Mbar
-    SparseMatrix P =
-        D + SparseMatrix(Vector::Constant(D.rows(), lambda_reg).asDiagonal());
+  // Reassemble the (sparse) data matrices; this requires only linear time
+  construct_data_matrices();
 
-    // Compute and cache Cholesky factorization of Mbar
-    reg_Chol_precon_.compute(P);
-  } // Preconditioner construction
+  // Refactor the data matrices numerically; their sparsity patterns (and
+  // hence the symbolic analyses of their factorizations) are unchanged
+  bool refactored = construct_projection_factorization(true);
+  refactored = construct_preconditioner(false, true) && refactored;
+  return refactored;
+}
+
+Matrix SESyncProblem::extend_iterate(const Matrix &Y, size_t num_states) const {
+  if (num_states > n_)
+    throw std::invalid_argument(
+        "Number of states of the iterate to be extended exceeds that of the "
+        "problem");
+
+  size_t offset = (form_ == Formulation::Explicit ? n_ : 0);
+  size_t Y_offset = (form_ == Formulation::Explicit ? num_states : 0);
+  if (Y.cols() != Y_offset + d_ * num_states)
+    throw std::invalid_argument(
+        "Iterate to be extended has an incorrect number of columns");
+
+  size_t r = Y.rows();
+  Matrix Yext = Matrix::Zero(r, offset + d_ * n_);
+  Yext.leftCols(Y_offset) = Y.leftCols(Y_offset);
+  Yext.middleCols(offset, d_ * num_states) =
+      Y.middleCols(Y_offset, d_ * num_states);
+
+  // Propagate the (generalized) poses of the known states to the new ones
+  // along the measurements that connect them, using x_j = x_i * x_ij
+  std::vector<bool> known(n_, false);
+  std::fill(known.begin(), known.begin() + num_states, true);
+
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (const RelativePoseMeasurement &measurement : measurements_) {
+      size_t i = measurement.i;
+      size_t j = measurement.j;
+      if (known[i] == known[j])
+        continue;
+
+      if (known[i]) {
+        Yext.middleCols(offset + d_ * j, d_) =
+            Yext.middleCols(offset + d_ * i, d_) * measurement.R;
+        if (form_ == Formulation::Explicit)
+          Yext.col(j) = Yext.col(i) +
+                        Yext.middleCols(offset + d_ * i, d_) * measurement.t;
+        known[j] = true;
+      } else {
+        Yext.middleCols(offset + d_ * i, d_) =
+            Yext.middleCols(offset + d_ * j, d_) * measurement.R.transpose();
+        if (form_ == Formulation::Explicit)
+          Yext.col(i) = Yext.col(j) -
+                        Yext.middleCols(offset + d_ * i, d_) * measurement.t;
+        known[i] = true;
+      }
+      progress = true;
+    }
+  }
+
+  // Any states that are not connected to the known ones are initialized to
+  // the identity
+  for (size_t k = num_states; k < n_; ++k)
+    if (!known[k])
+      Yext.middleCols(offset + d_ * k, d_) = Matrix::Identity(r, d_);
+
+  return Yext;
 }
 
 void SESyncProblem::set_relaxation_rank(size_t rank) {
@@ -177,6 +547,7 @@ void SESyncProblem::set_relaxation_rank(size_t rank) {
 }
 
 Matrix SESyncProblem::data_matrix_product(const Matrix &Y) const {
+  ++num_data_matrix_products_;
   if (form_ == Formulation::Simplified)
     return Q_product(Y);
   else if (form_ == Formulation::Explicit)
@@ -185,6 +556,13 @@ Matrix SESyncProblem::data_matrix_product(const Matrix &Y) const {
     return LGrho_ * Y;
 }
 
+const SparseMatrix &SESyncProblem::data_matrix() const {
+  if (form_ == Formulation::Simplified)
+    throw std::invalid_argument("The data matrix of the Simplified formulation "
+                                "is not formed explicitly");
+  return (form_ == Formulation::Explicit ? M_ : LGrho_);
+}
+
 Scalar SESyncProblem::evaluate_objective(const Matrix &Y) const {
   return (Y * data_matrix_product(Y.transpose())).trace();
 }
@@ -234,6 +612,11 @@ Matrix SESyncProblem::precondition(const Matrix &Y, const Matrix &dotY) const {
     return tangent_space_projection(Y, dotY * Jacobi_precon_);
   else {
     // preconditioner == RegularizedCholesky
+    ++num_linear_solves_;
+    SESYNC_KERNEL_SCOPE(Kernel::PreconditionerSolve,
+                        4.0 * preconditioner_factor_nnz_ * dotY.rows(),
+                        24.0 * preconditioner_factor_nnz_ +
+                            16.0 * M_.rows() * dotY.rows());
     if (form_ != Formulation::Simplified) {
       return tangent_space_projection(
           Y, reg_Chol_precon_.solve(dotY.transpose()).transpose());
@@ -268,6 +651,51 @@ Matrix SESyncProblem::precondition(const Matrix &Y, const Matrix &dotY) const {
   }   // preconditioner == RegularizedCholesky
 }
 
+std::vector<Matrix>
+SESyncProblem::precondition(const std::vector<Matrix> &Ys,
+                            const std::vector<Matrix> &dotYs) const {
+  std::vector<Matrix> PdotYs(dotYs.size());
+
+  if (preconditioner_ != Preconditioner::RegularizedCholesky) {
+    // These preconditioners don't require any linear solves
+    for (size_t k = 0; k < dotYs.size(); ++k)
+      PdotYs[k] = precondition(Ys[k], dotYs[k]);
+    return PdotYs;
+  }
+
+  if (dotYs.empty())
+    return PdotYs;
+
+  // Stack the (transposed) tangent vectors side-by-side, in order to perform
+  // all of the required solves at once
+  size_t p = dotYs[0].rows();
+  size_t N = dotYs[0].cols();
+  size_t offset = (form_ == Formulation::Simplified ? M_.rows() - N : 0);
+
+  Matrix rhs = Matrix::Zero(offset + N, p * dotYs.size());
+  for (size_t k = 0; k < dotYs.size(); ++k)
+    rhs.block(offset, k * p, N, p) = dotYs[k].transpose();
+
+  // Solve linear system.  (When preconditioning the Simplified form of the
+  // problem, we extract the trailing block of the solution, as described in
+  // the single-tangent-vector version of this function above)
+  ++num_linear_solves_;
+  Matrix Z;
+  {
+    SESYNC_KERNEL_SCOPE(Kernel::PreconditionerSolve,
+                        4.0 * preconditioner_factor_nnz_ * rhs.cols(),
+                        24.0 * preconditioner_factor_nnz_ +
+                            16.0 * rhs.size());
+    Z = reg_Chol_precon_.solve(rhs);
+  }
+
+  for (size_t k = 0; k < dotYs.size(); ++k)
+    PdotYs[k] = tangent_space_projection(
+        Ys[k], Z.block(offset, k * p, N, p).transpose());
+
+  return PdotYs;
+}
+
 Matrix SESyncProblem::tangent_space_projection(const Matrix &Y,
                                                const Matrix &dotY) const {
   if (form_ == Formulation::Simplified || form_ == Formulation::SOSync)
@@ -304,53 +732,12 @@ Matrix SESyncProblem::retract(const Matrix &Y, const Matrix &dotY) const {
 }
 
 Matrix SESyncProblem::round_solution(const Matrix Y) const {
-
-  // First, compute a thin SVD of Y
-  Eigen::JacobiSVD<Matrix> svd(Y, Eigen::ComputeThinV);
-
-  Vector sigmas = svd.singularValues();
-  // Construct a diagonal matrix comprised of the first d singular values
-  DiagonalMatrix Sigma_d(d_);
-  DiagonalMatrix::DiagonalVectorType &diagonal = Sigma_d.diagonal();
-  for (size_t i = 0; i < d_; ++i)
-    diagonal(i) = sigmas(i);
-
-  // First, construct a rank-d truncated singular value decomposition for Y
-  Matrix R = Sigma_d * svd.matrixV().leftCols(d_).transpose();
-
-  Vector determinants(n_);
-
   // Compute the offset at which the rotation matrix blocks begin
   size_t rot_offset =
       ((form_ == Formulation::Simplified || form_ == Formulation::SOSync) ? 0
                                                                           : n_);
 
-  size_t ng0 = 0; // This will count the number of blocks whose
-  // determinants have positive sign
-  for (size_t i = 0; i < n_; ++i) {
-    // Compute the determinant of the ith dxd block of R
-    determinants(i) = R.block(0, rot_offset + i * d_, d_, d_).determinant();
-    if (determinants(i) > 0)
-      ++ng0;
-  }
-
-  if (ng0 < n_ / 2) {
-    // Less than half of the total number of blocks have the correct sign, so
-    // reverse their orientations
-
-    // Get a reflection matrix that we can use to reverse the signs of those
-    // blocks of R that have the wrong determinant
-    Matrix reflector = Matrix::Identity(d_, d_);
-    reflector(d_ - 1, d_ - 1) = -1;
-
-    R = reflector * R;
-  }
-
-// Finally, project each dxd rotation block to SO(d)
-#pragma omp parallel for
-  for (size_t i = 0; i < n_; ++i)
-    R.block(0, rot_offset + i * d_, d_, d_) =
-        project_to_SOd(R.block(0, rot_offset + i * d_, d_, d_));
+  Matrix R = SESync::round_solution(Y, d_, rot_offset);
 
   if ((form_ == Formulation::Explicit) || (form_ == Formulation::SOSync)) {
     // In this case, either the matrix R already includes the translation
@@ -432,6 +819,25 @@ bool SESyncProblem::verify_solution(const Matrix &Y, Scalar eta, size_t nx,
                                     size_t max_LOBPCG_iters,
                                     Scalar max_fill_factor,
                                     Scalar drop_tol) const {
+  Vector thetas;
+  Matrix X;
+  bool PSD = verify_solution(Y, eta, nx, 1, thetas, X, num_iters,
+                             max_LOBPCG_iters, max_fill_factor, drop_tol);
+
+  theta = thetas(0);
+  if (!PSD)
+    x = X.col(0);
+
+  return PSD;
+}
+
+bool SESyncProblem::verify_solution(const Matrix &Y, Scalar eta, size_t nx,
+                                    size_t num_directions, Vector &thetas,
+                                    Matrix &X, size_t &num_iters,
+                                    size_t max_LOBPCG_iters,
+                                    Scalar max_fill_factor, Scalar drop_tol,
+                                    const std::function<bool()> &interrupt)
+    const {
 
   /// Construct certificate matrix S
 
@@ -449,39 +855,86 @@ bool SESyncProblem::verify_solution(const Matrix &Y, Scalar eta, size_t nx,
 
   /// Test positive-semidefiniteness of certificate matrix S using fast
   /// verification method
-  bool PSD = fast_verification(S, eta, nx, theta, x, num_iters,
-                               max_LOBPCG_iters, max_fill_factor, drop_tol);
+  size_t num_operator_applications;
+  bool PSD = fast_verification(S, eta, nx, num_directions, thetas, X,
+                               num_iters, max_LOBPCG_iters, max_fill_factor,
+                               drop_tol, &num_operator_applications,
+                               interrupt);
+  num_LOBPCG_operator_applications_ += num_operator_applications;
 
   if (!PSD && (form_ == Formulation::Simplified)) {
-    // Extract the (trailing) portion of the tangent vector corresponding to the
-    // rotational states
-    Vector v = x.tail(n_ * d_).normalized();
-    x = v;
-
-    // Compute x's Rayleight quotient with the simplified certificate matrix
+    // Extract the (trailing) portion of the tangent vectors corresponding to
+    // the rotational states
+    Matrix V = X.bottomRows(n_ * d_);
+
+    if (V.cols() == 1)
+      V.normalize();
+    else {
+      // These are no longer necessarily orthonormal, so reorthonormalize them
+      // (preserving the span of the leading columns)
+      Eigen::HouseholderQR<Matrix> qr(V);
+      V = qr.householderQ() * Matrix::Identity(V.rows(), V.cols());
+    }
+
+    // Compute the Rayleigh quotients of these directions with the simplified
+    // certificate matrix
     SparseMatrix Lambda = compute_Lambda_from_Lambda_blocks(Lambda_blocks);
-    Vector Sx = data_matrix_product(x) - Lambda * x;
-    theta = x.dot(Sx);
+    Matrix SV = data_matrix_product(V) - Lambda * V;
+    thetas = (V.transpose() * SV).diagonal();
+
+    // Retain the leading direction, and any others that still have negative
+    // curvature with respect to the simplified certificate matrix
+    std::vector<size_t> retained = {0};
+    for (size_t k = 1; k < V.cols(); ++k)
+      if (thetas(k) < 0)
+        retained.push_back(k);
+
+    X.resize(V.rows(), retained.size());
+    Vector retained_thetas(retained.size());
+    for (size_t k = 0; k < retained.size(); ++k) {
+      X.col(k) = V.col(retained[k]);
+      retained_thetas(k) = thetas(retained[k]);
+    }
+    thetas = retained_thetas;
   }
 
   return PSD;
 }
 
 Matrix SESyncProblem::chordal_initialization() const {
+  // Compute rotations using chordal initialization, and lift these to the
+  // domain of the rank-restricted relaxation
+  return lift_rotations(SESync::chordal_initialization(d_, B3_));
+}
+
+Matrix SESyncProblem::spectral_initialization(
+    size_t max_iters, Scalar tol,
+    const std::function<bool()> &interrupt) const {
+  // The rotational connection Laplacian is only cached when solving the
+  // Simplified or SOSync formulations; otherwise, construct it here
+  if (form_ == Formulation::Explicit)
+    return lift_rotations(SESync::spectral_initialization(
+        d_, construct_rotational_connection_Laplacian(measurements_), max_iters,
+        tol, interrupt));
+  else
+    return lift_rotations(SESync::spectral_initialization(d_, LGrho_, max_iters,
+                                                          tol, interrupt));
+}
+
+Matrix SESyncProblem::lift_rotations(const Matrix &R) const {
   Matrix Y;
   if ((form_ == Formulation::Simplified) || (form_ == Formulation::SOSync)) {
     Y = Matrix::Zero(r_, n_ * d_);
-    Y.topRows(d_) = SESync::chordal_initialization(d_, B3_);
+    Y.topRows(d_) = R;
   } else // form == explicit
   {
     Y = Matrix::Zero(r_, n_ * (d_ + 1));
 
-    // Compute rotations using chordal initialization
-    Y.block(0, n_, d_, n_ * d_) = SESync::chordal_initialization(d_, B3_);
+    // Set rotational states
+    Y.block(0, n_, d_, n_ * d_) = R;
 
     // Recover corresponding translations
-    Y.block(0, 0, d_, n_) =
-        recover_translations(B1_, B2_, Y.block(0, n_, d_, n_ * d_));
+    Y.block(0, 0, d_, n_) = recover_translations(B1_, B2_, R);
   }
 
   return Y;
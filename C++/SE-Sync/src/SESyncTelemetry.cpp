@@ -0,0 +1,107 @@
+#include <cmath>
+#include <sstream>
+
+#include "SESync/SESyncTelemetry.h"
+
+namespace SESync {
+
+namespace {
+
+/** Writes a JSON number (or null, if x is not finite) */
+void write_number(std::ostream &os, double x) {
+  if (std::isfinite(x))
+    os << x;
+  else
+    os << "null";
+}
+
+void write_counts(std::ostream &os, const SESyncOperationCounts &counts) {
+  os << "{\"data_matrix_products\":" << counts.data_matrix_products
+     << ",\"linear_solves\":" << counts.linear_solves
+     << ",\"LOBPCG_operator_applications\":"
+     << counts.LOBPCG_operator_applications << "}";
+}
+
+/** Writes a kernel profile (if kernel counters are enabled) as a member of an
+ * enclosing JSON object */
+void write_kernels(std::ostream &os, const KernelProfile &kernels) {
+  if (!kernel_counters_enabled())
+    return;
+
+  os << ",\"kernels\":{";
+  for (size_t k = 0; k < NumKernels; ++k) {
+    const KernelStats &stats = kernels[k];
+    if (k > 0)
+      os << ",";
+    os << "\"" << kernel_name(static_cast<Kernel>(k))
+       << "\":{\"calls\":" << stats.calls << ",\"flops\":";
+    write_number(os, stats.flops);
+    os << ",\"bytes\":";
+    write_number(os, stats.bytes);
+    os << ",\"time\":";
+    write_number(os, stats.time);
+    os << ",\"GFLOPS\":";
+    write_number(os, stats.GFLOPS());
+    os << ",\"GBS\":";
+    write_number(os, stats.GBS());
+    os << "}";
+  }
+  os << "}";
+}
+
+} // namespace
+
+std::string to_json(const SESyncTelemetry &telemetry) {
+  std::ostringstream os;
+  os.precision(9);
+
+  os << "{\"problem_construction\":{\"time\":";
+  write_number(os, telemetry.problem_construction_time);
+  os << ",\"projection_factorization_time\":";
+  write_number(os, telemetry.projection_factorization_time);
+  os << ",\"preconditioner_norm_estimate_time\":";
+  write_number(os, telemetry.preconditioner_norm_estimate_time);
+  os << ",\"preconditioner_factorization_time\":";
+  write_number(os, telemetry.preconditioner_factorization_time);
+
+  os << "},\"initialization_time\":";
+  write_number(os, telemetry.initialization_time);
+
+  os << ",\"staircase\":{\"time\":";
+  write_number(os, telemetry.staircase_time);
+  os << ",\"levels\":[";
+  for (size_t k = 0; k < telemetry.levels.size(); ++k) {
+    const SESyncLevelTelemetry &level = telemetry.levels[k];
+    if (k > 0)
+      os << ",";
+    os << "{\"relaxation_rank\":" << level.relaxation_rank
+       << ",\"optimization_time\":";
+    write_number(os, level.optimization_time);
+    os << ",\"verification_time\":";
+    write_number(os, level.verification_time);
+    os << ",\"escape_time\":";
+    write_number(os, level.escape_time);
+    os << ",\"counts\":";
+    write_counts(os, level.counts);
+    write_kernels(os, level.kernels);
+    os << "}";
+  }
+
+  os << "]},\"post_processing\":{\"time\":";
+  write_number(os, telemetry.post_processing_time);
+  os << ",\"rounding_time\":";
+  write_number(os, telemetry.rounding_time);
+  os << ",\"Lambda_time\":";
+  write_number(os, telemetry.Lambda_time);
+
+  os << "},\"total_time\":";
+  write_number(os, telemetry.total_time);
+  os << ",\"counts\":";
+  write_counts(os, telemetry.counts);
+  write_kernels(os, telemetry.kernels);
+  os << "}";
+
+  return os.str();
+}
+
+} // namespace SESync
@@ -1,7 +1,10 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 
 #include <Eigen/CholmodSupport>
 #include <Eigen/Geometry>
@@ -10,6 +13,7 @@
 #include "ILDL/ILDL.h"
 #include "Optimization/LinearAlgebra/LOBPCG.h"
 
+#include "SESync/KernelCounters.h"
 #include "SESync/SESync_utils.h"
 
 namespace SESync {
@@ -564,6 +568,159 @@ SparseMatrix construct_M_matrix(const measurements_t &measurements) {
   return M;
 }
 
+ComplexSparseMatrix construct_complex_rotational_connection_Laplacian(
+    const measurements_t &measurements) {
+
+  size_t num_poses = 0;
+
+  std::vector<Eigen::Triplet<ComplexScalar>> triplets;
+  triplets.reserve(4 * measurements.size());
+
+  size_t i, j, max_pair;
+  for (const SESync::RelativePoseMeasurement &measurement : measurements) {
+    i = measurement.i;
+    j = measurement.j;
+
+    // Since |z|^2 = ||[Re(z) -Im(z); Im(z) Re(z)]||_F^2 / 2, we double the
+    // rotational weights in order to match the real formulation's objective
+    Scalar w = 2 * measurement.kappa;
+    ComplexScalar Rij = complex_rotation(measurement.R);
+
+    triplets.emplace_back(i, i, w);
+    triplets.emplace_back(j, j, w);
+    triplets.emplace_back(i, j, -w * Rij);
+    triplets.emplace_back(j, i, -w * std::conj(Rij));
+
+    max_pair = std::max<size_t>(i, j);
+    if (max_pair > num_poses)
+      num_poses = max_pair;
+  }
+
+  num_poses++; // Account for 0-based indexing
+
+  ComplexSparseMatrix LGrho(num_poses, num_poses);
+  LGrho.setFromTriplets(triplets.begin(), triplets.end());
+
+  return LGrho;
+}
+
+ComplexSparseMatrix construct_complex_translational_data_matrix(
+    const measurements_t &measurements) {
+
+  size_t num_poses = 0;
+
+  std::vector<Eigen::Triplet<ComplexScalar>> triplets;
+  triplets.reserve(measurements.size());
+
+  size_t max_pair;
+  for (size_t m = 0; m < measurements.size(); m++) {
+    triplets.emplace_back(
+        m, measurements[m].i,
+        -ComplexScalar(measurements[m].t(0), measurements[m].t(1)));
+
+    max_pair = std::max<size_t>(measurements[m].i, measurements[m].j);
+    if (max_pair > num_poses)
+      num_poses = max_pair;
+  }
+  num_poses++; // Account for zero-based indexing
+
+  ComplexSparseMatrix T(measurements.size(), num_poses);
+  T.setFromTriplets(triplets.begin(), triplets.end());
+
+  return T;
+}
+
+ComplexSparseMatrix
+construct_complex_M_matrix(const measurements_t &measurements) {
+
+  size_t num_poses = 0;
+  for (const SESync::RelativePoseMeasurement &measurement : measurements)
+    num_poses = std::max<size_t>(
+        num_poses, std::max<size_t>(measurement.i, measurement.j));
+  num_poses++; // Account for zero-based indexing
+
+  std::vector<Eigen::Triplet<ComplexScalar>> triplets;
+  triplets.reserve(13 * measurements.size());
+
+  // Each measurement contributes the terms
+  //
+  // tau * |t_j - t_i - t_ij R_i|^2 + 2 * kappa * |R_j - R_i R_ij|^2
+  //
+  // to the objective x M x^H; writing each of these as |sum_a c_a x_a|^2, the
+  // corresponding contribution to M is given by M_ab += c_a * conj(c_b)
+  size_t i, j;
+  for (const SESync::RelativePoseMeasurement &measurement : measurements) {
+    i = measurement.i;
+    j = measurement.j;
+
+    Scalar tau = measurement.tau;
+    Scalar w = 2 * measurement.kappa;
+    ComplexScalar tij(measurement.t(0), measurement.t(1));
+    ComplexScalar Rij = complex_rotation(measurement.R);
+
+    // Translational weight graph Laplacian L(W^tau)
+    triplets.emplace_back(i, i, tau);
+    triplets.emplace_back(j, j, tau);
+    triplets.emplace_back(i, j, -tau);
+    triplets.emplace_back(j, i, -tau);
+
+    // Off-diagonal (translation-rotation) blocks
+    triplets.emplace_back(j, num_poses + i, -tau * std::conj(tij));
+    triplets.emplace_back(num_poses + i, j, -tau * tij);
+    triplets.emplace_back(i, num_poses + i, tau * std::conj(tij));
+    triplets.emplace_back(num_poses + i, i, tau * tij);
+
+    // Rotational connection Laplacian plus translational term Sigma
+    triplets.emplace_back(num_poses + i, num_poses + i,
+                          w + tau * std::norm(tij));
+    triplets.emplace_back(num_poses + j, num_poses + j, w);
+    triplets.emplace_back(num_poses + i, num_poses + j, -w * Rij);
+    triplets.emplace_back(num_poses + j, num_poses + i, -w * std::conj(Rij));
+  }
+
+  ComplexSparseMatrix M(2 * num_poses, 2 * num_poses);
+  M.setFromTriplets(triplets.begin(), triplets.end());
+
+  return M;
+}
+
+Matrix real_representation(const ComplexMatrix &Y) {
+  Matrix X(2 * Y.rows(), 2 * Y.cols());
+
+#pragma omp parallel for
+  for (size_t c = 0; c < Y.cols(); ++c)
+    for (size_t r = 0; r < Y.rows(); ++r)
+      X.block(2 * r, 2 * c, 2, 2) = real_rotation(Y(r, c));
+
+  return X;
+}
+
+SparseMatrix real_symmetric_embedding(const ComplexSparseMatrix &H) {
+  size_t N = H.rows();
+
+  std::vector<Eigen::Triplet<Scalar>> triplets;
+  triplets.reserve(4 * H.nonZeros());
+
+  for (size_t k = 0; k < H.outerSize(); ++k)
+    for (ComplexSparseMatrix::InnerIterator it(H, k); it; ++it) {
+      size_t r = it.row();
+      size_t c = it.col();
+      Scalar a = it.value().real();
+      Scalar b = it.value().imag();
+
+      triplets.emplace_back(r, c, a);
+      triplets.emplace_back(N + r, N + c, a);
+      if (b != 0) {
+        triplets.emplace_back(r, N + c, -b);
+        triplets.emplace_back(N + r, c, b);
+      }
+    }
+
+  SparseMatrix S(2 * N, 2 * N);
+  S.setFromTriplets(triplets.begin(), triplets.end());
+  return S;
+}
+
 Matrix chordal_initialization(size_t d, const SparseMatrix &B3) {
   size_t d2 = d * d;
   size_t num_poses = B3.cols() / d2;
@@ -604,6 +761,93 @@ Matrix chordal_initialization(size_t d, const SparseMatrix &B3) {
   return Rchordal;
 }
 
+Matrix spectral_initialization(size_t d, const SparseMatrix &LGrho,
+                               size_t max_iters, Scalar tol,
+                               const std::function<bool()> &interrupt) {
+  size_t num_poses = LGrho.rows() / d;
+
+  /// We want to find the d eigenvectors of LGrho corresponding to its d
+  /// algebraically-smallest eigenvalues; in the noiseless case, the columns of
+  /// R' span exactly this eigenspace
+
+  // Matrix-vector multiplication with the rotational connection Laplacian
+  Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix> LGrho_op =
+      [&LGrho](const Matrix &X) -> Matrix { return LGrho * X; };
+
+  // Jacobi (diagonal scaling) preconditioner; note that the diagonal of LGrho
+  // is strictly positive for any pose that appears in at least one measurement
+  Vector Jacobi_precon = LGrho.diagonal();
+  for (size_t k = 0; k < Jacobi_precon.size(); ++k)
+    Jacobi_precon(k) = (Jacobi_precon(k) > 0 ? 1 / Jacobi_precon(k) : 1);
+
+  Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix> T =
+      [&Jacobi_precon](const Matrix &X) -> Matrix {
+    return Jacobi_precon.asDiagonal() * X;
+  };
+
+  // Stop early if interrupted (the current Ritz vectors still provide a
+  // usable, if less accurate, initialization)
+  std::optional<Optimization::LinearAlgebra::LOBPCGUserFunction<Vector, Matrix>>
+      stopfun;
+  if (interrupt)
+    stopfun =
+        [&interrupt](
+            size_t i,
+            const Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>
+                &A,
+            const std::optional<
+                Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>
+                &B,
+            const std::optional<
+                Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>
+                &T,
+            size_t nev, const Vector &Theta, const Matrix &X, const Vector &r,
+            size_t nc) { return interrupt(); };
+
+  Vector Theta;
+  Matrix X;
+  size_t num_iters;
+  size_t num_converged;
+  std::tie(Theta, X) = Optimization::LinearAlgebra::LOBPCG<Vector, Matrix>(
+      LGrho_op,
+      std::optional<
+          Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(),
+      std::optional<
+          Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(T),
+      LGrho.rows(), 2 * d, d, max_iters, num_iters, num_converged, tol,
+      stopfun);
+
+  // Each d x d block of X' is (up to a common scaling and gauge symmetry) an
+  // estimate of the corresponding rotation
+  Matrix Rspectral = X.leftCols(d).transpose();
+
+  // Count the number of blocks whose determinants have positive sign
+  size_t ng0 = 0;
+  for (size_t i = 0; i < num_poses; ++i)
+    if (Rspectral.block(0, i * d, d, d).determinant() > 0)
+      ++ng0;
+
+  if (ng0 < num_poses / 2) {
+    // Less than half of the total number of blocks have the correct sign, so
+    // reverse their orientations
+    Matrix reflector = Matrix::Identity(d, d);
+    reflector(d - 1, d - 1) = -1;
+
+    Rspectral = reflector * Rspectral;
+  }
+
+  // Project each d x d block to SO(d)
+#pragma omp parallel for
+  for (size_t i = 0; i < num_poses; ++i)
+    Rspectral.block(0, i * d, d, d) =
+        project_to_SOd(Rspectral.block(0, i * d, d, d));
+
+  // Fix the gauge so that the first rotation is the identity (as in the chordal
+  // initialization)
+  Matrix G = Rspectral.leftCols(d).transpose();
+  return G * Rspectral;
+}
+
 Matrix recover_translations(const SparseMatrix &B1, const SparseMatrix &B2,
                             const Matrix &R) {
   size_t d = R.rows();
@@ -661,6 +905,492 @@ Matrix project_to_SOd(const Matrix &M) {
   }
 }
 
+Matrix round_solution(const Matrix &Y, size_t d, size_t rot_offset) {
+  size_t n = (Y.cols() - rot_offset) / d;
+
+  // First, compute a thin SVD of Y
+  Eigen::JacobiSVD<Matrix> svd(Y, Eigen::ComputeThinV);
+
+  Vector sigmas = svd.singularValues();
+  // Construct a diagonal matrix comprised of the first d singular values
+  DiagonalMatrix Sigma_d(d);
+  DiagonalMatrix::DiagonalVectorType &diagonal = Sigma_d.diagonal();
+  for (size_t i = 0; i < d; ++i)
+    diagonal(i) = sigmas(i);
+
+  // First, construct a rank-d truncated singular value decomposition for Y
+  Matrix R = Sigma_d * svd.matrixV().leftCols(d).transpose();
+
+  Vector determinants(n);
+
+  size_t ng0 = 0; // This will count the number of blocks whose
+  // determinants have positive sign
+  for (size_t i = 0; i < n; ++i) {
+    // Compute the determinant of the ith dxd block of R
+    determinants(i) = R.block(0, rot_offset + i * d, d, d).determinant();
+    if (determinants(i) > 0)
+      ++ng0;
+  }
+
+  if (ng0 < n / 2) {
+    // Less than half of the total number of blocks have the correct sign, so
+    // reverse their orientations
+
+    // Get a reflection matrix that we can use to reverse the signs of those
+    // blocks of R that have the wrong determinant
+    Matrix reflector = Matrix::Identity(d, d);
+    reflector(d - 1, d - 1) = -1;
+
+    R = reflector * R;
+  }
+
+// Finally, project each dxd rotation block to SO(d)
+#pragma omp parallel for
+  for (size_t i = 0; i < n; ++i)
+    R.block(0, rot_offset + i * d, d, d) =
+        project_to_SOd(R.block(0, rot_offset + i * d, d, d));
+
+  return R;
+}
+
+size_t truncate_to_numerical_rank(Matrix &Y, Scalar tol, size_t min_rank) {
+  size_t r = Y.rows();
+  if (r <= min_rank)
+    return r;
+
+  // The eigenvalues of the Gram matrix Y * Y' are the squared singular values
+  // of Y, in increasing order
+  Eigen::SelfAdjointEigenSolver<Matrix> eig(Y * Y.transpose());
+  const Vector &lambdas = eig.eigenvalues();
+  Scalar threshold = tol * tol * lambdas(r - 1);
+
+  size_t k = 0;
+  while (k < r && lambdas(r - 1 - k) > threshold)
+    ++k;
+  k = std::max(k, min_rank);
+
+  if (k < r)
+    Y = eig.eigenvectors().rightCols(k).transpose() * Y;
+
+  return k;
+}
+
+Scalar evaluate_objective(const measurements_t &measurements, const Matrix &X) {
+  return measurement_residuals(measurements, X).sum();
+}
+
+Vector measurement_residuals(const measurements_t &measurements,
+                             const Matrix &X) {
+  size_t d = X.rows();
+
+  // Determine whether X contains translational states
+  size_t n = 0;
+  for (const RelativePoseMeasurement &measurement : measurements)
+    n = std::max<size_t>(n, std::max<size_t>(measurement.i, measurement.j));
+  n++; // Account for zero-based indexing
+
+  bool has_translations = (X.cols() == (d + 1) * n);
+  size_t rot_offset = (has_translations ? n : 0);
+
+  Vector residuals(measurements.size());
+  for (size_t k = 0; k < measurements.size(); ++k) {
+    const RelativePoseMeasurement &measurement = measurements[k];
+    const auto Ri = X.block(0, rot_offset + d * measurement.i, d, d);
+    const auto Rj = X.block(0, rot_offset + d * measurement.j, d, d);
+
+    residuals(k) = measurement.kappa * (Rj - Ri * measurement.R).squaredNorm();
+
+    if (has_translations)
+      residuals(k) +=
+          measurement.tau *
+          (X.col(measurement.j) - X.col(measurement.i) - Ri * measurement.t)
+              .squaredNorm();
+  }
+
+  return residuals;
+}
+
+bool detect_planar_structure(const measurements_t &measurements,
+                             Scalar rotation_tol, Scalar translation_tol,
+                             Matrix &Q) {
+  if (measurements.empty() || measurements[0].R.rows() != 3)
+    return false;
+
+  /// Estimate the common (body-frame) rotational axis a
+  Matrix C = Matrix::Zero(3, 3);
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    Matrix D = measurement.R - Matrix::Identity(3, 3);
+    C += D.transpose() * D;
+
+    Scalar tnorm2 = measurement.t.squaredNorm();
+    if (tnorm2 > 0)
+      C += measurement.t * measurement.t.transpose() / tnorm2;
+  }
+
+  Eigen::SelfAdjointEigenSolver<Matrix> eig(C);
+  Eigen::Vector3d a = eig.eigenvectors().col(0);
+
+  /// Test whether each measurement is consistent with planar motion about a
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    if ((measurement.R * a - a).norm() > rotation_tol)
+      return false;
+    if (std::fabs(measurement.t.dot(a)) > translation_tol)
+      return false;
+  }
+
+  // Construct a rotation mapping a to the z-axis
+  Q = Eigen::Quaterniond::FromTwoVectors(a, Eigen::Vector3d::UnitZ())
+          .toRotationMatrix();
+
+  return true;
+}
+
+measurements_t reduce_planar_measurements(const measurements_t &measurements,
+                                          const Matrix &Q) {
+  measurements_t planar_measurements;
+  planar_measurements.reserve(measurements.size());
+
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    // Express this measurement in the rotated frame, in which the common
+    // rotational axis is the z-axis
+    Matrix R = Q * measurement.R * Q.transpose();
+    Vector t = Q * measurement.t;
+
+    // Since R is (approximately) a rotation about the z-axis, its top-left
+    // 2 x 2 block is (approximately) the corresponding planar rotation
+    planar_measurements.emplace_back(
+        measurement.i, measurement.j, project_to_SOd(R.topLeftCorner(2, 2)),
+        t.head(2), measurement.kappa, measurement.tau);
+  }
+
+  return planar_measurements;
+}
+
+Matrix lift_planar_poses(const Matrix &X, size_t n, const Matrix &Q) {
+  bool has_translations = (X.cols() == 3 * n);
+  size_t rot_offset = (has_translations ? n : 0);
+
+  Matrix X3(3, rot_offset + 3 * n);
+
+  if (has_translations) {
+    Matrix t = Matrix::Zero(3, n);
+    t.topRows(2) = X.leftCols(n);
+    X3.leftCols(n) = Q.transpose() * t;
+  }
+
+  Matrix R = Matrix::Identity(3, 3);
+  for (size_t i = 0; i < n; ++i) {
+    R.topLeftCorner(2, 2) = X.block(0, rot_offset + 2 * i, 2, 2);
+    X3.block(0, rot_offset + 3 * i, 3, 3) = Q.transpose() * R * Q;
+  }
+
+  return X3;
+}
+
+measurements_t coarsen_measurements(const measurements_t &measurements,
+                                    std::vector<size_t> &clusters,
+                                    std::vector<Matrix> &offsets) {
+  clusters.clear();
+  offsets.clear();
+  if (measurements.empty())
+    return measurements_t();
+
+  size_t d = measurements[0].t.size();
+  size_t n = 0;
+  for (const RelativePoseMeasurement &measurement : measurements)
+    n = std::max(n, std::max(measurement.i, measurement.j) + 1);
+
+  /// Heavy-edge matching
+
+  // Visit the measurements in order of decreasing rotational precision, and
+  // match the endpoints of each measurement whose endpoints are both unmatched
+  std::vector<size_t> order(measurements.size());
+  for (size_t k = 0; k < order.size(); ++k)
+    order[k] = k;
+  std::stable_sort(order.begin(), order.end(),
+                   [&measurements](size_t a, size_t b) {
+                     return measurements[a].kappa > measurements[b].kappa;
+                   });
+
+  // mate[i] is the state with which state i is matched (or n, if state i is
+  // unmatched), and matching_edge[i] is the measurement along which it was
+  // matched
+  std::vector<size_t> mate(n, n);
+  std::vector<size_t> matching_edge(n);
+  for (size_t k : order) {
+    const RelativePoseMeasurement &measurement = measurements[k];
+    if (measurement.i == measurement.j || mate[measurement.i] != n ||
+        mate[measurement.j] != n)
+      continue;
+    mate[measurement.i] = measurement.j;
+    mate[measurement.j] = measurement.i;
+    matching_edge[measurement.i] = matching_edge[measurement.j] = k;
+  }
+
+  /// Contraction
+
+  // Each matched pair is represented by its lower-indexed state, whose frame
+  // becomes that of the coarse state; coarse states are numbered in order of
+  // their representatives
+  Matrix identity = Matrix::Zero(d, d + 1);
+  identity.rightCols(d).setIdentity();
+
+  clusters.resize(n);
+  offsets.resize(n);
+  size_t nc = 0;
+  for (size_t i = 0; i < n; ++i) {
+    size_t p = mate[i];
+    if (p == n || p > i) {
+      clusters[i] = nc++;
+      offsets[i] = identity;
+    } else {
+      // State i is expressed relative to its representative p, using the
+      // measurement along which the two were matched
+      const RelativePoseMeasurement &measurement =
+          measurements[matching_edge[i]];
+      clusters[i] = clusters[p];
+      offsets[i].resize(d, d + 1);
+      if (measurement.i == p) {
+        // x_i = x_p * x_pi
+        offsets[i].col(0) = measurement.t;
+        offsets[i].rightCols(d) = measurement.R;
+      } else {
+        // x_i = x_p * x_ip^-1
+        offsets[i].rightCols(d) = measurement.R.transpose();
+        offsets[i].col(0) = -measurement.R.transpose() * measurement.t;
+      }
+    }
+  }
+
+  /// Construct the coarse measurements
+
+  // Since x_j = x_i * x_ij, x_i = x_ci * o_i, and x_j = x_cj * o_j, the
+  // induced measurement of the coarse states is x_ci^-1 * x_cj =
+  // o_i * x_ij * o_j^-1.  Parallel measurements are accumulated (with
+  // precision-weighted averages of their rotations and translations), with
+  // each coarse measurement oriented from its lower- to its higher-indexed
+  // endpoint.
+  std::unordered_map<size_t, size_t> coarse_index;
+  measurements_t coarse_measurements;
+  std::vector<Matrix> weighted_rotations;
+  std::vector<Vector> weighted_translations;
+
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    size_t ci = clusters[measurement.i];
+    size_t cj = clusters[measurement.j];
+    if (ci == cj)
+      continue; // This measurement is internal to a contracted pair
+
+    const Matrix &oi = offsets[measurement.i];
+    const Matrix &oj = offsets[measurement.j];
+    Matrix R = oi.rightCols(d) * measurement.R * oj.rightCols(d).transpose();
+    Vector t = oi.col(0) + oi.rightCols(d) * measurement.t - R * oj.col(0);
+    if (ci > cj) {
+      std::swap(ci, cj);
+      t = -R.transpose() * t;
+      R.transposeInPlace();
+    }
+
+    auto it = coarse_index.emplace(ci * nc + cj, coarse_measurements.size());
+    if (it.second) {
+      coarse_measurements.emplace_back(ci, cj, R, t, 0, 0);
+      weighted_rotations.push_back(Matrix::Zero(d, d));
+      weighted_translations.push_back(Vector::Zero(d));
+    }
+
+    size_t k = it.first->second;
+    coarse_measurements[k].kappa += measurement.kappa;
+    coarse_measurements[k].tau += measurement.tau;
+    weighted_rotations[k] += measurement.kappa * R;
+    weighted_translations[k] += measurement.tau * t;
+  }
+
+  for (size_t k = 0; k < coarse_measurements.size(); ++k) {
+    RelativePoseMeasurement &measurement = coarse_measurements[k];
+    measurement.R = project_to_SOd(weighted_rotations[k]);
+    measurement.t = weighted_translations[k] / measurement.tau;
+  }
+
+  return coarse_measurements;
+}
+
+Matrix prolong_poses(const Matrix &X, const std::vector<size_t> &clusters,
+                     const std::vector<Matrix> &offsets) {
+  size_t d = X.rows();
+  size_t n = clusters.size();
+  size_t nc = (n > 0 ? *std::max_element(clusters.begin(), clusters.end()) + 1
+                     : 0);
+
+  bool has_translations = (X.cols() == (d + 1) * nc);
+  size_t coarse_rot_offset = (has_translations ? nc : 0);
+  size_t rot_offset = (has_translations ? n : 0);
+
+  Matrix Xf(d, rot_offset + d * n);
+  for (size_t i = 0; i < n; ++i) {
+    size_t c = clusters[i];
+    const Matrix &o = offsets[i];
+    auto Rc = X.block(0, coarse_rot_offset + d * c, d, d);
+
+    // x_i = x_c * o_i
+    Xf.block(0, rot_offset + d * i, d, d) = Rc * o.rightCols(d);
+    if (has_translations)
+      Xf.col(i) = X.col(c) + Rc * o.col(0);
+  }
+
+  return Xf;
+}
+
+size_t connected_components(const measurements_t &measurements,
+                            std::vector<size_t> &component) {
+  size_t n = 0;
+  for (const RelativePoseMeasurement &measurement : measurements)
+    n = std::max(n, std::max(measurement.i, measurement.j) + 1);
+
+  // Union-find with path halving
+  std::vector<size_t> parent(n);
+  for (size_t i = 0; i < n; ++i)
+    parent[i] = i;
+  auto find = [&parent](size_t i) {
+    while (parent[i] != i)
+      i = parent[i] = parent[parent[i]];
+    return i;
+  };
+
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    size_t a = find(measurement.i);
+    size_t b = find(measurement.j);
+    // Always attach the root with the larger index, so that each root is the
+    // lowest-indexed state of its component
+    if (a < b)
+      parent[b] = a;
+    else if (b < a)
+      parent[a] = b;
+  }
+
+  component.assign(n, 0);
+  size_t num_components = 0;
+  for (size_t i = 0; i < n; ++i) {
+    size_t root = find(i);
+    component[i] = (root == i ? num_components++ : component[root]);
+  }
+
+  return num_components;
+}
+
+size_t two_edge_connected_components(const measurements_t &measurements,
+                                     std::vector<size_t> &component) {
+  size_t n = 0;
+  for (const RelativePoseMeasurement &measurement : measurements)
+    n = std::max(n, std::max(measurement.i, measurement.j) + 1);
+
+  // Adjacency lists of (neighbor, measurement index) pairs
+  std::vector<std::vector<std::pair<size_t, size_t>>> adjacency(n);
+  for (size_t e = 0; e < measurements.size(); ++e) {
+    const RelativePoseMeasurement &measurement = measurements[e];
+    if (measurement.i == measurement.j)
+      continue;
+    adjacency[measurement.i].emplace_back(measurement.j, e);
+    adjacency[measurement.j].emplace_back(measurement.i, e);
+  }
+
+  // Find the bridges using Tarjan's algorithm: the tree edge (v, w) of a
+  // depth-first search is a bridge iff no back edge from the subtree rooted
+  // at w reaches v or any of its ancestors.  The search is iterative, since
+  // long odometry chains would otherwise overflow the stack.
+  const size_t unvisited = std::numeric_limits<size_t>::max();
+  std::vector<size_t> discovery(n, unvisited), low(n);
+  std::vector<bool> is_bridge(measurements.size(), false);
+
+  struct Frame {
+    size_t v;           // State
+    size_t parent_edge; // Measurement by which v was reached
+    size_t next;        // Position in v's adjacency list
+  };
+  std::vector<Frame> stack;
+  size_t time = 0;
+
+  for (size_t root = 0; root < n; ++root) {
+    if (discovery[root] != unvisited)
+      continue;
+    discovery[root] = low[root] = time++;
+    stack.push_back({root, unvisited, 0});
+
+    while (!stack.empty()) {
+      Frame &frame = stack.back();
+      size_t v = frame.v;
+      if (frame.next < adjacency[v].size()) {
+        size_t w, e;
+        std::tie(w, e) = adjacency[v][frame.next++];
+        if (e == frame.parent_edge)
+          continue;
+        if (discovery[w] == unvisited) {
+          discovery[w] = low[w] = time++;
+          stack.push_back({w, e, 0});
+        } else
+          low[v] = std::min(low[v], discovery[w]);
+      } else {
+        size_t e = frame.parent_edge;
+        stack.pop_back();
+        if (!stack.empty()) {
+          size_t parent = stack.back().v;
+          low[parent] = std::min(low[parent], low[v]);
+          if (low[v] > discovery[parent])
+            is_bridge[e] = true;
+        }
+      }
+    }
+  }
+
+  // Label the connected components of the graph without its bridges
+  component.assign(n, unvisited);
+  size_t num_components = 0;
+  std::vector<size_t> frontier;
+  for (size_t root = 0; root < n; ++root) {
+    if (component[root] != unvisited)
+      continue;
+    component[root] = num_components;
+    frontier.push_back(root);
+    while (!frontier.empty()) {
+      size_t v = frontier.back();
+      frontier.pop_back();
+      for (const std::pair<size_t, size_t> &neighbor : adjacency[v])
+        if (!is_bridge[neighbor.second] &&
+            component[neighbor.first] == unvisited) {
+          component[neighbor.first] = num_components;
+          frontier.push_back(neighbor.first);
+        }
+    }
+    ++num_components;
+  }
+
+  return num_components;
+}
+
+std::vector<measurements_t>
+split_measurements(const measurements_t &measurements,
+                   const std::vector<size_t> &component, size_t num_components,
+                   std::vector<std::vector<size_t>> &states) {
+  states.assign(num_components, std::vector<size_t>());
+  std::vector<size_t> local_index(component.size());
+  for (size_t i = 0; i < component.size(); ++i) {
+    local_index[i] = states[component[i]].size();
+    states[component[i]].push_back(i);
+  }
+
+  std::vector<measurements_t> subgraphs(num_components);
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    size_t c = component[measurement.i];
+    if (component[measurement.j] != c)
+      continue;
+    RelativePoseMeasurement local_measurement = measurement;
+    local_measurement.i = local_index[measurement.i];
+    local_measurement.j = local_index[measurement.j];
+    subgraphs[c].push_back(local_measurement);
+  }
+
+  return subgraphs;
+}
+
 Scalar dS(const Matrix &X, const Matrix &Y, Matrix *G_S) {
   size_t d = X.rows();
   size_t n = X.cols() / d;
@@ -715,10 +1445,34 @@ Scalar dO(const Matrix &X, const Matrix &Y, Matrix *G_O) {
 bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
                        Scalar &theta, Vector &x, size_t &num_iters,
                        size_t max_iters, Scalar max_fill_factor,
-                       Scalar drop_tol) {
+                       Scalar drop_tol,
+                       const std::function<bool()> &interrupt) {
+  Vector thetas;
+  Matrix X;
+  bool PSD = fast_verification(S, eta, nx, 1, thetas, X, num_iters, max_iters,
+                               max_fill_factor, drop_tol, nullptr, interrupt);
+
+  theta = (PSD ? 0 : thetas(0));
+  if (!PSD)
+    x = X.col(0);
+
+  return PSD;
+}
+
+bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
+                       size_t num_directions, Vector &thetas, Matrix &X,
+                       size_t &num_iters, size_t max_iters,
+                       Scalar max_fill_factor, Scalar drop_tol,
+                       size_t *num_operator_applications,
+                       const std::function<bool()> &interrupt) {
   // Don't forget to set this on input!
   num_iters = 0;
-  theta = 0;
+  thetas = Vector::Zero(1);
+  if (num_operator_applications)
+    *num_operator_applications = 0;
+
+  // We cannot extract more Ritz vectors than the LOBPCG block size
+  size_t nev = std::max<size_t>(1, std::min(num_directions, nx));
 
   unsigned int n = S.rows();
 
@@ -753,7 +1507,6 @@ bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
     /// an approximate minimum eigenpair using LOBPCG
 
     Vector Theta; // Vector to hold Ritz values of S
-    Matrix X;     // Matrix to hold eigenvector estimates for S
     size_t num_converged;
 
     /// Set up matrix-vector multiplication operator with regularized
@@ -761,26 +1514,37 @@ bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
 
     // Matrix-vector multiplication with regularized certificate matrix M
     Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix> Mop =
-        [&M](const Matrix &X) -> Matrix { return M * X; };
+        [&M, num_operator_applications](const Matrix &X) -> Matrix {
+      if (num_operator_applications)
+        ++(*num_operator_applications);
+      SESYNC_KERNEL_SCOPE(Kernel::LOBPCGOperator,
+                          2.0 * M.nonZeros() * X.cols(),
+                          12.0 * M.nonZeros() + 16.0 * X.size());
+      return M * X;
+    };
 
     // Custom stopping criterion: terminate as soon as a direction of
     // sufficiently negative curvature is found:
     //
     // x'* S * x < - eta / 2
     //
+    // or as soon as we are interrupted
     Optimization::LinearAlgebra::LOBPCGUserFunction<Vector, Matrix> stopfun =
-        [&S,
-         eta](size_t i,
-              const Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>
-                  &M,
-              const std::optional<
-                  Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>
-                  &B,
-              const std::optional<
-                  Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>
-                  &T,
-              size_t nev, const Vector &Theta, const Matrix &X, const Vector &r,
-              size_t nc) {
+        [&S, eta, &interrupt](
+            size_t i,
+            const Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>
+                &M,
+            const std::optional<
+                Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>
+                &B,
+            const std::optional<
+                Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>
+                &T,
+            size_t nev, const Vector &Theta, const Matrix &X, const Vector &r,
+            size_t nc) {
+          if (interrupt && interrupt())
+            return true;
+
           // Calculate curvature along estimated minimum eigenvector X0
           Scalar theta = X.col(0).dot(S * X.col(0));
           return (theta < -eta / 2);
@@ -805,19 +1569,16 @@ bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
             Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(),
         std::optional<
             Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(),
-        n, nx, 1, static_cast<size_t>(unprecon_iter_frac * max_iters),
+        n, nx, nev, static_cast<size_t>(unprecon_iter_frac * max_iters),
         num_iters, num_converged, 0.0,
         std::optional<
             Optimization::LinearAlgebra::LOBPCGUserFunction<Vector, Matrix>>(
             stopfun));
 
-    // Extract eigenvector estimate
-    x = X.col(0);
-
-    // Calculate curvature along x
-    theta = x.dot(S * x);
+    // Calculate curvature along the estimated minimum eigenvector
+    Scalar theta = X.col(0).dot(S * X.col(0));
 
-    if (!(theta < -eta / 2)) {
+    if (!(theta < -eta / 2) && !(interrupt && interrupt())) {
 
       /// STEP 3:  RUN PRECONDITIONED LOBPCG
 
@@ -859,21 +1620,35 @@ bool fast_verification(const SparseMatrix &S, Scalar eta, size_t nx,
               Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(),
           std::optional<
               Optimization::LinearAlgebra::SymmetricLinearOperator<Matrix>>(T),
-          n, nx, 1, static_cast<size_t>((1.0 - unprecon_iter_frac) * max_iters),
+          n, nx, nev,
+          static_cast<size_t>((1.0 - unprecon_iter_frac) * max_iters),
           num_iters, num_converged, 0.0,
           std::optional<
               Optimization::LinearAlgebra::LOBPCGUserFunction<Vector, Matrix>>(
               stopfun));
 
-      // Extract eigenvector estimate
-      x = X.col(0);
-
-      // Calculate curvature along x
-      theta = x.dot(S * x);
-
       num_iters += static_cast<size_t>(unprecon_iter_frac * num_iters);
     } // if (!(theta < -eta / 2))
 
+    /// Retain the estimated minimum eigenvector, together with any additional
+    /// Ritz vectors along which S has sufficiently negative curvature.  Since
+    /// the Ritz vectors are orthonormal and S-orthogonal, the curvature of S
+    /// along the subspace they span is simply the sum of their curvatures.
+    Matrix SX = S * X.leftCols(nev);
+    Vector curvatures = (X.leftCols(nev).transpose() * SX).diagonal();
+
+    std::vector<size_t> retained = {0};
+    for (size_t k = 1; k < nev; ++k)
+      if (curvatures(k) < -eta / 2)
+        retained.push_back(k);
+
+    Matrix Xneg(n, retained.size());
+    thetas.resize(retained.size());
+    for (size_t k = 0; k < retained.size(); ++k) {
+      Xneg.col(k) = X.col(retained[k]);
+      thetas(k) = curvatures(retained[k]);
+    }
+    X = Xneg;
   } // if(!PSD)
 
   return PSD;
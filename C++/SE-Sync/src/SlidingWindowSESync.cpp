@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/SESync_utils.h"
+#include "SESync/SlidingWindowSESync.h"
+
+namespace SESync {
+
+namespace {
+
+/** Returns the composition x * [t | R] of the pose x = [t_x | R_x] with the
+ * relative transform (R, t) */
+Matrix compose(const Matrix &x, const Matrix &R, const Vector &t) {
+  size_t d = R.rows();
+  Matrix y(d, d + 1);
+  y.rightCols(d) = x.rightCols(d) * R;
+  y.col(0) = x.col(0) + x.rightCols(d) * t;
+  return y;
+}
+
+/** Given a measurement between a fixed state (whose estimate is x_fixed) and a
+ * state in the window, this function returns the corresponding measurement of
+ * the state in the window relative to the world frame.  'fixed_is_first'
+ * indicates whether the fixed state is the first state (i) of the measurement.
+ */
+RelativePoseMeasurement
+anchor_measurement(const RelativePoseMeasurement &measurement,
+                   const Matrix &x_fixed, bool fixed_is_first) {
+  size_t d = measurement.R.rows();
+  RelativePoseMeasurement anchored = measurement;
+  Matrix x;
+  if (fixed_is_first) {
+    // x_j = x_i * x_ij
+    x = compose(x_fixed, measurement.R, measurement.t);
+  } else {
+    // x_i = x_j * x_ij^-1
+    anchored.i = measurement.j;
+    anchored.j = measurement.i;
+    Matrix Rt = measurement.R.transpose();
+    x = compose(x_fixed, Rt, -Rt * measurement.t);
+  }
+  anchored.R = x.rightCols(d);
+  anchored.t = x.col(0);
+  return anchored;
+}
+
+} // namespace
+
+SlidingWindowSESync::SlidingWindowSESync(size_t window_size,
+                                         const SESyncOpts &options,
+                                         size_t refactorization_period)
+    : options_(options), window_size_(window_size),
+      refactorization_period_(
+          refactorization_period > 0 ? refactorization_period : window_size) {
+  if (window_size_ < 2)
+    throw std::invalid_argument("Window size must be at least 2");
+}
+
+const SESyncResult &
+SlidingWindowSESync::update(const measurements_t &measurements) {
+  auto problem_update_start_time = Stopwatch::tick();
+
+  if (d_ == 0) {
+    if (measurements.empty())
+      throw std::invalid_argument(
+          "The first update must contain at least one measurement");
+    d_ = measurements[0].R.rows();
+  }
+
+  /// EXTEND THE SET OF STATES
+
+  size_t n_old = poses_.size();
+  size_t n_new = n_old;
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    if (measurement.R.rows() != d_)
+      throw std::invalid_argument(
+          "All measurements must have the same dimension");
+    n_new = std::max(n_new, std::max(measurement.i, measurement.j) + 1);
+  }
+  poses_.resize(n_new);
+
+  // The world frame coincides with the first state
+  if (n_old == 0) {
+    poses_[0] = Matrix::Zero(d_, d_ + 1);
+    poses_[0].rightCols(d_).setIdentity();
+  }
+
+  // Initialize the estimates of the new states by propagating the estimates
+  // of the existing ones along the new measurements
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (const RelativePoseMeasurement &measurement : measurements) {
+      bool known_i = poses_[measurement.i].size() != 0;
+      bool known_j = poses_[measurement.j].size() != 0;
+      if (known_i && !known_j)
+        poses_[measurement.j] =
+            compose(poses_[measurement.i], measurement.R, measurement.t);
+      else if (known_j && !known_i) {
+        Matrix Rt = measurement.R.transpose();
+        poses_[measurement.i] =
+            compose(poses_[measurement.j], Rt, -Rt * measurement.t);
+      } else
+        continue;
+      progress = true;
+    }
+  }
+
+  for (size_t k = n_old; k < n_new; ++k)
+    if (poses_[k].size() == 0) {
+      poses_.resize(n_old);
+      throw std::invalid_argument(
+          "Each new state must be connected to the existing pose graph");
+    }
+
+  /// CLASSIFY THE NEW MEASUREMENTS
+
+  for (const RelativePoseMeasurement &measurement : measurements) {
+    bool fixed_i = measurement.i < window_start_;
+    bool fixed_j = measurement.j < window_start_;
+    if (fixed_i && fixed_j)
+      continue; // This measurement no longer affects the window
+    else if (fixed_i)
+      anchor_measurements_.push_back(
+          anchor_measurement(measurement, poses_[measurement.i], true));
+    else if (fixed_j)
+      anchor_measurements_.push_back(
+          anchor_measurement(measurement, poses_[measurement.j], false));
+    else
+      window_measurements_.push_back(measurement);
+  }
+
+  /// ADVANCE THE WINDOW
+
+  while (n_new - window_start_ > window_size_) {
+    size_t k = window_start_++;
+
+    // Summarize the measurements incident to state k (whose estimate is now
+    // fixed) as anchor measurements.  We preserve the relative order of the
+    // remaining measurements, so that the factorizations of the windowed
+    // problem can be modified in place.
+    measurements_t remaining_measurements;
+    remaining_measurements.reserve(window_measurements_.size());
+    for (const RelativePoseMeasurement &measurement : window_measurements_) {
+      if (measurement.i != k && measurement.j != k)
+        remaining_measurements.push_back(measurement);
+      else if (std::max(measurement.i, measurement.j) >= window_start_)
+        anchor_measurements_.push_back(
+            anchor_measurement(measurement, poses_[k], measurement.i == k));
+    }
+    window_measurements_.swap(remaining_measurements);
+
+    anchor_measurements_.erase(
+        std::remove_if(anchor_measurements_.begin(),
+                       anchor_measurements_.end(),
+                       [k](const RelativePoseMeasurement &measurement) {
+                         return measurement.j == k;
+                       }),
+        anchor_measurements_.end());
+  }
+
+  /// CONSTRUCT THE WINDOWED PROBLEM
+
+  // The anchor (if present) occupies slot 0, and the state with global index g
+  // occupies slot offset + (g mod W)
+  size_t offset = (anchor_measurements_.empty() ? 0 : 1);
+  auto slot = [this, offset](size_t g) { return offset + g % window_size_; };
+  size_t N = offset + (n_new - window_start_);
+
+  measurements_t local_measurements;
+  local_measurements.reserve(anchor_measurements_.size() +
+                             window_measurements_.size());
+  for (RelativePoseMeasurement measurement : anchor_measurements_) {
+    measurement.i = 0;
+    measurement.j = slot(measurement.j);
+    local_measurements.push_back(measurement);
+  }
+  for (RelativePoseMeasurement measurement : window_measurements_) {
+    measurement.i = slot(measurement.i);
+    measurement.j = slot(measurement.j);
+    local_measurements.push_back(measurement);
+  }
+
+  if (!problem_ || problem_->num_states() != N ||
+      ++updates_since_factorization_ >= refactorization_period_) {
+    problem_.reset(new SESyncProblem(
+        local_measurements, options_.formulation,
+        options_.projection_factorization, options_.preconditioner,
+        options_.reg_Cholesky_precon_max_condition_number));
+    updates_since_factorization_ = 0;
+    factorizations_updated_ = false;
+  } else
+    factorizations_updated_ = problem_->set_measurements(local_measurements);
+
+  // Warm-start from the current estimates, at the rank of the previous
+  // solution
+  Matrix R(d_, d_ * N);
+  if (offset > 0)
+    R.leftCols(d_).setIdentity();
+  for (size_t g = window_start_; g < n_new; ++g)
+    R.middleCols(d_ * slot(g), d_) = poses_[g].rightCols(d_);
+
+  SESyncOpts options = options_;
+  if (result_.Yopt.size() != 0) {
+    options.r0 = result_.Yopt.rows();
+    options.rmax = std::max(options.rmax, options.r0);
+  }
+  problem_->set_relaxation_rank(options.r0);
+  Matrix Y0 = problem_->lift_rotations(R);
+
+  problem_update_time_ = Stopwatch::tock(problem_update_start_time);
+
+  /// SOLVE THE WINDOWED PROBLEM
+
+  auto solve_start_time = Stopwatch::tick();
+  result_ = SESync(*problem_, options, Y0);
+  solve_time_ = Stopwatch::tock(solve_start_time);
+
+  /// UPDATE THE ESTIMATES OF THE STATES IN THE WINDOW
+
+  // Extract the estimate of the state in slot s from xhat (which contains
+  // translations only for SE-synchronization problems)
+  const Matrix &xhat = result_.xhat;
+  bool has_translations = (xhat.cols() == (d_ + 1) * N);
+  size_t rot_offset = (has_translations ? N : 0);
+  auto local_pose = [&](size_t s) {
+    Matrix x(d_, d_ + 1);
+    x.col(0) = (has_translations ? Vector(xhat.col(s)) : Vector::Zero(d_));
+    x.rightCols(d_) = xhat.middleCols(rot_offset + d_ * s, d_);
+    return x;
+  };
+
+  // The estimates are expressed in the world frame by the rigid transformation
+  // x -> (G * t + c, G * R) of the local solution
+  Matrix G(d_, d_);
+  Vector c(d_);
+  if (offset > 0 || window_start_ == 0) {
+    // The state in slot 0 (the anchor, or the first state if the window has
+    // not yet advanced) defines the world frame
+    Matrix x_ref = local_pose(0);
+    G = x_ref.rightCols(d_).transpose();
+    c = -G * x_ref.col(0);
+  } else {
+    // No measurement ties the window to a fixed state, so the window's pose
+    // in the world frame is unobservable; preserve the gauge by aligning the
+    // solution (in the least-squares sense) with the current estimates of the
+    // window's states
+    Matrix M = Matrix::Zero(d_, d_);
+    for (size_t g = window_start_; g < n_new; ++g)
+      M += poses_[g].rightCols(d_) *
+           local_pose(slot(g)).rightCols(d_).transpose();
+    G = project_to_SOd(M);
+
+    c.setZero();
+    for (size_t g = window_start_; g < n_new; ++g)
+      c += poses_[g].col(0) - G * local_pose(slot(g)).col(0);
+    c /= static_cast<Scalar>(n_new - window_start_);
+  }
+
+  for (size_t g = window_start_; g < n_new; ++g) {
+    Matrix x = local_pose(slot(g));
+    poses_[g].col(0) = G * x.col(0) + c;
+    poses_[g].rightCols(d_) = G * x.rightCols(d_);
+  }
+
+  return result_;
+}
+
+} // namespace SESync
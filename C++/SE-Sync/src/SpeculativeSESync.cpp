@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "Optimization/Util/Stopwatch.h"
+
+#include "SESync/SESyncProblem.h"
+#include "SESync/SpeculativeSESync.h"
+
+namespace SESync {
+
+namespace {
+
+/** Returns the median of the given (nonempty) vector of ranks */
+size_t median_rank(std::vector<size_t> ranks) {
+  auto middle = ranks.begin() + ranks.size() / 2;
+  std::nth_element(ranks.begin(), middle, ranks.end());
+  return *middle;
+}
+
+/** Returns the lifted, perturbed initial iterate for the speculative path (cf.
+ * SpeculativeSESyncOpts::lifting_perturbation) */
+Matrix speculative_initialization(const SESyncProblem &problem,
+                                  const SESyncOpts &options,
+                                  Scalar perturbation) {
+  if (options.initialization == Initialization::Random)
+    return problem.random_sample();
+
+  Matrix Y = problem.chordal_initialization();
+
+  // Perturb Y along a random tangent direction supported on the rows that
+  // the lifting left at zero
+  size_t d = problem.dimension();
+  Matrix E = Matrix::Zero(Y.rows(), Y.cols());
+  E.bottomRows(Y.rows() - d).setRandom();
+  Matrix Ydot = problem.tangent_space_projection(Y, E);
+  Scalar Ydot_norm = Ydot.norm();
+  if (Ydot_norm == 0)
+    return Y;
+
+  return problem.retract(Y, perturbation * Y.norm() / Ydot_norm * Ydot);
+}
+
+} // namespace
+
+SpeculativeSESyncResult
+SpeculativeSESync(const measurements_t &measurements, const SESyncOpts &options,
+                  const SpeculativeSESyncOpts &speculative_options) {
+  if (measurements.empty())
+    throw std::invalid_argument("A problem must contain measurements");
+
+  if (speculative_options.min_threads_per_path < 1)
+    throw std::invalid_argument(
+        "Minimum number of threads per path must be a positive integer");
+
+  if (speculative_options.lifting_perturbation <= 0)
+    throw std::invalid_argument(
+        "Lifting perturbation must be a positive value");
+
+  auto start_time = Stopwatch::tick();
+
+  SpeculativeSESyncResult speculative_result;
+  if (!speculative_options.history_file.empty())
+    speculative_result.historical_ranks =
+        read_speculation_history(speculative_options.history_file,
+                                 speculative_options.dataset_name);
+  const std::vector<size_t> &history = speculative_result.historical_ranks;
+
+  size_t num_threads = speculative_options.num_threads;
+  if (num_threads == 0)
+    num_threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+
+  /// DECIDE WHETHER TO SPECULATE
+
+  // The speculative path can only start above the initial level
+  bool speculate = (options.rmax > options.r0);
+  if (speculative_options.mode == SpeculationMode::Never)
+    speculate = false;
+  else if (speculative_options.mode == SpeculationMode::Auto)
+    speculate =
+        speculate &&
+        num_threads >= 2 * speculative_options.min_threads_per_path &&
+        !history.empty() &&
+        median_rank(history) + 1 >=
+            options.r0 + speculative_options.min_historical_levels;
+
+  if (speculate) {
+    size_t r = speculative_options.speculative_rank;
+    if (r == 0)
+      r = (history.empty() ? options.r0 + 1 : median_rank(history));
+    speculative_result.speculative_rank =
+        std::min(std::max(r, options.r0 + 1), options.rmax);
+  }
+
+  if (!speculate) {
+    // Solve sequentially
+    speculative_result.result = SESync(measurements, options);
+    speculative_result.base_result = speculative_result.result;
+    speculative_result.total_time = speculative_result.base_time =
+        Stopwatch::tock(start_time);
+
+    if (speculative_options.verbose)
+      std::cout << "Solved without speculation after "
+                << speculative_result.total_time << " seconds" << std::endl;
+
+    if (!speculative_options.history_file.empty())
+      write_speculation_history(speculative_options.history_file,
+                                speculative_options.dataset_name,
+                                speculative_result);
+    return speculative_result;
+  }
+
+  /// RACE THE TWO PATHS
+
+  speculative_result.speculated = true;
+
+  // Divide the threads between the two paths, and give each one its own
+  // monitor, so that it can be cancelled independently (while still honoring
+  // the cancellation of the caller's monitor, if any)
+  SESyncOpts base_opts = options;
+  base_opts.num_threads = std::max<size_t>((num_threads + 1) / 2, 1);
+  base_opts.monitor = SESyncMonitor::child(options.monitor);
+
+  SESyncOpts speculative_opts = options;
+  speculative_opts.num_threads = std::max<size_t>(num_threads / 2, 1);
+  speculative_opts.monitor = SESyncMonitor::child(options.monitor);
+  speculative_opts.r0 = speculative_result.speculative_rank;
+  speculative_opts.iterate_log_file.clear();
+
+  std::mutex mutex;
+  bool have_winner = false;
+  std::exception_ptr base_exception, speculative_exception;
+
+  // Records the outcome of a path, cancelling the other one if it is the first
+  // to reach a certified global optimum
+  auto finish = [&](bool speculative, SESyncResult &&result,
+                    const std::exception_ptr &exception) {
+    std::lock_guard<std::mutex> lock(mutex);
+    double elapsed_time = Stopwatch::tock(start_time);
+    if (speculative) {
+      speculative_result.speculative_result = std::move(result);
+      speculative_result.speculative_time = elapsed_time;
+    } else {
+      speculative_result.base_result = std::move(result);
+      speculative_result.base_time = elapsed_time;
+    }
+
+    const SESyncResult &path_result =
+        (speculative ? speculative_result.speculative_result
+                     : speculative_result.base_result);
+    if (!exception && path_result.status == GlobalOpt && !have_winner) {
+      have_winner = true;
+      speculative_result.speculative_won = speculative;
+      (speculative ? base_opts : speculative_opts)
+          .monitor->request_cancellation();
+    }
+  };
+
+  std::thread base_thread([&]() {
+    SESyncResult result;
+    try {
+      result = SESync(measurements, base_opts);
+    } catch (...) {
+      base_exception = std::current_exception();
+    }
+    finish(false, std::move(result), base_exception);
+  });
+
+  std::thread speculative_thread([&]() {
+    SESyncResult result;
+    try {
+      SESyncProblem problem(
+          measurements, speculative_opts.formulation,
+          speculative_opts.projection_factorization,
+          speculative_opts.preconditioner,
+          speculative_opts.reg_Cholesky_precon_max_condition_number);
+      problem.set_relaxation_rank(speculative_opts.r0);
+      Matrix Y0 = speculative_initialization(
+          problem, speculative_opts, speculative_options.lifting_perturbation);
+      result = SESync(problem, speculative_opts, Y0);
+    } catch (...) {
+      speculative_exception = std::current_exception();
+    }
+    finish(true, std::move(result), speculative_exception);
+  });
+
+  base_thread.join();
+  speculative_thread.join();
+
+  speculative_result.total_time = Stopwatch::tock(start_time);
+
+  if (!have_winner) {
+    // Neither path reached a certified global optimum, so select the one whose
+    // rounded solution attained the lower objective value
+    if (base_exception && speculative_exception)
+      std::rethrow_exception(base_exception);
+    speculative_result.speculative_won =
+        !speculative_exception &&
+        (base_exception || speculative_result.speculative_result.Fxhat <
+                               speculative_result.base_result.Fxhat);
+  }
+  speculative_result.result = (speculative_result.speculative_won
+                                   ? speculative_result.speculative_result
+                                   : speculative_result.base_result);
+
+  if (speculative_options.verbose) {
+    std::cout << "Ordinary path (from rank " << options.r0 << ", "
+              << base_opts.num_threads << " threads): ";
+    if (base_exception)
+      std::cout << "failed";
+    else
+      std::cout << speculative_result.base_result.relaxation_ranks.size()
+                << " levels, F(x) = " << speculative_result.base_result.Fxhat
+                << " after " << speculative_result.base_time << " seconds";
+    std::cout << (speculative_result.speculative_won ? "" : " [winner]")
+              << std::endl;
+
+    std::cout << "Speculative path (from rank "
+              << speculative_result.speculative_rank << ", "
+              << speculative_opts.num_threads << " threads): ";
+    if (speculative_exception)
+      std::cout << "failed";
+    else
+      std::cout << speculative_result.speculative_result.relaxation_ranks.size()
+                << " levels, F(x) = "
+                << speculative_result.speculative_result.Fxhat << " after "
+                << speculative_result.speculative_time << " seconds";
+    std::cout << (speculative_result.speculative_won ? " [winner]" : "")
+              << std::endl;
+  }
+
+  if (!speculative_options.history_file.empty())
+    write_speculation_history(speculative_options.history_file,
+                              speculative_options.dataset_name,
+                              speculative_result);
+
+  return speculative_result;
+}
+
+std::vector<size_t> read_speculation_history(const std::string &filename,
+                                             const std::string &dataset_name) {
+  std::vector<size_t> ranks;
+  std::ifstream history(filename);
+
+  std::string line;
+  while (std::getline(history, line)) {
+    // Each line has the form dataset,certified_rank,num_levels,speculative_won
+    // (the header line fails to parse, and is therefore skipped)
+    std::stringstream fields(line);
+    std::string dataset, rank;
+    if (!std::getline(fields, dataset, ',') || dataset != dataset_name ||
+        !std::getline(fields, rank, ','))
+      continue;
+    try {
+      ranks.push_back(std::stoul(rank));
+    } catch (const std::exception &) {
+    }
+  }
+
+  return ranks;
+}
+
+void write_speculation_history(const std::string &filename,
+                               const std::string &dataset_name,
+                               const SpeculativeSESyncResult &result) {
+  // Only certified solutions indicate how many levels a dataset needs
+  if (result.result.status != GlobalOpt)
+    return;
+
+  bool empty;
+  {
+    std::ifstream existing(filename, std::ios::ate);
+    empty = !existing || existing.tellg() <= 0;
+  }
+
+  std::ofstream history(filename, std::ios::app);
+  if (!history)
+    throw std::invalid_argument("Unable to open speculation history file " +
+                                filename);
+
+  if (empty)
+    history << "dataset,certified_rank,num_levels,speculative_won" << std::endl;
+
+  // Record the (real) rank of the certified solution, which is independent of
+  // the formulation and of the path that found it
+  history << dataset_name << "," << result.result.Yopt.rows() << ","
+          << result.result.relaxation_ranks.size() << ","
+          << (result.speculative_won ? 1 : 0) << std::endl;
+}
+
+} // namespace SESync
@@ -2,6 +2,7 @@
 #include <Eigen/QR>
 #include <Eigen/SVD>
 
+#include "SESync/KernelCounters.h"
 #include "SESync/StiefelProduct.h"
 namespace SESync {
 
@@ -12,6 +13,11 @@ Matrix StiefelProduct::project(const Matrix &A) const {
   // in the paper "Projection-Like Retractions on Matrix Manifolds" by Absil
   // and Malick.
 
+  // (The flop count is a rough estimate for the Jacobi SVD of a p x k block)
+  SESYNC_KERNEL_SCOPE(Kernel::Project,
+                      n_ * (6.0 * p_ * k_ * k_ + 20.0 * k_ * k_ * k_),
+                      16.0 * p_ * k_ * n_);
+
   Matrix P(p_, k_ * n_);
 
 #pragma omp parallel for
@@ -28,6 +34,9 @@ Matrix StiefelProduct::project(const Matrix &A) const {
 
 Matrix StiefelProduct::SymBlockDiagProduct(const Matrix &A, const Matrix &B,
                                            const Matrix &C) const {
+  SESYNC_KERNEL_SCOPE(Kernel::SymBlockDiagProduct, 4.0 * n_ * p_ * k_ * k_,
+                      32.0 * p_ * k_ * n_);
+
   // Preallocate result matrix
   Matrix R(p_, k_ * n_);
 
@@ -0,0 +1,49 @@
+#include "SESync/SESyncBatch.h"
+#include "SESync/SESync_utils.h"
+
+#include <cstdlib>
+
+using namespace std;
+using namespace SESync;
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    cout << "Usage: " << argv[0]
+         << " [copies per file] [input .g2o file] [input .g2o file] ..."
+         << endl;
+    exit(1);
+  }
+
+  size_t copies = atoi(argv[1]);
+
+  // Build a mixed workload by replicating each input problem
+  vector<measurements_t> problems;
+  for (int k = 2; k < argc; ++k) {
+    size_t num_poses;
+    measurements_t measurements = read_g2o_file(argv[k], num_poses);
+    if (measurements.size() == 0) {
+      cout << "Error: No measurements were read from file " << argv[k] << "!"
+           << endl;
+      exit(1);
+    }
+    cout << "Loaded " << measurements.size() << " measurements between "
+         << num_poses << " poses from file " << argv[k] << endl;
+
+    for (size_t c = 0; c < copies; ++c)
+      problems.push_back(measurements);
+  }
+  cout << endl;
+
+  SESyncOpts opts;
+  opts.verbose = false;
+
+  SESyncBatchOpts batch_opts;
+  batch_opts.verbose = true;
+
+  /// RUN SE-SYNC ON THE ENTIRE BATCH
+  SESyncBatchResult batch_result = SESyncBatch(problems, opts, batch_opts);
+
+  cout << endl
+       << "Throughput: " << batch_result.throughput << " problems/second"
+       << endl;
+}
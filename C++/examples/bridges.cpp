@@ -0,0 +1,65 @@
+#include "SESync/SESync.h"
+#include "SESync/SESync_utils.h"
+
+using namespace std;
+using namespace SESync;
+
+/** Solves the problem in the given .g2o file twice, first as a whole and then
+ * split at its bridges into 2-edge-connected components, and reports the
+ * speedup of the latter over the former */
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    cout << "Usage: " << argv[0] << " [input .g2o file]" << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  SESyncOpts opts;
+  opts.num_threads = 4;
+
+  /// WHOLE PROBLEM
+  opts.eliminate_bridges = false;
+  SESyncResult whole_result = SESync::SESync(measurements, opts);
+
+  /// BRIDGE ELIMINATION
+  opts.eliminate_bridges = true;
+  SESyncResult split_result = SESync::SESync(measurements, opts);
+
+  // Count the states of the largest component that actually had to be solved
+  size_t largest = num_poses;
+  if (!split_result.component_states.empty()) {
+    largest = 0;
+    for (const vector<size_t> &states : split_result.component_states)
+      largest = max(largest, states.size());
+  }
+
+  cout << "Bridges: " << split_result.num_bridges << ", components: "
+       << max<size_t>(split_result.component_states.size(), 1)
+       << ", largest component: " << largest << " states" << endl
+       << endl;
+
+  cout << "Method          Total time [s]   F(xhat)   Suboptimality bound"
+       << endl;
+  cout << "Whole problem   " << whole_result.total_computation_time << "   "
+       << whole_result.Fxhat << "   " << whole_result.suboptimality_bound
+       << endl;
+  cout << "Split           " << split_result.total_computation_time << "   "
+       << split_result.Fxhat << "   " << split_result.suboptimality_bound
+       << endl
+       << endl;
+
+  cout << "Speedup (total computation time): "
+       << whole_result.total_computation_time /
+              split_result.total_computation_time
+       << "x" << endl;
+}
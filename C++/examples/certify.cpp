@@ -0,0 +1,67 @@
+#include "SESync/SESync.h"
+#include "SESync/SESync_utils.h"
+
+using namespace std;
+using namespace SESync;
+
+/** Solves the problem in the given .g2o file, and then certifies the returned
+ * estimate (as one would an estimate computed by an external local
+ * optimizer), both as given and after perturbing it slightly and polishing
+ * the perturbed estimate, and reports the cost of each certification relative
+ * to that of the full solve */
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [polishing iterations (optional)]" << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  size_t polish_iterations = (argc == 3 ? stoul(argv[2]) : 10);
+
+  SESyncOpts opts;
+  opts.num_threads = 4;
+
+  /// FULL SOLVE
+  SESyncProblem problem(measurements, opts.formulation,
+                        opts.projection_factorization, opts.preconditioner,
+                        opts.reg_Cholesky_precon_max_condition_number);
+  SESyncResult result = SESync::SESync(problem, opts);
+
+  /// CERTIFICATION OF THE RETURNED ESTIMATE
+  SESyncCertificate certificate = certify(problem, result.xhat, opts);
+
+  /// CERTIFICATION OF A PERTURBED ESTIMATE, AFTER POLISHING
+  size_t d = problem.dimension();
+  Matrix xhat = result.xhat;
+  for (size_t i = 0; i < num_poses; ++i) {
+    auto Ri = xhat.block(0, num_poses + d * i, d, d);
+    Ri = project_to_SOd(Ri + 1e-3 * Matrix::Random(d, d));
+  }
+  SESyncCertificate polished_certificate =
+      certify(problem, xhat, opts, polish_iterations);
+
+  cout << endl
+       << "Method                 Time [s]   Certified   Suboptimality bound"
+       << endl;
+  cout << "Full solve             " << result.total_computation_time << "   "
+       << (result.status == GlobalOpt ? "yes" : "no") << "   "
+       << result.suboptimality_bound << endl;
+  cout << "Certify               " << certificate.total_computation_time
+       << "   " << (certificate.status == GlobalOpt ? "yes" : "no") << "   "
+       << certificate.suboptimality_bound << endl;
+  cout << "Polish and certify     "
+       << polished_certificate.total_computation_time << "   "
+       << (polished_certificate.status == GlobalOpt ? "yes" : "no") << "   "
+       << polished_certificate.suboptimality_bound << endl;
+}
@@ -0,0 +1,92 @@
+#include "SESync/IncrementalSESync.h"
+#include "SESync/SESync_utils.h"
+#include "SESync/SlidingWindowSESync.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+using namespace SESync;
+
+/** Replays the given measurements in order, batch_size at a time, using the
+ * given (incremental or sliding-window) solver, and returns the latency of
+ * each update */
+template <typename Solver>
+vector<double> replay(Solver &solver, const measurements_t &measurements,
+                      size_t batch_size, size_t &num_in_place_updates) {
+  vector<double> latencies;
+  num_in_place_updates = 0;
+  for (size_t k = 0; k < measurements.size(); k += batch_size) {
+    measurements_t update(
+        measurements.begin() + k,
+        measurements.begin() + min(k + batch_size, measurements.size()));
+    solver.update(update);
+
+    latencies.push_back(solver.update_time());
+    if (solver.factorizations_updated())
+      num_in_place_updates++;
+  }
+  return latencies;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 4) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [measurements per update (default 1)] [window "
+            "size (default: unbounded)]"
+         << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  size_t batch_size = (argc >= 3 ? max(atoi(argv[2]), 1) : 1);
+  size_t window_size = (argc == 4 ? max(atoi(argv[3]), 2) : 0);
+
+  SESyncOpts opts;
+  opts.verbose = false;
+  opts.num_threads = 4;
+
+  /// REPLAY THE MEASUREMENTS IN ORDER
+  vector<double> latencies;
+  size_t num_in_place_updates;
+  SESyncResult result;
+  if (window_size == 0) {
+    IncrementalSESync solver(opts);
+    latencies = replay(solver, measurements, batch_size, num_in_place_updates);
+    result = solver.result();
+  } else {
+    cout << "Using a sliding window of " << window_size << " poses" << endl;
+    SlidingWindowSESync solver(window_size, opts);
+    latencies = replay(solver, measurements, batch_size, num_in_place_updates);
+    result = solver.result();
+  }
+
+  /// REPORT PER-UPDATE LATENCY
+  double total = 0;
+  for (double t : latencies)
+    total += t;
+  vector<double> sorted_latencies = latencies;
+  sort(sorted_latencies.begin(), sorted_latencies.end());
+
+  cout << "Performed " << latencies.size() << " updates ("
+       << num_in_place_updates
+       << " with in-place factorization updates) in " << total << " seconds"
+       << endl;
+  cout << "Per-update latency: mean " << total / latencies.size()
+       << " s, median " << sorted_latencies[sorted_latencies.size() / 2]
+       << " s, 95th percentile "
+       << sorted_latencies[(95 * (sorted_latencies.size() - 1)) / 100]
+       << " s, max " << sorted_latencies.back() << " s" << endl;
+  cout << "Final objective value F(x): " << result.Fxhat
+       << ", suboptimality bound: " << result.suboptimality_bound << endl;
+}
@@ -0,0 +1,59 @@
+#include "SESync/SESync.h"
+#include "SESync/SESync_utils.h"
+
+using namespace std;
+using namespace SESync;
+
+/** Solves the problem in the given .g2o file twice, using first the chordal
+ * and then the multilevel initialization, and reports the speedup of the
+ * latter over the former */
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [coarsest level size (optional)]" << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  SESyncOpts opts;
+  opts.num_threads = 4;
+  if (argc == 3)
+    opts.multilevel_coarsest_size = stoul(argv[2]);
+
+  /// CHORDAL INITIALIZATION
+  opts.initialization = Initialization::Chordal;
+  SESyncResult chordal_result = SESync::SESync(measurements, opts);
+
+  /// MULTILEVEL INITIALIZATION
+  opts.initialization = Initialization::Multilevel;
+  SESyncResult multilevel_result = SESync::SESync(measurements, opts);
+
+  cout << "Multilevel hierarchy: ";
+  for (size_t l = 0; l < multilevel_result.multilevel_num_states.size(); ++l)
+    cout << (l > 0 ? " -> " : "") << multilevel_result.multilevel_num_states[l];
+  cout << " states" << endl << endl;
+
+  cout << "Initialization   Init. time [s]   Total time [s]   F(xhat)" << endl;
+  cout << "Chordal          " << chordal_result.initialization_time << "   "
+       << chordal_result.total_computation_time << "   "
+       << chordal_result.Fxhat << endl;
+  cout << "Multilevel       " << multilevel_result.initialization_time << "   "
+       << multilevel_result.total_computation_time << "   "
+       << multilevel_result.Fxhat << endl
+       << endl;
+
+  cout << "Speedup (total computation time): "
+       << chordal_result.total_computation_time /
+              multilevel_result.total_computation_time
+       << "x" << endl;
+}
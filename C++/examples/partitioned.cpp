@@ -0,0 +1,57 @@
+#include "SESync/PartitionedSESync.h"
+#include "SESync/SESync_utils.h"
+
+using namespace std;
+using namespace SESync;
+
+/** Solves the problem in the given .g2o file (using the Explicit formulation)
+ * with a pool of locally launched worker processes, each of which owns a
+ * contiguous range of the poses */
+int main(int argc, char **argv) {
+  // This program also serves as the workers' executable
+  if (run_partitioned_worker(argc, argv))
+    return 0;
+
+  if (argc < 2 || argc > 3) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [number of workers (optional, default 4)]"
+         << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  SESyncOpts opts;
+  opts.formulation = Formulation::Explicit;
+  opts.verbose = true;
+
+  PartitionedSESyncOpts partition_opts;
+  partition_opts.worker_executable = "/proc/self/exe";
+  if (argc == 3)
+    partition_opts.num_workers = stoul(argv[2]);
+
+  PartitionedSESyncResult partitioned_result =
+      PartitionedSESync(measurements, opts, partition_opts);
+  const SESyncResult &result = partitioned_result.result;
+
+  cout << endl
+       << "Status: "
+       << (result.status == GlobalOpt ? "certified" : "uncertified") << endl
+       << "F(xhat) = " << result.Fxhat
+       << ", suboptimality bound: " << result.suboptimality_bound << endl
+       << partitioned_result.num_sweeps << " sweeps over "
+       << partitioned_result.num_colors << " colors; "
+       << partitioned_result.bytes_sent << " bytes sent, "
+       << partitioned_result.bytes_received << " bytes received" << endl
+       << "Total computation time: " << result.total_computation_time
+       << " seconds" << endl;
+}
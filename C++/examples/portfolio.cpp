@@ -0,0 +1,39 @@
+#include "SESync/SESyncPortfolio.h"
+#include "SESync/SESync_utils.h"
+
+using namespace std;
+using namespace SESync;
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [output .csv record file (optional)]" << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  SESyncPortfolioOpts portfolio_opts;
+  portfolio_opts.variants = default_portfolio();
+  portfolio_opts.verbose = true;
+  portfolio_opts.dataset_name = argv[1];
+  if (argc == 3)
+    portfolio_opts.record_file = argv[2];
+
+  /// RACE THE PORTFOLIO
+  SESyncPortfolioResult portfolio_result =
+      SESyncPortfolio(measurements, portfolio_opts);
+
+  cout << endl
+       << "Winning configuration: " << portfolio_result.winner << " ("
+       << portfolio_result.total_time << " seconds)" << endl;
+}
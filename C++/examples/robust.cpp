@@ -0,0 +1,100 @@
+#include "SESync/RobustSESync.h"
+#include "SESync/SESync_utils.h"
+
+#include <random>
+
+using namespace std;
+using namespace SESync;
+
+/** Robustly solves the problem in the given .g2o file (optionally corrupted by
+ * a number of randomly-generated outlier loop closures) twice, first using a
+ * naive outer loop that solves a new problem from scratch in each round of
+ * GNC, and then reweighting a single problem in place, and reports the speedup
+ * of the latter over the former */
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [number of outliers to add (optional)]"
+         << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  // Add outlier loop closures with uniformly random endpoints, rotations and
+  // translations (scaled to the size of the trajectory)
+  size_t num_outliers = (argc == 3 ? stoul(argv[2]) : 0);
+  if (num_outliers > 0) {
+    size_t d = measurements[0].R.rows();
+    Scalar scale = 0;
+    for (const RelativePoseMeasurement &measurement : measurements)
+      scale = max(scale, measurement.t.norm());
+    scale *= sqrt(Scalar(num_poses));
+
+    default_random_engine generator(0);
+    uniform_int_distribution<size_t> state(0, num_poses - 1);
+    normal_distribution<Scalar> normal;
+    for (size_t k = 0; k < num_outliers; ++k) {
+      RelativePoseMeasurement outlier = measurements[0];
+      outlier.i = state(generator);
+      do
+        outlier.j = state(generator);
+      while (outlier.j == outlier.i);
+      outlier.R = project_to_SOd(
+          Matrix::NullaryExpr(d, d, [&]() { return normal(generator); }));
+      outlier.t = scale * Vector::NullaryExpr(d, [&]() {
+                    return normal(generator);
+                  }) / sqrt(Scalar(d));
+      measurements.push_back(outlier);
+    }
+    cout << "Added " << num_outliers << " outlier loop closures" << endl
+         << endl;
+  }
+
+  SESyncOpts opts;
+  opts.num_threads = 4;
+
+  RobustSESyncOpts robust_opts;
+  robust_opts.verbose = true;
+
+  /// NAIVE OUTER LOOP
+  cout << "Naive outer loop:" << endl;
+  robust_opts.reuse_problem = false;
+  RobustSESyncResult naive_result =
+      RobustSESync(measurements, opts, robust_opts);
+
+  /// IN-PLACE REWEIGHTING
+  cout << endl << "In-place reweighting:" << endl;
+  robust_opts.reuse_problem = true;
+  RobustSESyncResult reuse_result =
+      RobustSESync(measurements, opts, robust_opts);
+
+  cout << endl
+       << "Method          Rounds   Outliers   Reweighting [s]   Total [s]"
+       << endl;
+  cout << "Naive           " << naive_result.num_rounds << "   "
+       << naive_result.outliers.size() << "   "
+       << naive_result.reweighting_time << "   "
+       << naive_result.total_computation_time << endl;
+  cout << "In-place        " << reuse_result.num_rounds << "   "
+       << reuse_result.outliers.size() << "   "
+       << reuse_result.reweighting_time << "   "
+       << reuse_result.total_computation_time << endl
+       << endl;
+
+  cout << "Final round certified: "
+       << (reuse_result.result.status == GlobalOpt ? "yes" : "no") << endl;
+  cout << "Speedup (total computation time): "
+       << naive_result.total_computation_time /
+              reuse_result.total_computation_time
+       << "x" << endl;
+}
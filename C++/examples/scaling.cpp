@@ -0,0 +1,59 @@
+#include "SESync/SESync.h"
+#include "SESync/SESync_utils.h"
+
+#include <iomanip>
+
+using namespace std;
+using namespace SESync;
+
+/** Measures the strong scaling of SE-Sync with parallel block-coordinate
+ * descent: solves the problem in the given .g2o file (using the Explicit
+ * formulation) with 1, 2, 4, ... threads (up to the given maximum), and
+ * reports the elapsed time, speedup and parallel efficiency for each */
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 4) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [maximum number of threads (optional, "
+            "default 64)] [block size (optional)]"
+         << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  size_t max_threads = (argc >= 3 ? stoul(argv[2]) : 64);
+
+  SESyncOpts opts;
+  opts.formulation = Formulation::Explicit;
+  opts.local_optimizer = LocalOptimizer::BlockCoordinateDescent;
+  if (argc == 4)
+    opts.bcd_block_size = stoul(argv[3]);
+
+  cout << setw(8) << "Threads" << setw(16) << "Time [s]" << setw(16)
+       << "Staircase [s]" << setw(12) << "Speedup" << setw(12) << "Efficiency"
+       << setw(16) << "F(xhat)" << endl;
+
+  double serial_time = 0;
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    opts.num_threads = threads;
+    SESyncResult result = SESync::SESync(measurements, opts);
+
+    double time = result.total_computation_time;
+    if (threads == 1)
+      serial_time = time;
+
+    cout << setw(8) << threads << setw(16) << time << setw(16)
+         << result.telemetry.staircase_time << setw(12) << serial_time / time
+         << setw(12) << serial_time / (threads * time) << setw(16)
+         << result.Fxhat << endl;
+  }
+}
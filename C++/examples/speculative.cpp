@@ -0,0 +1,51 @@
+#include "SESync/SESync_utils.h"
+#include "SESync/SpeculativeSESync.h"
+
+using namespace std;
+using namespace SESync;
+
+/** Solves the problem in the given .g2o file several times, recording the
+ * certified relaxation rank of each solve in a history file, so that
+ * speculation (in Auto mode) is enabled for the later solves if the problem
+ * needs several levels of the Riemannian Staircase */
+int main(int argc, char **argv) {
+  if (argc < 3 || argc > 4) {
+    cout << "Usage: " << argv[0]
+         << " [input .g2o file] [.csv history file] [number of solves "
+            "(optional)]"
+         << endl;
+    exit(1);
+  }
+
+  size_t num_poses;
+  measurements_t measurements = read_g2o_file(argv[1], num_poses);
+  cout << "Loaded " << measurements.size() << " measurements between "
+       << num_poses << " poses from file " << argv[1] << endl
+       << endl;
+  if (measurements.size() == 0) {
+    cout << "Error: No measurements were read!"
+         << " Are you sure the file exists?" << endl;
+    exit(1);
+  }
+
+  size_t num_solves = (argc == 4 ? stoul(argv[3]) : 3);
+
+  SESyncOpts opts;
+  // Start from the lowest level, so that several levels are typically needed
+  opts.r0 = measurements[0].R.rows();
+
+  SpeculativeSESyncOpts speculative_opts;
+  speculative_opts.history_file = argv[2];
+  speculative_opts.dataset_name = argv[1];
+  speculative_opts.verbose = true;
+
+  for (size_t k = 0; k < num_solves; ++k) {
+    cout << "Solve " << k << ":" << endl;
+    SpeculativeSESyncResult result =
+        SpeculativeSESync(measurements, opts, speculative_opts);
+    cout << "Certified rank " << result.result.Yopt.rows() << ", "
+         << result.total_time << " seconds"
+         << (result.speculated ? " (speculative)" : "") << endl
+         << endl;
+  }
+}